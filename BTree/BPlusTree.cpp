@@ -0,0 +1,460 @@
+/*
+ * BPlusTree.cpp
+ *
+ * Description: B+ Tree data collection ADT class, with the interface of the
+ *              Binary Search Tree (insert / retrieve / traverseInOrder).
+ *              Duplicated elements are not allowed.
+ *
+ * Class invariant: All leaves are at the same depth, and the elements are in
+ *                  increasing order from the first leaf to the last.
+ *
+ * Author: Amanda Ngo
+ * Date of last modification: March 2022
+ *
+ */
+
+#include "BPlusTree.h"
+
+/* Constructors and destructor */
+
+	// Default constructor
+	template <class ElementType, unsigned int NodeBytes>
+	BPlusTree<ElementType, NodeBytes>::BPlusTree() {
+		root = NULL;
+		firstLeaf = NULL;
+		height = 0;
+		elementCount = 0;
+	}
+
+	// Copy constructor
+	// Description: Copies aTree node for node, so no element is compared.
+	// Time efficiency: O(n)
+	template <class ElementType, unsigned int NodeBytes>
+	BPlusTree<ElementType, NodeBytes>::BPlusTree(const BPlusTree<ElementType, NodeBytes>& aTree) {
+		root = NULL;
+		firstLeaf = NULL;
+		height = aTree.height;
+		elementCount = 0;
+		if (aTree.root != NULL) {
+			Leaf* lastLeaf = NULL;
+			root = clone(aTree.root, height, lastLeaf);
+			Node* node = root;
+			for (unsigned int level = 0; level < height; level++)
+				node = static_cast<Inner*>(node)->children[0];
+			firstLeaf = static_cast<Leaf*>(node);
+			elementCount = aTree.elementCount;
+		}
+	}
+
+	// Move constructor
+	// Description: Takes over the nodes of aTree, which is left empty.
+	template <class ElementType, unsigned int NodeBytes>
+	BPlusTree<ElementType, NodeBytes>::BPlusTree(BPlusTree<ElementType, NodeBytes>&& aTree) noexcept {
+		root = aTree.root;
+		firstLeaf = aTree.firstLeaf;
+		height = aTree.height;
+		elementCount = aTree.elementCount;
+		aTree.root = NULL;
+		aTree.firstLeaf = NULL;
+		aTree.height = 0;
+		aTree.elementCount = 0;
+	}
+
+	// Destructor
+	template <class ElementType, unsigned int NodeBytes>
+	BPlusTree<ElementType, NodeBytes>::~BPlusTree() {
+		if (root != NULL)
+			destroy(root, height);
+	}
+
+/* Assignment operators */
+
+	// Copy assignment operator
+	template <class ElementType, unsigned int NodeBytes>
+	BPlusTree<ElementType, NodeBytes>& BPlusTree<ElementType, NodeBytes>::operator=(const BPlusTree<ElementType, NodeBytes>& rhs) {
+		if (this != &rhs) {
+			BPlusTree<ElementType, NodeBytes> copy(rhs);
+			*this = move(copy);
+		}
+		return *this;
+	}
+
+	// Move assignment operator
+	template <class ElementType, unsigned int NodeBytes>
+	BPlusTree<ElementType, NodeBytes>& BPlusTree<ElementType, NodeBytes>::operator=(BPlusTree<ElementType, NodeBytes>&& rhs) noexcept {
+		swap(root, rhs.root);
+		swap(firstLeaf, rhs.firstLeaf);
+		swap(height, rhs.height);
+		swap(elementCount, rhs.elementCount);
+		return *this;
+	}
+
+/* Getters */
+
+	// Description: Returns the number of elements currently stored in the B+ Tree.
+	// Time efficiency: O(1)
+	template <class ElementType, unsigned int NodeBytes>
+	unsigned int BPlusTree<ElementType, NodeBytes>::getElementCount() const {
+		return elementCount;
+	}
+
+/* B+ Tree Operations */
+
+	// Description: Inserts an element into the B+ Tree.
+	// Exception: Throws the exception "ElementAlreadyExistsException"
+	//            if "newElement" already exists in the B+ Tree.
+	// Time efficiency: O(log2 n)
+	template <class ElementType, unsigned int NodeBytes>
+	void BPlusTree<ElementType, NodeBytes>::insert(const ElementType& newElement) {
+		if (root == NULL) {
+			Leaf* leaf = new Leaf;
+			try {
+				leaf->elements[0] = newElement;
+			}
+			catch (...) {
+				delete leaf;
+				throw;
+			}
+			leaf->count = 1;
+			leaf->next = NULL;
+			root = leaf;
+			firstLeaf = leaf;
+			height = 0;
+			elementCount = 1;
+			return;
+		}
+
+		// Walk down to the leaf, remembering the way back up
+		Inner* path[MAX_HEIGHT];
+		unsigned int childIndices[MAX_HEIGHT];
+		Node* node = root;
+		for (unsigned int level = 0; level < height; level++) {
+			Inner* inner = static_cast<Inner*>(node);
+			path[level] = inner;
+			childIndices[level] = upperIndex(inner->keys, inner->count, newElement);
+			node = inner->children[childIndices[level]];
+		}
+		Leaf* leaf = static_cast<Leaf*>(node);
+		unsigned int position = lowerIndex(leaf->elements, leaf->count, newElement);
+		if (position < leaf->count && leaf->elements[position] == newElement)
+			throw ElementAlreadyExistsException("Element already exists in the data collection.\n");
+
+		// Copy newElement before any element is moved, so a throwing copy changes nothing
+		ElementType element = newElement;
+		if (leaf->count < LEAF_CAPACITY) {
+			for (unsigned int i = leaf->count; i > position; i--)
+				leaf->elements[i] = move(leaf->elements[i - 1]);
+			leaf->elements[position] = move(element);
+			leaf->count++;
+			elementCount++;
+			return;
+		}
+
+		// Split the full leaf: the upper half moves to a new leaf on its right,
+		// or nothing does when newElement goes after every element in the tree.
+		// The separator and every node the split needs, up to a new root, are
+		// made first: if one of them fails, the tree is left as it was.
+		bool appending = leaf->next == NULL && position == leaf->count;
+		unsigned int keep = appending ? LEAF_CAPACITY : (LEAF_CAPACITY + 1) / 2;
+		ElementType separator = appending ? element : leaf->elements[keep];
+		unsigned int splits = 0;
+		while (splits < height && path[height - 1 - splits]->count == INNER_CAPACITY)
+			splits++;
+		unsigned int spareCount = splits == height ? splits + 1 : splits;
+		Inner* spare[MAX_HEIGHT + 1];
+		unsigned int allocated = 0;
+		Leaf* right = new Leaf;
+		try {
+			for (; allocated < spareCount; allocated++)
+				spare[allocated] = new Inner;
+		}
+		catch (...) {
+			for (unsigned int i = 0; i < allocated; i++)
+				delete spare[i];
+			delete right;
+			throw;
+		}
+
+		for (unsigned int i = keep; i < LEAF_CAPACITY; i++)
+			right->elements[i - keep] = move(leaf->elements[i]);
+		right->count = LEAF_CAPACITY - keep;
+		leaf->count = keep;
+		right->next = leaf->next;
+		leaf->next = right;
+
+		Leaf* target = position > keep || appending ? right : leaf;
+		if (target == right)
+			position -= keep;
+		for (unsigned int i = target->count; i > position; i--)
+			target->elements[i] = move(target->elements[i - 1]);
+		target->elements[position] = move(element);
+		target->count++;
+		elementCount++;
+
+		insertInto(path, childIndices, height, separator, right, appending, spare);
+	}
+
+	// Description: Inserts "separator" and, right after it, the child "right" into the
+	//              inner node at "level" - 1 of path, splitting full nodes on the way
+	//              up. A full root gets a new root above it. The new nodes are taken
+	//              from "spare", lowest level first.
+	template <class ElementType, unsigned int NodeBytes>
+	void BPlusTree<ElementType, NodeBytes>::insertInto(Inner** path, unsigned int* childIndices, unsigned int level,
+	                                                   ElementType& separator, Node* right, bool appending, Inner** spare) {
+		ElementType& up = separator;
+		while (level > 0) {
+			level--;
+			Inner* inner = path[level];
+			unsigned int index = childIndices[level];    // up goes to keys[index], right to children[index + 1]
+			if (inner->count < INNER_CAPACITY) {
+				for (unsigned int i = inner->count; i > index; i--) {
+					inner->keys[i] = move(inner->keys[i - 1]);
+					inner->children[i + 1] = inner->children[i];
+				}
+				inner->keys[index] = move(up);
+				inner->children[index + 1] = right;
+				inner->count++;
+				return;
+			}
+
+			Inner* sibling = *spare++;
+			appending = appending && index == inner->count;
+			if (appending) {
+				// Keep the full node; the new one starts with right as its only child
+				sibling->count = 0;
+				sibling->children[0] = right;
+			}
+			else {
+				// Lay the INNER_CAPACITY + 1 keys out in order, then keep the lower
+				// half, send the middle one up and move the upper half over.
+				ElementType keys[INNER_CAPACITY + 1];
+				Node* children[INNER_CAPACITY + 2];
+				for (unsigned int i = 0, from = 0; i <= INNER_CAPACITY; i++)
+					keys[i] = i == index ? move(up) : move(inner->keys[from++]);
+				for (unsigned int i = 0, from = 0; i <= INNER_CAPACITY + 1; i++)
+					children[i] = i == index + 1 ? right : inner->children[from++];
+
+				unsigned int keep = (INNER_CAPACITY + 1) / 2;
+				for (unsigned int i = 0; i < keep; i++) {
+					inner->keys[i] = move(keys[i]);
+					inner->children[i] = children[i];
+				}
+				inner->children[keep] = children[keep];
+				inner->count = keep;
+				up = move(keys[keep]);
+				for (unsigned int i = keep + 1; i <= INNER_CAPACITY; i++) {
+					sibling->keys[i - keep - 1] = move(keys[i]);
+					sibling->children[i - keep - 1] = children[i];
+				}
+				sibling->children[INNER_CAPACITY - keep] = children[INNER_CAPACITY + 1];
+				sibling->count = INNER_CAPACITY - keep;
+			}
+			right = sibling;
+		}
+
+		Inner* newRoot = *spare;
+		newRoot->keys[0] = move(up);
+		newRoot->children[0] = root;
+		newRoot->children[1] = right;
+		newRoot->count = 1;
+		root = newRoot;
+		height++;
+	}
+
+	// Description: Retrieves "targetElement" from the B+ Tree.
+	// Exception: Throws the exception "EmptyDataCollectionException"
+	//            if the B+ Tree is empty.
+	// Exception: Throws the exception "ElementDoesNotExistException"
+	//            if "targetElement" is not in the B+ Tree.
+	// Time efficiency: O(log2 n)
+	template <class ElementType, unsigned int NodeBytes>
+	ElementType& BPlusTree<ElementType, NodeBytes>::retrieve(const ElementType& targetElement) const {
+		if (elementCount == 0)
+			throw EmptyDataCollectionException("B+ tree is empty.\n");
+		Leaf* leaf = findLeaf(targetElement);
+		unsigned int position = lowerIndex(leaf->elements, leaf->count, targetElement);
+		if (position == leaf->count || !(leaf->elements[position] == targetElement))
+			throw ElementDoesNotExistException("Element was unable to be located");
+		return leaf->elements[position];
+	}
+
+	// Description: Traverses the B+ Tree in order, following the leaf links.
+	// Exception: Throws the exception "EmptyDataCollectionException"
+	//            if the B+ Tree is empty.
+	// Time efficiency: O(n)
+	template <class ElementType, unsigned int NodeBytes>
+	void BPlusTree<ElementType, NodeBytes>::traverseInOrder(void visit(const ElementType&)) const {
+		if (elementCount == 0)
+			throw EmptyDataCollectionException("B+ tree is empty.");
+		forEach(visit);
+	}
+
+	// Description: Calls visit(element) on every element, in order. If visit returns
+	//              a bool, returning false stops the traversal there.
+	//              Returns "false" if the traversal was stopped, otherwise "true".
+	// Time efficiency: O(n)
+	template <class ElementType, unsigned int NodeBytes>
+	template <class Function>
+	bool BPlusTree<ElementType, NodeBytes>::forEach(Function&& visit) const {
+		for (const Leaf* leaf = firstLeaf; leaf != NULL; leaf = leaf->next) {
+			for (unsigned int i = 0; i < leaf->count; i++) {
+				if (!visitElement(visit, leaf->elements[i], typename is_void<decltype(visit(leaf->elements[i]))>::type()))
+					return false;
+			}
+		}
+		return true;
+	}
+
+/* Checks */
+
+	// Description: Returns "true" if the B+ Tree keeps its class invariant, its leaf
+	//              chain and its element count, otherwise "false".
+	// Time efficiency: O(n)
+	template <class ElementType, unsigned int NodeBytes>
+	bool BPlusTree<ElementType, NodeBytes>::isValid() const {
+		if (root == NULL)
+			return firstLeaf == NULL && height == 0 && elementCount == 0;
+		const Leaf* nextLeaf = firstLeaf;
+		unsigned int count = 0;
+		return isValidSubtree(root, height, NULL, NULL, nextLeaf, count) && nextLeaf == NULL && count == elementCount;
+	}
+
+/* Utility methods */
+
+	// Description: Returns the number of the "count" elements starting at "elements"
+	//              that are smaller than "element". Each step halves the range with
+	//              a conditional move rather than a branch.
+	template <class ElementType, unsigned int NodeBytes>
+	unsigned int BPlusTree<ElementType, NodeBytes>::lowerIndex(const ElementType* elements, unsigned int count, const ElementType& element) {
+		if (count == 0)
+			return 0;
+		const ElementType* base = elements;
+		while (count > 1) {
+			unsigned int half = count / 2;
+			base = element > base[half] ? base + half : base;
+			count -= half;
+		}
+		return (base - elements) + (element > *base ? 1 : 0);
+	}
+
+	// Description: Returns the number of the "count" elements starting at "elements"
+	//              that are not larger than "element".
+	template <class ElementType, unsigned int NodeBytes>
+	unsigned int BPlusTree<ElementType, NodeBytes>::upperIndex(const ElementType* elements, unsigned int count, const ElementType& element) {
+		if (count == 0)
+			return 0;
+		const ElementType* base = elements;
+		while (count > 1) {
+			unsigned int half = count / 2;
+			base = base[half] > element ? base : base + half;
+			count -= half;
+		}
+		return (base - elements) + (*base > element ? 0 : 1);
+	}
+
+	// Description: Returns the leaf where "element" is, or would be.
+	// Precondition: The B+ Tree is not empty.
+	template <class ElementType, unsigned int NodeBytes>
+	typename BPlusTree<ElementType, NodeBytes>::Leaf* BPlusTree<ElementType, NodeBytes>::findLeaf(const ElementType& element) const {
+		Node* node = root;
+		for (unsigned int level = 0; level < height; level++) {
+			Inner* inner = static_cast<Inner*>(node);
+			node = inner->children[upperIndex(inner->keys, inner->count, element)];
+		}
+		return static_cast<Leaf*>(node);
+	}
+
+	// Description: Deletes the subtree rooted at "node", "levels" levels of inner
+	//              nodes above its leaves. Recurses only as deep as the tree is tall.
+	template <class ElementType, unsigned int NodeBytes>
+	void BPlusTree<ElementType, NodeBytes>::destroy(Node* node, unsigned int levels) {
+		if (levels == 0) {
+			delete static_cast<Leaf*>(node);
+			return;
+		}
+		Inner* inner = static_cast<Inner*>(node);
+		for (unsigned int i = 0; i <= inner->count; i++)
+			destroy(inner->children[i], levels - 1);
+		delete inner;
+	}
+
+	// Description: Returns "true" if the subtree rooted at "node" keeps the class
+	//              invariant within the bounds *lower (included) and *upper, and its
+	//              leaves are the next ones of the leaf chain. Recurses only as deep
+	//              as the tree is tall.
+	template <class ElementType, unsigned int NodeBytes>
+	bool BPlusTree<ElementType, NodeBytes>::isValidSubtree(const Node* node, unsigned int levels, const ElementType* lower,
+	                                                      const ElementType* upper, const Leaf*& nextLeaf, unsigned int& count) {
+		if (levels == 0) {
+			const Leaf* leaf = static_cast<const Leaf*>(node);
+			if (leaf != nextLeaf || leaf->count == 0 || leaf->count > LEAF_CAPACITY)
+				return false;
+			for (unsigned int i = 0; i < leaf->count; i++) {
+				const ElementType& element = leaf->elements[i];
+				if ((i > 0 && !(element > leaf->elements[i - 1])) ||
+				    (lower != NULL && *lower > element) || (upper != NULL && !(*upper > element)))
+					return false;
+			}
+			nextLeaf = leaf->next;
+			count += leaf->count;
+			return true;
+		}
+
+		const Inner* inner = static_cast<const Inner*>(node);
+		if (inner->count > INNER_CAPACITY)
+			return false;
+		for (unsigned int i = 0; i <= inner->count; i++) {
+			const ElementType* below = i == 0 ? lower : &inner->keys[i - 1];
+			const ElementType* above = i == inner->count ? upper : &inner->keys[i];
+			if (i < inner->count && ((below != NULL && *below > *above) || (upper != NULL && !(*upper > *above))))
+				return false;
+			if (!isValidSubtree(inner->children[i], levels - 1, below, above, nextLeaf, count))
+				return false;
+		}
+		return true;
+	}
+
+	// Description: Returns a copy of the subtree rooted at "node", linking its leaves
+	//              after "lastLeaf" (updated to the copy's last leaf). If an element
+	//              cannot be copied, the nodes copied so far are deleted.
+	template <class ElementType, unsigned int NodeBytes>
+	typename BPlusTree<ElementType, NodeBytes>::Node* BPlusTree<ElementType, NodeBytes>::clone(const Node* node, unsigned int levels, Leaf*& lastLeaf) {
+		if (levels == 0) {
+			const Leaf* leaf = static_cast<const Leaf*>(node);
+			Leaf* copy = new Leaf;
+			try {
+				for (unsigned int i = 0; i < leaf->count; i++)
+					copy->elements[i] = leaf->elements[i];
+			}
+			catch (...) {
+				delete copy;
+				throw;
+			}
+			copy->count = leaf->count;
+			copy->next = NULL;
+			if (lastLeaf != NULL)
+				lastLeaf->next = copy;
+			lastLeaf = copy;
+			return copy;
+		}
+
+		const Inner* inner = static_cast<const Inner*>(node);
+		Inner* copy = new Inner;
+		unsigned int cloned = 0;
+		try {
+			for (unsigned int i = 0; i < inner->count; i++)
+				copy->keys[i] = inner->keys[i];
+			for (; cloned <= inner->count; cloned++)
+				copy->children[cloned] = clone(inner->children[cloned], levels - 1, lastLeaf);
+		}
+		catch (...) {
+			for (unsigned int i = 0; i < cloned; i++)
+				destroy(copy->children[i], levels - 1);
+			delete copy;
+			throw;
+		}
+		copy->count = inner->count;
+		return copy;
+	}
+
+//  End of implementation file.
\ No newline at end of file
@@ -0,0 +1,177 @@
+/*
+ * BPlusTree.h
+ *
+ * Description: B+ Tree data collection ADT class, with the interface of the
+ *              Binary Search Tree (insert / retrieve / traverseInOrder).
+ *              Duplicated elements are not allowed.
+ *              Every node is about NodeBytes bytes (256 by default, i.e. four
+ *              cache lines) and keeps its keys in one contiguous array, so a
+ *              lookup costs one or two cache misses per level instead of one
+ *              per comparison. The elements are all in the leaves, which are
+ *              linked left to right for in order scans; the inner nodes hold
+ *              copies of elements as separators.
+ *
+ * Class invariant: All leaves are at the same depth. The elements of every leaf
+ *                  are in increasing order, and every leaf's are smaller than
+ *                  the next leaf's. In an inner node, the elements below
+ *                  children[i] are smaller than keys[i], and those below
+ *                  children[i + 1] are not.
+ *
+ * Author: Amanda Ngo
+ * Date of last modification: March 2022
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include "ElementAlreadyExistsException.h"
+#include "ElementDoesNotExistException.h"
+#include "EmptyDataCollectionException.h"
+
+using namespace std;
+
+template <class ElementType, unsigned int NodeBytes = 256>
+class BPlusTree {
+
+private:
+	static const unsigned int LEAF_CAPACITY = NodeBytes / sizeof(ElementType) >= 4 ? NodeBytes / sizeof(ElementType) : 4;
+	static const unsigned int INNER_CAPACITY = NodeBytes / (sizeof(ElementType) + sizeof(void*)) >= 4 ?
+	                                           NodeBytes / (sizeof(ElementType) + sizeof(void*)) : 4;
+	static const unsigned int MAX_HEIGHT = 32;     // Far more than 2^32 elements need
+
+	struct Node {
+		unsigned int count;     // Elements in a leaf, keys in an inner node
+	};
+
+	struct Leaf : Node {
+		ElementType elements[LEAF_CAPACITY];
+		Leaf* next;             // Leaf to the right, NULL for the last one
+	};
+
+	struct Inner : Node {
+		ElementType keys[INNER_CAPACITY];
+		Node* children[INNER_CAPACITY + 1];
+	};
+
+	Node* root;                 // A Leaf if height is 0, otherwise an Inner; NULL when empty
+	Leaf* firstLeaf;
+	unsigned int height;        // Levels of inner nodes above the leaves
+	unsigned int elementCount;
+
+	/* Utility methods */
+
+	// Description: Returns the number of the "count" elements starting at "elements"
+	//              that are smaller than "element" (or, for upperIndex, not larger).
+	//              A binary search whose steps do not branch on the comparisons.
+	static unsigned int lowerIndex(const ElementType* elements, unsigned int count, const ElementType& element);
+	static unsigned int upperIndex(const ElementType* elements, unsigned int count, const ElementType& element);
+
+	// Description: Returns the leaf where "element" is, or would be.
+	// Precondition: The B+ Tree is not empty.
+	Leaf* findLeaf(const ElementType& element) const;
+
+	// Description: Inserts "separator" and, right after it, the child "right" into
+	//              the inner node at "level" of path (0 is the root). Splits it
+	//              when full, and then passes a separator up to the level above.
+	//              "appending" is set when the new child is the last of the tree.
+	//              Takes the new inner nodes from "spare", allocated beforehand, so
+	//              that nothing in it can fail. "separator" is moved from.
+	void insertInto(Inner** path, unsigned int* childIndices, unsigned int level,
+	                ElementType& separator, Node* right, bool appending, Inner** spare);
+
+	// Description: Deletes the subtree rooted at "node", "levels" levels of inner
+	//              nodes above its leaves.
+	static void destroy(Node* node, unsigned int levels);
+
+	// Description: Returns "true" if the subtree rooted at "node", "levels" levels of
+	//              inner nodes above its leaves, keeps the class invariant with its
+	//              elements not smaller than *lower and smaller than *upper (NULL for
+	//              no bound). Its leaves must come next in the leaf chain, from
+	//              "nextLeaf" on; nextLeaf and "count" are moved past them.
+	static bool isValidSubtree(const Node* node, unsigned int levels, const ElementType* lower,
+	                           const ElementType* upper, const Leaf*& nextLeaf, unsigned int& count);
+
+	// Description: Returns a copy of the subtree rooted at "node", linking its leaves
+	//              after "lastLeaf" (updated to the copy's last leaf).
+	static Node* clone(const Node* node, unsigned int levels, Leaf*& lastLeaf);
+
+	// Description: Calls visit(element). Returns what visit returned, or "true"
+	//              when visit returns nothing, so that forEach knows whether to go on.
+	template <class Function>
+	static bool visitElement(Function& visit, const ElementType& element, true_type) { visit(element); return true; }
+	template <class Function>
+	static bool visitElement(Function& visit, const ElementType& element, false_type) { return static_cast<bool>(visit(element)); }
+
+public:
+
+	/* Constructors and destructor */
+	BPlusTree();                                                     // Default constructor
+	BPlusTree(const BPlusTree<ElementType, NodeBytes>& aTree);       // Copy constructor
+	BPlusTree(BPlusTree<ElementType, NodeBytes>&& aTree) noexcept;   // Move constructor
+	~BPlusTree();                                                    // Destructor
+
+	/* Assignment operators */
+	BPlusTree<ElementType, NodeBytes>& operator=(const BPlusTree<ElementType, NodeBytes>& rhs);
+	BPlusTree<ElementType, NodeBytes>& operator=(BPlusTree<ElementType, NodeBytes>&& rhs) noexcept;
+
+	/* Getters */
+
+	// Description: Returns the number of elements currently stored in the B+ Tree.
+	// Time efficiency: O(1)
+	unsigned int getElementCount() const;
+
+	/* B+ Tree Operations */
+
+	// Description: Inserts an element into the B+ Tree. A full node is split in two
+	//              and a separator goes up to its parent; a full root makes the tree
+	//              one level taller. When the element goes after every other one, the
+	//              full node is kept as is and the new one starts empty, so that
+	//              sorted input fills the nodes.
+	// Precondition: "newElement" does not already exist in the B+ Tree.
+	// Exception: Throws the exception "ElementAlreadyExistsException"
+	//            if "newElement" already exists in the B+ Tree.
+	// Time efficiency: O(log2 n)
+	void insert(const ElementType& newElement);
+
+	// Description: Retrieves "targetElement" from the B+ Tree.
+	// Precondition: B+ Tree is not empty.
+	// Exception: Throws the exception "EmptyDataCollectionException"
+	//            if the B+ Tree is empty.
+	// Exception: Throws the exception "ElementDoesNotExistException"
+	//            if "targetElement" is not in the B+ Tree.
+	// Time efficiency: O(log2 n), with O(logB n) nodes visited for B elements per node
+	ElementType& retrieve(const ElementType& targetElement) const;
+
+	// Description: Traverses the B+ Tree in order, following the leaf links.
+	//              The action to be done on each element during the traverse is the function "visit".
+	// Precondition: B+ Tree is not empty.
+	// Exception: Throws the exception "EmptyDataCollectionException"
+	//            if the B+ Tree is empty.
+	// Time efficiency: O(n)
+	void traverseInOrder(void visit(const ElementType&)) const;
+
+	// Description: Calls visit(element) on every element, in order. "visit" may be
+	//              any callable, e.g. a lambda. If it returns a bool, returning
+	//              false stops the traversal there.
+	//              Returns "false" if the traversal was stopped, otherwise "true".
+	// Postcondition: The B+ Tree is unchanged by this operation.
+	// Time efficiency: O(n)
+	template <class Function>
+	bool forEach(Function&& visit) const;
+
+	/* Checks */
+
+	// Description: Returns "true" if every leaf is at the same depth, no node holds
+	//              more than it can, every separator bounds the elements below it,
+	//              the leaf chain links the leaves in order and the element count
+	//              agrees with them, otherwise "false". Meant for tests.
+	// Postcondition: The B+ Tree is unchanged by this operation.
+	// Time efficiency: O(n)
+	bool isValid() const;
+
+}; // end BPlusTree
+
+#include "BPlusTree.cpp"
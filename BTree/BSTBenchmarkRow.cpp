@@ -0,0 +1,19 @@
+/*
+ * BSTBenchmarkRow.cpp
+ *
+ * Description: The BST row of the B+ Tree benchmark: AVL balanced, with the
+ *              pooled node allocator, its fastest configuration. Kept apart
+ *              from BTreeBenchmark.cpp (see BenchmarkRow.h).
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#include "../BinarySearchTree/BST.h"
+#include "BenchmarkRow.h"
+
+void benchBSTRow(const char* name, const vector<unsigned int>& keys, const vector<unsigned int>& lookups) {
+	benchTreeRow<BST<unsigned int, AVLBalance, PooledNodeAllocator> >(name, keys, lookups);
+}
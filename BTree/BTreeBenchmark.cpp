@@ -0,0 +1,105 @@
+/*
+ * BTreeBenchmark.cpp
+ *
+ * Description: Benchmark driver for the B+ Tree, against the Binary Search Tree.
+ *              Usage: ./btreebench [section] [n]
+ *              section is one of the names below, or "all" (the default);
+ *              n is the number of elements (1000000 by default).
+ *              "make bench" builds it with optimizations and runs it at
+ *              1M, 10M and 50M elements.
+ *
+ *              compare   BST (AVL, pooled nodes) against BPlusTree<unsigned int>,
+ *                        in random and increasing order: n inserts, min(n, 5M)
+ *                        retrieves of present keys in random order (time per
+ *                        retrieve), a forEach scan, the destruction, and how
+ *                        much the resident set grew while the tree was built
+ *                        (from /proc/self/statm; 0 where there is none).
+ *              nodebytes The same for BPlusTree with NodeBytes 128, 256, 512
+ *                        and 1024, in random order.
+ *              Each row runs in a child process of its own.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "BPlusTree.h"
+#include "BenchmarkRow.h"
+
+using namespace std;
+
+static const unsigned int MAX_LOOKUPS = 5000000;
+
+// Utility function - Returns the n distinct keys 0, 2, 4, ... in random order.
+static vector<unsigned int> shuffledKeys(unsigned int n, unsigned int seed) {
+	vector<unsigned int> keys(n);
+	for (unsigned int i = 0; i < n; i++)
+		keys[i] = 2 * i;
+	shuffle(keys.begin(), keys.end(), mt19937(seed));
+	return keys;
+}
+
+// Utility function - Returns min(n, MAX_LOOKUPS) of "keys", in random order.
+static vector<unsigned int> lookupsOf(const vector<unsigned int>& keys) {
+	vector<unsigned int> lookups = keys;
+	shuffle(lookups.begin(), lookups.end(), mt19937(7));
+	if (lookups.size() > MAX_LOOKUPS)
+		lookups.resize(MAX_LOOKUPS);
+	return lookups;
+}
+
+static void printHeader(const char* section, const char* order, unsigned int n) {
+	printf("%s: n = %u, %s inserts\n  %-12s %13s %11s %13s %13s %12s\n", section, n, order,
+	       "tree", "insert", "retrieve", "scan", "destroy", "RSS growth");
+}
+
+static void benchCompare(unsigned int n) {
+	vector<unsigned int> keys = shuffledKeys(n, 1);
+	vector<unsigned int> lookups = lookupsOf(keys);
+	printHeader("compare", "random", n);
+	benchInChild(benchBSTRow, "BST", keys, lookups);
+	benchInChild(benchTreeRow<BPlusTree<unsigned int> >, "B+ tree", keys, lookups);
+
+	sort(keys.begin(), keys.end());
+	printHeader("compare", "increasing", n);
+	benchInChild(benchBSTRow, "BST", keys, lookups);
+	benchInChild(benchTreeRow<BPlusTree<unsigned int> >, "B+ tree", keys, lookups);
+}
+
+static void benchNodeBytes(unsigned int n) {
+	vector<unsigned int> keys = shuffledKeys(n, 2);
+	vector<unsigned int> lookups = lookupsOf(keys);
+	printHeader("nodebytes", "random", n);
+	benchInChild(benchTreeRow<BPlusTree<unsigned int, 128> >, "128 bytes", keys, lookups);
+	benchInChild(benchTreeRow<BPlusTree<unsigned int, 256> >, "256 bytes", keys, lookups);
+	benchInChild(benchTreeRow<BPlusTree<unsigned int, 512> >, "512 bytes", keys, lookups);
+	benchInChild(benchTreeRow<BPlusTree<unsigned int, 1024> >, "1024 bytes", keys, lookups);
+}
+
+int main(int argc, char** argv) {
+	const char* section = argc > 1 ? argv[1] : "all";
+	unsigned int n = argc > 2 ? strtoul(argv[2], NULL, 10) : 1000000;
+	bool all = strcmp(section, "all") == 0;
+	bool ran = false;
+
+	if (all || strcmp(section, "compare") == 0) {
+		benchCompare(n);
+		ran = true;
+	}
+	if (all || strcmp(section, "nodebytes") == 0) {
+		benchNodeBytes(n);
+		ran = true;
+	}
+	if (!ran) {
+		printf("Unknown section \"%s\".\n", section);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,218 @@
+/*
+ * BTreeCheck.cpp
+ *
+ * Description: Randomized checks of the B+ Tree. Random, increasing and
+ *              decreasing inserts (duplicates included) and retrieves run next
+ *              to a std::set, for several node sizes; after each step the tree
+ *              must pass isValid() (leaf depth, node counts, separators, leaf
+ *              chain, element count) and hold what the set holds. Inserts are
+ *              also interrupted by failed node allocations and throwing element
+ *              copies and comparisons, and must then leave the tree as it was.
+ *              Built with AddressSanitizer and UndefinedBehaviorSanitizer by
+ *              "make check", which also runs it.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include "BPlusTree.h"
+
+using namespace std;
+
+// Stops the run with the failed condition and its line.
+#define CHECK(condition) \
+	do { if (!(condition)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); exit(1); } } while (0)
+
+// Every operator new in this program goes through here. While allocationsLeft
+// is not negative, it fails once that many more allocations have been made.
+// Kept out of line: once inlined, GCC sees malloc and free paired with new
+// and delete expressions and warns (-Wmismatched-new-delete).
+static long long allocationsLeft = -1;
+
+__attribute__((noinline)) void* operator new(size_t size) {
+	if (allocationsLeft == 0) throw bad_alloc();
+	if (allocationsLeft > 0) allocationsLeft--;
+	void* memory = malloc(size == 0 ? 1 : size);
+	if (memory == NULL) throw bad_alloc();
+	return memory;
+}
+__attribute__((noinline)) void operator delete(void* memory) noexcept { free(memory); }
+__attribute__((noinline)) void operator delete(void* memory, size_t) noexcept { free(memory); }
+
+// Utility function - Checks that tree holds exactly the elements of reference, in order.
+template <class Tree, class Element>
+static void checkSame(const Tree& tree, const set<Element>& reference) {
+	CHECK(tree.isValid());
+	CHECK(tree.getElementCount() == reference.size());
+	typename set<Element>::const_iterator expected = reference.begin();
+	bool same = tree.forEach([&](const Element& element) {
+		if (expected == reference.end() || !(*expected == element))
+			return false;
+		++expected;
+		return true;
+	});
+	CHECK(same && expected == reference.end());
+}
+
+// Random inserts and retrieves on a BPlusTree<int, NodeBytes>, against a set.
+template <unsigned int NodeBytes>
+static void checkRandom(mt19937& random) {
+	for (unsigned int round = 0; round < 30; round++) {
+		BPlusTree<int, NodeBytes> tree;
+		set<int> reference;
+		unsigned int range = 1 + random() % 5000;
+		for (unsigned int step = 0; step < 3000; step++) {
+			int element = random() % range;
+			bool exists = reference.count(element) > 0;
+			if (random() % 4 != 0) {
+				try { tree.insert(element); CHECK(!exists); } catch (ElementAlreadyExistsException&) { CHECK(exists); }
+				reference.insert(element);
+			}
+			else if (reference.empty()) {
+				try { tree.retrieve(element); CHECK(false); } catch (EmptyDataCollectionException&) {}
+			}
+			else {
+				try { CHECK(tree.retrieve(element) == element && exists); } catch (ElementDoesNotExistException&) { CHECK(!exists); }
+			}
+			CHECK(tree.isValid());
+			CHECK(tree.getElementCount() == reference.size());
+		}
+		checkSame(tree, reference);
+
+		BPlusTree<int, NodeBytes> copy(tree);
+		checkSame(copy, reference);
+		BPlusTree<int, NodeBytes> assigned;
+		assigned.insert(-1);
+		assigned = copy;
+		checkSame(assigned, reference);
+		BPlusTree<int, NodeBytes> moved(move(copy));
+		checkSame(moved, reference);
+		checkSame(copy, set<int>());
+	}
+
+	// Sorted input fills the nodes; reverse sorted input splits them all
+	BPlusTree<int, NodeBytes> increasing;
+	BPlusTree<int, NodeBytes> decreasing;
+	set<int> reference;
+	for (int i = 0; i < 20000; i++) {
+		increasing.insert(i);
+		decreasing.insert(19999 - i);
+		reference.insert(i);
+	}
+	checkSame(increasing, reference);
+	checkSame(decreasing, reference);
+}
+
+// Inserts whose node allocations fail, at every allocation a split makes:
+// the tree must be left as it was, and leak nothing.
+template <unsigned int NodeBytes>
+static void checkAllocationFailure(mt19937& random, bool sorted) {
+	BPlusTree<int, NodeBytes> tree;
+	set<int> reference;
+	unsigned int failures = 0;
+	for (int step = 0; step < 3000; step++) {
+		int element = sorted ? step : (int)(random() % 100000);
+		if (reference.count(element) > 0)
+			continue;
+		for (long long allowed = 0; ; allowed++) {
+			allocationsLeft = allowed;
+			try {
+				tree.insert(element);
+				allocationsLeft = -1;
+				break;
+			}
+			catch (bad_alloc&) {
+				allocationsLeft = -1;
+				failures++;
+				CHECK(tree.isValid());
+				CHECK(tree.getElementCount() == reference.size());
+			}
+		}
+		reference.insert(element);
+	}
+	checkSame(tree, reference);
+	CHECK(failures > 0);
+}
+
+// Element whose copies and comparisons throw once the shared budget runs out.
+// Moves never throw.
+struct Fragile {
+	static int budget;
+	int key;
+
+	Fragile(int key = 0) : key(key) {}
+	Fragile(const Fragile& other) : key(other.key) { spend(); }
+	Fragile(Fragile&& other) noexcept : key(other.key) {}
+	Fragile& operator=(const Fragile& other) { spend(); key = other.key; return *this; }
+	Fragile& operator=(Fragile&& other) noexcept { key = other.key; return *this; }
+	bool operator==(const Fragile& other) const { spend(); return key == other.key; }
+	bool operator>(const Fragile& other) const { spend(); return key > other.key; }
+	bool operator<(const Fragile& other) const { return key < other.key; }
+	static void spend() { if (--budget < 0) throw budget; }
+};
+int Fragile::budget = 1 << 30;
+
+// Inserts interrupted by a throwing copy or comparison, at every point.
+static void checkElementExceptions(mt19937& random) {
+	BPlusTree<Fragile, 32> tree;
+	set<Fragile> reference;
+	for (unsigned int step = 0; step < 2000; step++) {
+		Fragile element(random() % 10000);
+		if (reference.count(element) > 0)
+			continue;
+		for (int budget = 0; ; budget++) {
+			Fragile::budget = budget;
+			try {
+				tree.insert(element);
+				break;
+			}
+			catch (int) {
+				Fragile::budget = 1 << 30;
+				CHECK(tree.isValid());
+				CHECK(tree.getElementCount() == reference.size());
+			}
+		}
+		Fragile::budget = 1 << 30;
+		reference.insert(element);
+	}
+	checkSame(tree, reference);
+}
+
+// Elements that own heap memory, in increasing and random order.
+static void checkStrings(mt19937& random) {
+	BPlusTree<string> tree;
+	set<string> reference;
+	for (unsigned int i = 0; i < 5000; i++) {
+		string element = to_string(i % 2 == 0 ? i : random() % 100000) + string(20, '*');
+		if (reference.insert(element).second)
+			tree.insert(element);
+	}
+	checkSame(tree, reference);
+	BPlusTree<string> copy(tree);
+	checkSame(copy, reference);
+}
+
+int main() {
+	mt19937 random(2022);
+	checkRandom<16>(random);
+	checkRandom<64>(random);
+	checkRandom<256>(random);
+	checkRandom<1024>(random);
+	checkAllocationFailure<16>(random, false);
+	checkAllocationFailure<16>(random, true);
+	checkAllocationFailure<256>(random, false);
+	checkElementExceptions(random);
+	checkStrings(random);
+	printf("All B+ tree checks passed.\n");
+	return 0;
+}
@@ -0,0 +1,96 @@
+/*
+ * BenchmarkRow.h
+ *
+ * Description: One row of the B+ Tree benchmark, for any tree with the BST
+ *              interface (insert / retrieve / forEach). Shared by
+ *              BTreeBenchmark.cpp and BSTBenchmarkRow.cpp, which cannot be one
+ *              translation unit: BTree and BinarySearchTree each define the
+ *              same exception classes.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+
+// A row: times building a tree from "keys", looking up "lookups" and scanning it.
+typedef void (*BenchmarkRow)(const char* name, const vector<unsigned int>& keys, const vector<unsigned int>& lookups);
+
+// Defined in BSTBenchmarkRow.cpp: the row of BST<unsigned int, AVLBalance, PooledNodeAllocator>.
+void benchBSTRow(const char* name, const vector<unsigned int>& keys, const vector<unsigned int>& lookups);
+
+// Keeps the compiler from dropping work whose result is never used.
+static volatile unsigned long long benchmarkSink = 0;
+
+// Utility function - Milliseconds since "start".
+static inline double millisecondsSince(chrono::steady_clock::time_point start) {
+	return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Utility function - Returns the resident set size in bytes, or 0 if unknown.
+static inline unsigned long long residentBytes() {
+	unsigned long long pages = 0, resident = 0;
+	FILE* statm = fopen("/proc/self/statm", "r");
+	if (statm == NULL)
+		return 0;
+	if (fscanf(statm, "%llu %llu", &pages, &resident) != 2)
+		resident = 0;
+	fclose(statm);
+	return resident * sysconf(_SC_PAGESIZE);
+}
+
+// Utility function - Times n inserts of "keys", the retrieves of "lookups",
+//                    a forEach scan and the destruction of a Tree, and how much
+//                    the resident set grew while it was built. Prints one row.
+template <class Tree>
+void benchTreeRow(const char* name, const vector<unsigned int>& keys, const vector<unsigned int>& lookups) {
+	unsigned long long sum = 0;
+	unsigned long long before = residentBytes();
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	Tree* tree = new Tree();
+	for (unsigned int i = 0; i < keys.size(); i++)
+		tree->insert(keys[i]);
+	double insert = millisecondsSince(start);
+	long long grown = (long long)residentBytes() - (long long)before;
+
+	start = chrono::steady_clock::now();
+	for (unsigned int i = 0; i < lookups.size(); i++)
+		sum += tree->retrieve(lookups[i]);
+	double lookup = millisecondsSince(start) * 1e6 / (lookups.empty() ? 1 : lookups.size());
+
+	start = chrono::steady_clock::now();
+	tree->forEach([&](unsigned int element) { sum += element; });
+	double scan = millisecondsSince(start);
+
+	start = chrono::steady_clock::now();
+	delete tree;
+	double destroy = millisecondsSince(start);
+	benchmarkSink = sum;
+	printf("  %-12s %10.1f ms %8.1f ns %10.1f ms %10.1f ms %8.1f MiB\n", name, insert, lookup, scan, destroy, grown / 1048576.0);
+}
+
+// Utility function - Runs "row" in a child process with a fresh heap, so that no
+//                    row reuses memory freed by the one before.
+static inline void benchInChild(BenchmarkRow row, const char* name, const vector<unsigned int>& keys, const vector<unsigned int>& lookups) {
+	fflush(stdout);
+	pid_t child = fork();
+	if (child == 0) {
+		row(name, keys, lookups);
+		fflush(stdout);
+		_exit(0);
+	}
+	if (child < 0)
+		row(name, keys, lookups);
+	else
+		waitpid(child, NULL, 0);
+}
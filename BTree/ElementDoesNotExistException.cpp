@@ -0,0 +1,20 @@
+/*
+ * ElementDoesNotExistException.cpp
+ *
+ * Class Description: Defines the exception that is thrown when 
+ *                    we are searching for an element
+ *                    which is not in the data collection ADT class.
+ *
+ * Author: Inspired from our textbook's authors Frank M. Carrano and Tim Henry.
+ *         Copyright (c) 2013 __Pearson Education__. All rights reserved.
+ */
+ 
+
+#include "ElementDoesNotExistException.h"  
+
+ElementDoesNotExistException::ElementDoesNotExistException(const string& message): 
+logic_error("ElementDoesNotExistException: " + message)
+{
+}  // end constructor
+
+// End of implementation file.
\ No newline at end of file
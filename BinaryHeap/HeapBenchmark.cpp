@@ -0,0 +1,352 @@
+/*
+ * HeapBenchmark.cpp
+ *
+ * Description: Benchmark driver for the heaps in this directory.
+ *              Usage: ./heapbench [section] [n]
+ *              section is one of the names below, or "all" (the default);
+ *              n is the number of elements (1000000 by default).
+ *              "make bench" builds it with optimizations and runs it.
+ *
+ *              build   Loading n keys, in random and in decreasing order (the
+ *                      worst case for insert()): n insert() calls against the
+ *                      range constructor and insertRange() (Floyd's heapify).
+ *              arity   BinaryHeap<K, d> for d = 2, 4, 8 and 16, with K an int, a
+ *                      double and a 64-byte struct, on three workloads:
+ *                      push (n pushes, n/8 pops), pop (build n, pop all) and
+ *                      mixed (n/2 elements, then n random pushes or pops).
+ *              simd    SimdHeap<K> against BinaryHeap<K, 2> and BinaryHeap<K, d>
+ *                      (d the SimdHeap arity) for int32, float and uint64 keys,
+ *                      on the push and pop workloads. The vector instructions
+ *                      come from ARCH in the makefile; the driver prints which
+ *                      SimdHeap path was compiled.
+              stats   What the Stats policy costs: n random ints pushed then
+                      popped, and n random pushes or pops on n/2 ints, on
+                      BinaryHeap<int> with NoHeapStats and with HeapStats,
+                      and on PlainHeap, the binary heap as it was before the
+                      policy (the same sifts, with no hooks at all). Each row
+                      is the best of three runs.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <stdint.h>
+#include <vector>
+#include "BinaryHeap.h"
+#include "SimdHeap.h"
+
+using namespace std;
+
+// Utility function - Milliseconds since "start".
+static double millisecondsSince(chrono::steady_clock::time_point start) {
+	return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Utility function - Returns n random keys.
+static vector<int> randomKeys(unsigned int n, unsigned int seed) {
+	mt19937 random(seed);
+	vector<int> keys(n);
+	for (unsigned int i = 0; i < n; i++)
+		keys[i] = random();
+	return keys;
+}
+
+// Keeps the compiler from dropping work whose result is never used.
+static unsigned long long checksum = 0;
+
+// Utility function - Times the ways of loading "keys" into a BinaryHeap.
+static void benchBuildFrom(const vector<int>& keys, const char* order) {
+	unsigned int n = keys.size();
+	printf("build: n = %u ints, %s\n", n, order);
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	{
+		BinaryHeap<int> heap;
+		for (unsigned int i = 0; i < n; i++)
+			heap.insert(keys[i]);
+		checksum += heap.retrieve();
+	}
+	printf("  %-34s %9.1f ms\n", "n x insert()", millisecondsSince(start));
+
+	start = chrono::steady_clock::now();
+	{
+		BinaryHeap<int> heap;
+		heap.reserve(n);
+		for (unsigned int i = 0; i < n; i++)
+			heap.insert(keys[i]);
+		checksum += heap.retrieve();
+	}
+	printf("  %-34s %9.1f ms\n", "reserve(n) + n x insert()", millisecondsSince(start));
+
+	start = chrono::steady_clock::now();
+	{
+		BinaryHeap<int> heap(keys.begin(), keys.end());
+		checksum += heap.retrieve();
+	}
+	printf("  %-34s %9.1f ms\n", "range constructor", millisecondsSince(start));
+
+	start = chrono::steady_clock::now();
+	{
+		BinaryHeap<int> heap(keys.begin(), keys.begin() + n/2);
+		heap.insertRange(keys.begin() + n/2, keys.end());
+		checksum += heap.retrieve();
+	}
+	printf("  %-34s %9.1f ms\n", "range constructor + insertRange()", millisecondsSince(start));
+}
+
+static void benchBuild(unsigned int n) {
+	vector<int> keys = randomKeys(n, 1);
+	benchBuildFrom(keys, "random order");
+	sort(keys.begin(), keys.end(), greater<int>());
+	benchBuildFrom(keys, "decreasing order");
+}
+
+// 64-byte element ordered by its first 8 bytes.
+struct Record64 {
+	uint64_t key;
+	char payload[56];
+
+	Record64(uint64_t key = 0) : key(key) { memset(payload, 0, sizeof(payload)); }
+	bool operator<(const Record64& other) const { return key < other.key; }
+};
+
+static unsigned long long keyOf(int key) { return key; }
+static unsigned long long keyOf(double key) { return (long long)key; }
+static unsigned long long keyOf(const Record64& record) { return record.key; }
+
+// Utility function - Times the three workloads on a BinaryHeap<ElementType, Arity>
+//                    and prints one row.
+template <class ElementType, unsigned int Arity>
+static void benchArityRow(const vector<ElementType>& keys, const vector<bool>& pushes) {
+	unsigned int n = keys.size();
+	double push, pop, mixed;
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	{
+		BinaryHeap<ElementType, Arity> heap;
+		for (unsigned int i = 0; i < n; i++)
+			heap.insert(keys[i]);
+		for (unsigned int i = 0; i < n/8; i++)
+			checksum += keyOf(heap.pop());
+	}
+	push = millisecondsSince(start);
+
+	{
+		BinaryHeap<ElementType, Arity> heap(keys.begin(), keys.end());
+		start = chrono::steady_clock::now();
+		while (heap.getElementCount() > 0)
+			checksum += keyOf(heap.pop());
+		pop = millisecondsSince(start);
+	}
+
+	{
+		BinaryHeap<ElementType, Arity> heap(keys.begin(), keys.begin() + n/2);
+		start = chrono::steady_clock::now();
+		for (unsigned int i = 0; i < n; i++) {
+			if (pushes[i] || heap.getElementCount() == 0)
+				heap.insert(keys[i]);
+			else
+				checksum += keyOf(heap.pop());
+		}
+		mixed = millisecondsSince(start);
+	}
+	printf("  d = %-2u %12.1f ms %9.1f ms %9.1f ms\n", Arity, push, pop, mixed);
+}
+
+template <class ElementType>
+static void benchArityFor(const char* name, unsigned int n) {
+	vector<int> random = randomKeys(n, 2);
+	vector<ElementType> keys(random.begin(), random.end());
+	vector<bool> pushes(n);
+	for (unsigned int i = 0; i < n; i++)
+		pushes[i] = (random[n - 1 - i] & 1) != 0;
+	printf("arity: n = %u %s\n          push-heavy  pop-heavy      mixed\n", n, name);
+	benchArityRow<ElementType, 2>(keys, pushes);
+	benchArityRow<ElementType, 4>(keys, pushes);
+	benchArityRow<ElementType, 8>(keys, pushes);
+	benchArityRow<ElementType, 16>(keys, pushes);
+}
+
+static void benchArity(unsigned int n) {
+	benchArityFor<int>("ints", n);
+	benchArityFor<double>("doubles", n);
+	benchArityFor<Record64>("64-byte structs", n);
+}
+
+static unsigned long long keyOf(float key) { return (long long)key; }
+static unsigned long long keyOf(uint64_t key) { return key; }
+
+// Utility function - Times n pushes then n pops on Heap, which is either a
+//                    BinaryHeap or a SimdHeap of the same keys.
+template <class Heap, class KeyType>
+static double timePushPop(const vector<KeyType>& keys) {
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	Heap heap;
+	for (unsigned int i = 0; i < keys.size(); i++)
+		heap.insert(keys[i]);
+	for (unsigned int i = 0; i < keys.size(); i++)
+		checksum += keyOf(heap.pop());
+	return millisecondsSince(start);
+}
+
+template <class KeyType>
+static void benchSimdFor(const char* name, unsigned int n) {
+	const unsigned int d = 64 / sizeof(KeyType);
+	vector<int> random = randomKeys(n, 3);
+	vector<KeyType> keys(n);
+	for (unsigned int i = 0; i < n; i++)
+		keys[i] = (KeyType)(uint32_t)random[i];
+	printf("  %-8s %9.1f ms %9.1f ms %9.1f ms\n", name,
+	       timePushPop<BinaryHeap<KeyType, 2> >(keys),
+	       timePushPop<BinaryHeap<KeyType, d> >(keys),
+	       timePushPop<SimdHeap<KeyType> >(keys));
+}
+
+static void benchSimd(unsigned int n) {
+#if defined(__AVX2__)
+	const char* path = "AVX2";
+#elif defined(__AVX__)
+	const char* path = "AVX (floating point), SSE4.1 (integers)";
+#elif defined(__SSE4_1__)
+	const char* path = "SSE4.1";
+#else
+	const char* path = "portable";
+#endif
+	printf("simd: n = %u pushes then n pops, SimdHeap path: %s\n", n, path);
+	printf("           BinaryHeap<K,2> BinaryHeap<K,d>   SimdHeap<K>\n");
+	benchSimdFor<int32_t>("int32", n);
+	benchSimdFor<float>("float", n);
+	benchSimdFor<uint64_t>("uint64", n);
+}
+
+// The BinaryHeap<K, 2> of before the Stats policy, minus the Tracker: the same
+// storage growth, the same early exits and the same hole-moving sifts, with no
+// hooks to compile away.
+template <class KeyType>
+class PlainHeap {
+	vector<KeyType> elements;
+
+	unsigned int indexOfSmallestChild(unsigned int indexOfParent) const {
+		size_t indexOfFirstChild = 2*(size_t)indexOfParent + 1;
+		if (indexOfFirstChild >= elements.size()) return elements.size();
+		if (indexOfFirstChild + 1 < elements.size() && elements[indexOfFirstChild + 1] < elements[indexOfFirstChild])
+			return indexOfFirstChild + 1;
+		return indexOfFirstChild;
+	}
+
+public:
+	PlainHeap() { elements.reserve(50); }
+	unsigned int getElementCount() const { return elements.size(); }
+
+	void insert(const KeyType& newElement) {
+		unsigned int indexOfBottom = elements.size();
+		elements.push_back(newElement);
+		if (indexOfBottom == 0 || !(elements[indexOfBottom] < elements[(indexOfBottom - 1)/2]))
+			return;
+		KeyType bottom = move(elements[indexOfBottom]);
+		do {
+			unsigned int indexOfParent = (indexOfBottom - 1)/2;
+			elements[indexOfBottom] = move(elements[indexOfParent]);
+			indexOfBottom = indexOfParent;
+		} while (indexOfBottom != 0 && bottom < elements[(indexOfBottom - 1)/2]);
+		elements[indexOfBottom] = move(bottom);
+	}
+
+	KeyType pop() {
+		KeyType top = move(elements[0]);
+		if (elements.size() > 1)
+			elements[0] = move(elements.back());
+		elements.pop_back();
+		if (elements.size() < 2)
+			return top;
+		unsigned int indexOfRoot = 0;
+		unsigned int indexOfMinChild = indexOfSmallestChild(indexOfRoot);
+		if (indexOfMinChild == elements.size() || !(elements[indexOfMinChild] < elements[indexOfRoot]))
+			return top;
+		KeyType root = move(elements[indexOfRoot]);
+		do {
+			elements[indexOfRoot] = move(elements[indexOfMinChild]);
+			indexOfRoot = indexOfMinChild;
+			indexOfMinChild = indexOfSmallestChild(indexOfRoot);
+		} while (indexOfMinChild != elements.size() && elements[indexOfMinChild] < root);
+		elements[indexOfRoot] = move(root);
+		return top;
+	}
+};
+
+// Utility function - Times n/2 pushes, then n random pushes or pops, on Heap.
+template <class Heap>
+static double timeMixed(const vector<int>& keys) {
+	unsigned int n = keys.size();
+	Heap heap;
+	for (unsigned int i = 0; i < n/2; i++)
+		heap.insert(keys[i]);
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (unsigned int i = 0; i < n; i++) {
+		if ((keys[n - 1 - i] & 1) != 0 || heap.getElementCount() == 0)
+			heap.insert(keys[i]);
+		else
+			checksum += heap.pop();
+	}
+	return millisecondsSince(start);
+}
+
+// Utility function - Prints the best of three runs of both workloads on Heap.
+template <class Heap>
+static void benchStatsRow(const char* name, const vector<int>& keys) {
+	double pushPop = 0, mixed = 0;
+	for (unsigned int run = 0; run < 3; run++) {
+		double time = timePushPop<Heap>(keys);
+		pushPop = run == 0 || time < pushPop ? time : pushPop;
+		time = timeMixed<Heap>(keys);
+		mixed = run == 0 || time < mixed ? time : mixed;
+	}
+	printf("  %-26s %9.1f ms %9.1f ms\n", name, pushPop, mixed);
+}
+
+static void benchStats(unsigned int n) {
+	vector<int> keys = randomKeys(n, 4);
+	printf("stats: n = %u ints, best of 3\n                             push + pop      mixed\n", n);
+	benchStatsRow<PlainHeap<int> >("PlainHeap", keys);
+	benchStatsRow<BinaryHeap<int> >("BinaryHeap, NoHeapStats", keys);
+	benchStatsRow<BinaryHeap<int, 2, less<int>, NoPositionTracking, HeapStats> >("BinaryHeap, HeapStats", keys);
+}
+
+int main(int argc, char** argv) {
+	const char* section = argc > 1 ? argv[1] : "all";
+	unsigned int n = argc > 2 ? strtoul(argv[2], NULL, 10) : 1000000;
+	bool all = strcmp(section, "all") == 0;
+	bool ran = false;
+
+	if (all || strcmp(section, "build") == 0) {
+		benchBuild(n);
+		ran = true;
+	}
+	if (all || strcmp(section, "arity") == 0) {
+		benchArity(n);
+		ran = true;
+	}
+	if (all || strcmp(section, "simd") == 0) {
+		benchSimd(n);
+		ran = true;
+	}
+	if (all || strcmp(section, "stats") == 0) {
+		benchStats(n);
+		ran = true;
+	}
+	if (!ran) {
+		printf("Unknown section \"%s\".\n", section);
+		return 1;
+	}
+	printf("(checksum %llu)\n", checksum);
+	return 0;
+}
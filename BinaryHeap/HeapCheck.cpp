@@ -0,0 +1,332 @@
+/*
+ * HeapCheck.cpp
+ *
+ * Description: Randomized checks of the heaps in this directory. Every heap
+ *              is filled from random input (with many equal keys) and then
+ *              emptied; what comes out must match the sorted input. HeapStats
+              must give the counts worked out by hand for a few short
+              sequences. Built
+ *              with AddressSanitizer and UndefinedBehaviorSanitizer by
+ *              "make check", which also runs it, once with the vector
+ *              instructions in ARCH and once without, so that SimdHeap's
+ *              vector and portable child scans are both covered.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <set>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "BinaryHeap.h"
+#include "SimdHeap.h"
+
+using namespace std;
+
+// Stops the run with the failed condition and its line.
+#define CHECK(condition) \
+	do { if (!(condition)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); exit(1); } } while (0)
+
+// Utility function - Returns "count" random keys from [0, range).
+static vector<int> randomKeys(mt19937& random, unsigned int count, unsigned int range) {
+	vector<int> keys(count);
+	for (unsigned int i = 0; i < count; i++)
+		keys[i] = random() % range;
+	return keys;
+}
+
+// Utility function - Pops every element of heap and checks that they come out
+//                   in the order of expected sorted by Compare.
+template <class Heap, class ElementType, class Compare>
+static void checkDrains(Heap& heap, vector<ElementType> expected, Compare compare) {
+	CHECK(heap.getElementCount() == expected.size());
+	sort(expected.begin(), expected.end(), compare);
+	for (unsigned int i = 0; i < expected.size(); i++) {
+		CHECK(heap.retrieve() == expected[i]);
+		CHECK(heap.pop() == expected[i]);
+	}
+	CHECK(heap.getElementCount() == 0);
+}
+
+// Range constructor and insertRange, on both the heapify path (a batch at
+// least as large as the heap) and the sift-up path (a smaller batch).
+static void checkBuild(mt19937& random) {
+	for (unsigned int round = 0; round < 300; round++) {
+		unsigned int count = random() % 2000;
+		vector<int> keys = randomKeys(random, count, 1 + random() % 500);
+
+		BinaryHeap<int> built(keys.begin(), keys.end());
+		checkDrains(built, keys, less<int>());
+
+		unsigned int split = count == 0 ? 0 : random() % (count + 1);
+		BinaryHeap<int, 2, greater<int> > grown(keys.begin(), keys.begin() + split);
+		grown.insertRange(keys.begin() + split, keys.end());
+		checkDrains(grown, keys, greater<int>());
+	}
+
+	vector<string> words;
+	for (unsigned int i = 0; i < 500; i++)
+		words.push_back(to_string(random() % 100) + string(i % 40, '.'));
+	BinaryHeap<string> strings(words.begin(), words.end());
+	checkDrains(strings, words, less<string>());
+}
+
+// Random pushes and pops on a BinaryHeap<int, Arity>, against a multiset.
+template <unsigned int Arity>
+static void checkArity(mt19937& random) {
+	for (unsigned int round = 0; round < 40; round++) {
+		BinaryHeap<int, Arity> heap;
+		multiset<int> reference;
+		unsigned int range = 1 + random() % 1000;
+		for (unsigned int step = 0; step < 3000; step++) {
+			if (random() % 3 != 0 || reference.empty()) {
+				int key = random() % range;
+				heap.insert(key);
+				reference.insert(key);
+			}
+			else {
+				CHECK(heap.pop() == *reference.begin());
+				reference.erase(reference.begin());
+			}
+			CHECK(heap.getElementCount() == reference.size());
+		}
+		vector<int> rest(reference.begin(), reference.end());
+		checkDrains(heap, rest, less<int>());
+	}
+}
+
+// A heap so wide that Arity*index + 1 passes UINT_MAX at index 4096, one of the
+// root's children: an element sifting down to that slot must stop there.
+static void checkWideArity() {
+	const unsigned int Arity = 1u << 20;
+	BinaryHeap<int, Arity> heap;
+	vector<int> keys;
+	keys.push_back(0);
+	for (int i = 1; i < 5000; i++)
+		keys.push_back(i == 4096 ? 1 : 100 + i);
+	for (unsigned int i = 0; i < keys.size(); i++)
+		heap.insert(keys[i]);    // Every parent is the root, so nothing moves
+	checkDrains(heap, keys, less<int>());
+}
+
+// Utility function - Checks every count of a HeapStats snapshot. depths lists
+//                    siftDepths[0], siftDepths[1], ...; deeper ones must be 0.
+static void checkCounts(const HeapStatsSnapshot& counts, unsigned long long comparisons, unsigned long long moves,
+                        unsigned long long insertions, unsigned long long removals, unsigned long long replacements,
+                        unsigned long long reallocations, unsigned int peakSize, vector<unsigned long long> depths) {
+	CHECK(counts.comparisons == comparisons);
+	CHECK(counts.moves == moves);
+	CHECK(counts.insertions == insertions);
+	CHECK(counts.removals == removals);
+	CHECK(counts.replacements == replacements);
+	CHECK(counts.reallocations == reallocations);
+	CHECK(counts.peakSize == peakSize);
+	depths.resize(HeapStatsSnapshot::SIFT_DEPTHS, 0);
+	for (unsigned int d = 0; d < HeapStatsSnapshot::SIFT_DEPTHS; d++)
+		CHECK(counts.siftDepths[d] == depths[d]);
+}
+
+// HeapStats on short fixed sequences, whose counts are worked out by hand.
+static void checkStats() {
+	typedef BinaryHeap<int, 2, less<int>, NoPositionTracking, HeapStats> CountingHeap;
+	CountingHeap heap;
+	heap.insert(5);     // First storage; nothing to compare with
+	heap.insert(3);     // 1 comparison, up 1 level: 3 moves
+	heap.insert(8);     // 1 comparison, stays
+	heap.insert(1);     // 2 comparisons, up 2 levels: 4 moves
+	checkCounts(heap.getStats().snapshot(), 4, 9, 4, 0, 0, 1, 4, { 2, 1, 1 });
+	CHECK(heap.pop() == 1);     // [5 3 8]: 2 comparisons, down 1 level: 3 moves
+	CHECK(heap.pop() == 3);     // [8 5]: 1 comparison, down 1 level: 3 moves
+	checkCounts(heap.getStats().snapshot(), 7, 15, 4, 2, 0, 1, 4, { 2, 3, 1 });
+	CHECK(heap.replaceTop(9) == 5);     // [9 8]: 1 comparison, down 1 level: 3 moves
+	CHECK(heap.pushPop(20) == 8);       // 1 comparison, then as replaceTop
+	CHECK(heap.pushPop(4) == 4);        // 1 comparison, heap untouched
+	checkCounts(heap.getStats().snapshot(), 11, 21, 4, 2, 2, 1, 4, { 2, 5, 1 });
+	heap.reserve(100);
+	heap.shrink_to_fit();
+	checkCounts(heap.getStats().snapshot(), 11, 21, 4, 2, 2, 3, 4, { 2, 5, 1 });
+	heap.getStats().reset();
+	checkCounts(heap.getStats().snapshot(), 0, 0, 0, 0, 0, 0, 0, {});
+
+	// Increasing keys never move up; the storage grows from 50 to 100
+	CountingHeap increasing;
+	for (int i = 0; i < 60; i++)
+		increasing.insert(i);
+	checkCounts(increasing.getStats().snapshot(), 59, 60, 60, 0, 0, 2, 60, { 60 });
+	// popN's bottom-up deletion: the hole walks 5 levels down the left
+	// spine, 1 comparison each, then 59 lands in it and stays
+	increasing.getStats().reset();
+	vector<int> out;
+	increasing.popN(1, back_inserter(out));
+	CHECK(out.size() == 1 && out[0] == 0);
+	checkCounts(increasing.getStats().snapshot(), 6, 6, 0, 1, 0, 0, 0, { 1, 0, 0, 0, 0, 1 });
+}
+
+// SimdHeap's version of checkWideArity, on its portable child scan. Each pop
+// scans 2^20 children, so only a few are made.
+static void checkSimdWideArity() {
+	const unsigned int Arity = 1u << 20;
+	SimdHeap<int32_t, Arity> heap;
+	for (int32_t i = 0; i < 5000; i++)
+		heap.insert(i == 0 ? 0 : i == 4096 ? 1 : 100 + i);
+	CHECK(heap.pop() == 0);
+	CHECK(heap.pop() == 1);
+	CHECK(heap.pop() == 101);
+	CHECK(heap.pop() == 102);
+	CHECK(heap.getElementCount() == 4996);
+}
+
+// Element whose copies and moves throw once the shared budget runs out.
+struct Fragile {
+	static int budget;
+	static int alive;
+	int key;
+	string payload;
+
+	Fragile(int key) : key(key), payload(40, '*') { alive++; }
+	Fragile(const Fragile& other) : key(other.key), payload(other.payload) { spend(); alive++; }
+	Fragile(Fragile&& other) : key(other.key), payload(move(other.payload)) { spend(); alive++; }
+	Fragile& operator=(const Fragile& other) { key = other.key; payload = other.payload; return *this; }
+	Fragile& operator=(Fragile&& other) noexcept { key = other.key; payload = move(other.payload); return *this; }
+	~Fragile() { alive--; }
+	bool operator<(const Fragile& other) const { return key < other.key; }
+	bool operator==(const Fragile& other) const { return key == other.key; }
+	static void spend() { if (--budget < 0) throw budget; }
+};
+int Fragile::budget = 1 << 30;
+int Fragile::alive = 0;
+
+// Copies, growth and insertRange interrupted by a throwing element: nothing
+// leaks, and the heap keeps its elements in heap order.
+static void checkExceptionSafety(mt19937& random) {
+	{
+		vector<Fragile> input;
+		vector<int> keys = randomKeys(random, 300, 1000);
+		for (unsigned int i = 0; i < keys.size(); i++)
+			input.push_back(Fragile(keys[i]));
+		BinaryHeap<Fragile> heap(input.begin(), input.end());
+
+		for (int budget = 0; budget < 300; budget += 17) {
+			Fragile::budget = budget;
+			try { BinaryHeap<Fragile> copy(heap); CHECK(false); } catch (int) {}
+		}
+
+		Fragile::budget = 1 << 30;
+		while (heap.getElementCount() < heap.getCapacity())
+			heap.insert(Fragile(random() % 1000));
+		unsigned int count = heap.getElementCount();
+		Fragile::budget = count / 2;
+		try { heap.insert(Fragile(7)); CHECK(false); } catch (int) {}
+		CHECK(heap.getElementCount() == count);
+
+		Fragile::budget = 25;
+		try { heap.insertRange(input.begin(), input.end()); CHECK(false); } catch (int) {}
+		Fragile::budget = 1 << 30;
+		int previous = -1;
+		while (heap.getElementCount() > 0) {
+			int key = heap.pop().key;
+			CHECK(key >= previous);
+			previous = key;
+		}
+	}
+	CHECK(Fragile::alive == 0);
+
+	// drainSorted: a throwing write keeps every element, a returning one empties the heap
+	vector<int> keys = randomKeys(random, 1000, 300);
+	BinaryHeap<int, 4> sorted(keys.begin(), keys.end());
+	try { sorted.drainSorted([](const int*, unsigned int) { throw 1; }); CHECK(false); } catch (int) {}
+	vector<int> written;
+	sorted.drainSorted([&written](const int* elements, unsigned int count) { written.assign(elements, elements + count); });
+	CHECK(sorted.getElementCount() == 0);
+	sort(keys.begin(), keys.end());
+	CHECK(written == keys);
+
+	// replaceTop with an alias of the root
+	BinaryHeap<string> heap;
+	heap.insert("b");
+	heap.insert("c");
+	CHECK(heap.replaceTop(heap.retrieve()) == "b");
+	CHECK(heap.retrieve() == "b");
+}
+
+// Utility function - Returns a random key of KeyType from [0, range), or now
+//                    and then the largest key, which is also SimdHeap's sentinel.
+template <class KeyType>
+static KeyType randomSimdKey(mt19937& random, unsigned int range) {
+	if (random() % 50 == 0)
+		return numeric_limits<KeyType>::has_infinity ? numeric_limits<KeyType>::infinity() : numeric_limits<KeyType>::max();
+	KeyType key = (KeyType)(random() % range);
+	return numeric_limits<KeyType>::is_signed && random() % 2 ? -key : key;
+}
+
+// Random pushes and pops on a SimdHeap<KeyType, Arity>, against a multiset,
+// with copies and assignments along the way.
+template <class KeyType, unsigned int Arity>
+static void checkSimd(mt19937& random) {
+	for (unsigned int round = 0; round < 30; round++) {
+		SimdHeap<KeyType, Arity> heap;
+		multiset<KeyType> reference;
+		unsigned int range = 1 + random() % 1000;
+		for (unsigned int step = 0; step < 3000; step++) {
+			if (random() % 3 != 0 || reference.empty()) {
+				KeyType key = randomSimdKey<KeyType>(random, range);
+				CHECK(heap.insert(key));
+				reference.insert(key);
+			}
+			else {
+				CHECK(heap.retrieve() == *reference.begin());
+				CHECK(heap.pop() == *reference.begin());
+				reference.erase(reference.begin());
+			}
+			CHECK(heap.getElementCount() == reference.size());
+		}
+
+		SimdHeap<KeyType, Arity> copy(heap);
+		SimdHeap<KeyType, Arity> assigned;
+		assigned.insert(randomSimdKey<KeyType>(random, range));
+		assigned = copy;
+		for (typename multiset<KeyType>::iterator key = reference.begin(); key != reference.end(); ++key) {
+			CHECK(heap.pop() == *key);
+			CHECK(copy.pop() == *key);
+			CHECK(assigned.pop() == *key);
+		}
+		CHECK(heap.getElementCount() == 0 && copy.getElementCount() == 0 && assigned.getElementCount() == 0);
+		try { heap.pop(); CHECK(false); } catch (EmptyDataCollectionException&) {}
+	}
+}
+
+int main() {
+	mt19937 random(2022);
+	checkBuild(random);
+	checkArity<2>(random);
+	checkArity<3>(random);
+	checkArity<4>(random);
+	checkArity<8>(random);
+	checkArity<16>(random);
+	checkWideArity();
+	checkSimdWideArity();
+	checkStats();
+	checkExceptionSafety(random);
+	// The default arities hit the vector specializations where ARCH enables them
+	checkSimd<int32_t, 16>(random);
+	checkSimd<uint32_t, 16>(random);
+	checkSimd<float, 16>(random);
+	checkSimd<double, 8>(random);
+	checkSimd<int64_t, 8>(random);
+	checkSimd<uint64_t, 8>(random);
+	checkSimd<int16_t, 32>(random);
+	checkSimd<int32_t, 4>(random);
+	checkSimd<double, 3>(random);
+	printf("All heap checks passed.\n");
+	return 0;
+}
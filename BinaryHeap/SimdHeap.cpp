@@ -0,0 +1,348 @@
+/*
+ * SimdHeap.cpp
+ *
+ * Description: Minimum Heap data collection ADT class for arithmetic keys.
+ *              Wide implementation: every node has Arity children, stored
+ *              in one 64-byte aligned group that SmallestChild scans with
+ *              vector compares where the target supports them.
+ *
+ * Class Invariant:  Always a Minimum Heap, and elements[elementCount .. capacity-1]
+ *                   hold the sentinel.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#include "SimdHeap.h"  // Header file
+
+#if defined(__GNUC__) && (defined(__SSE4_1__) || defined(__AVX__))
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// Vector versions of SmallestChild for a full cache line of keys. Each one
+// takes the minimum across the group, broadcasts it back to every lane,
+// compares the group against it and returns the lowest matching lane.
+#if defined(__GNUC__) && defined(__AVX__)
+
+// Utility function - Minimum of all 8 floats of v, in every lane.
+static inline __m256 allLanesMin(__m256 v) {
+	v = _mm256_min_ps(v, _mm256_permute2f128_ps(v, v, 1));
+	v = _mm256_min_ps(v, _mm256_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+	return _mm256_min_ps(v, _mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+template <>
+struct SmallestChild<float, 16> {
+	static unsigned int indexIn(const float* children) {
+		__m256 low = _mm256_load_ps(children);
+		__m256 high = _mm256_load_ps(children + 8);
+		__m256 min = allLanesMin(_mm256_min_ps(low, high));
+		unsigned int mask = _mm256_movemask_ps(_mm256_cmp_ps(low, min, _CMP_EQ_OQ))
+		                  | _mm256_movemask_ps(_mm256_cmp_ps(high, min, _CMP_EQ_OQ)) << 8;
+		return __builtin_ctz(mask);
+	}
+};
+
+template <>
+struct SmallestChild<double, 8> {
+	static unsigned int indexIn(const double* children) {
+		__m256d low = _mm256_load_pd(children);
+		__m256d high = _mm256_load_pd(children + 4);
+		__m256d min = _mm256_min_pd(low, high);
+		min = _mm256_min_pd(min, _mm256_permute2f128_pd(min, min, 1));
+		min = _mm256_min_pd(min, _mm256_shuffle_pd(min, min, 0x5));
+		unsigned int mask = _mm256_movemask_pd(_mm256_cmp_pd(low, min, _CMP_EQ_OQ))
+		                  | _mm256_movemask_pd(_mm256_cmp_pd(high, min, _CMP_EQ_OQ)) << 4;
+		return __builtin_ctz(mask);
+	}
+};
+
+#endif
+
+#if defined(__GNUC__) && defined(__AVX2__)
+
+// Utility function - Lowest lane of the 16 32-bit integers in low and high
+//                    equal to the one in every lane of min.
+static inline unsigned int lowestEqualLane(__m256i low, __m256i high, __m256i min) {
+	unsigned int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(low, min)))
+	                  | _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(high, min))) << 8;
+	return __builtin_ctz(mask);
+}
+
+template <>
+struct SmallestChild<int32_t, 16> {
+	static unsigned int indexIn(const int32_t* children) {
+		__m256i low = _mm256_load_si256(reinterpret_cast<const __m256i*>(children));
+		__m256i high = _mm256_load_si256(reinterpret_cast<const __m256i*>(children + 8));
+		__m256i min = _mm256_min_epi32(low, high);
+		min = _mm256_min_epi32(min, _mm256_permute2x128_si256(min, min, 1));
+		min = _mm256_min_epi32(min, _mm256_shuffle_epi32(min, _MM_SHUFFLE(1, 0, 3, 2)));
+		min = _mm256_min_epi32(min, _mm256_shuffle_epi32(min, _MM_SHUFFLE(2, 3, 0, 1)));
+		return lowestEqualLane(low, high, min);
+	}
+};
+
+template <>
+struct SmallestChild<uint32_t, 16> {
+	static unsigned int indexIn(const uint32_t* children) {
+		__m256i low = _mm256_load_si256(reinterpret_cast<const __m256i*>(children));
+		__m256i high = _mm256_load_si256(reinterpret_cast<const __m256i*>(children + 8));
+		__m256i min = _mm256_min_epu32(low, high);
+		min = _mm256_min_epu32(min, _mm256_permute2x128_si256(min, min, 1));
+		min = _mm256_min_epu32(min, _mm256_shuffle_epi32(min, _MM_SHUFFLE(1, 0, 3, 2)));
+		min = _mm256_min_epu32(min, _mm256_shuffle_epi32(min, _MM_SHUFFLE(2, 3, 0, 1)));
+		return lowestEqualLane(low, high, min);
+	}
+};
+
+// AVX2 has no 64-bit minimum, so it is built from a signed compare and a
+// blend. Unsigned keys are compared with their top bit flipped.
+template <bool Unsigned>
+struct SmallestChild64 {
+	static inline __m256i min(__m256i a, __m256i b) {
+		return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+	}
+
+	static unsigned int indexIn(const void* children) {
+		const __m256i flip = _mm256_set1_epi64x(Unsigned ? (long long)0x8000000000000000ULL : 0);
+		__m256i low = _mm256_xor_si256(_mm256_load_si256(static_cast<const __m256i*>(children)), flip);
+		__m256i high = _mm256_xor_si256(_mm256_load_si256(static_cast<const __m256i*>(children) + 1), flip);
+		__m256i least = min(low, high);
+		least = min(least, _mm256_permute4x64_epi64(least, _MM_SHUFFLE(1, 0, 3, 2)));
+		least = min(least, _mm256_permute4x64_epi64(least, _MM_SHUFFLE(2, 3, 0, 1)));
+		unsigned int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(low, least)))
+		                  | _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(high, least))) << 4;
+		return __builtin_ctz(mask);
+	}
+};
+
+template <>
+struct SmallestChild<int64_t, 8> {
+	static unsigned int indexIn(const int64_t* children) { return SmallestChild64<false>::indexIn(children); }
+};
+
+template <>
+struct SmallestChild<uint64_t, 8> {
+	static unsigned int indexIn(const uint64_t* children) { return SmallestChild64<true>::indexIn(children); }
+};
+
+#elif defined(__GNUC__) && defined(__SSE4_1__)
+
+// SSE4.1: the 16 keys are four 128-bit vectors.
+
+// Utility function - Lowest lane of the 16 keys in groups equal to the one in every lane of min.
+static inline unsigned int lowestEqualLane(const __m128i* groups, __m128i min) {
+	unsigned int mask = 0;
+	for (unsigned int i = 0; i < 4; i++)
+		mask |= _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(groups[i], min))) << (4*i);
+	return __builtin_ctz(mask);
+}
+
+#if !defined(__AVX__)
+template <>
+struct SmallestChild<float, 16> {
+	static unsigned int indexIn(const float* children) {
+		const __m128* groups = reinterpret_cast<const __m128*>(children);
+		__m128 min = _mm_min_ps(_mm_min_ps(groups[0], groups[1]), _mm_min_ps(groups[2], groups[3]));
+		min = _mm_min_ps(min, _mm_shuffle_ps(min, min, _MM_SHUFFLE(1, 0, 3, 2)));
+		min = _mm_min_ps(min, _mm_shuffle_ps(min, min, _MM_SHUFFLE(2, 3, 0, 1)));
+		unsigned int mask = 0;
+		for (unsigned int i = 0; i < 4; i++)
+			mask |= _mm_movemask_ps(_mm_cmpeq_ps(groups[i], min)) << (4*i);
+		return __builtin_ctz(mask);
+	}
+};
+#endif
+
+template <>
+struct SmallestChild<int32_t, 16> {
+	static unsigned int indexIn(const int32_t* children) {
+		const __m128i* groups = reinterpret_cast<const __m128i*>(children);
+		__m128i min = _mm_min_epi32(_mm_min_epi32(groups[0], groups[1]), _mm_min_epi32(groups[2], groups[3]));
+		min = _mm_min_epi32(min, _mm_shuffle_epi32(min, _MM_SHUFFLE(1, 0, 3, 2)));
+		min = _mm_min_epi32(min, _mm_shuffle_epi32(min, _MM_SHUFFLE(2, 3, 0, 1)));
+		return lowestEqualLane(groups, min);
+	}
+};
+
+template <>
+struct SmallestChild<uint32_t, 16> {
+	static unsigned int indexIn(const uint32_t* children) {
+		const __m128i* groups = reinterpret_cast<const __m128i*>(children);
+		__m128i min = _mm_min_epu32(_mm_min_epu32(groups[0], groups[1]), _mm_min_epu32(groups[2], groups[3]));
+		min = _mm_min_epu32(min, _mm_shuffle_epi32(min, _MM_SHUFFLE(1, 0, 3, 2)));
+		min = _mm_min_epu32(min, _mm_shuffle_epi32(min, _MM_SHUFFLE(2, 3, 0, 1)));
+		return lowestEqualLane(groups, min);
+	}
+};
+
+#endif
+
+// Default Constructor
+// Description: Storage is only allocated by the first insertion.
+template <class KeyType, unsigned int Arity>
+SimdHeap<KeyType, Arity>::SimdHeap() {
+	elementCount = 0;
+	capacity = 0;
+	storage = NULL;
+	elements = NULL;
+
+} // end of default constructor
+
+// Copy Constructor
+template <class KeyType, unsigned int Arity>
+SimdHeap<KeyType, Arity>::SimdHeap(const SimdHeap<KeyType, Arity>& aHeap) {
+	elementCount = 0;
+	capacity = 0;
+	storage = NULL;
+	elements = NULL;
+	if (aHeap.capacity > 0) {
+		reallocate(aHeap.capacity);
+		memcpy(elements, aHeap.elements, aHeap.elementCount*sizeof(KeyType));
+		elementCount = aHeap.elementCount;
+	}
+
+} // end of copy constructor
+
+// Destructor
+template <class KeyType, unsigned int Arity>
+SimdHeap<KeyType, Arity>::~SimdHeap() {
+	::operator delete(storage);
+
+} // end destructor
+
+// Assignment operator
+template <class KeyType, unsigned int Arity>
+SimdHeap<KeyType, Arity>& SimdHeap<KeyType, Arity>::operator=(SimdHeap<KeyType, Arity> rhs) {
+	swap(elementCount, rhs.elementCount);
+	swap(capacity, rhs.capacity);
+	swap(storage, rhs.storage);
+	swap(elements, rhs.elements);
+	return *this;
+
+} // end operator=
+
+// Utility method - Key no element is smaller than: +infinity, or the largest value.
+template <class KeyType, unsigned int Arity>
+KeyType SimdHeap<KeyType, Arity>::sentinel() {
+	return numeric_limits<KeyType>::has_infinity ? numeric_limits<KeyType>::infinity() : numeric_limits<KeyType>::max();
+}
+
+// Utility method - Moves the elements into new aligned storage able to hold
+//                  newCapacity elements and fills the rest with the sentinel.
+//                  The root sits at the end of the first aligned group, so
+//                  the children of every node start on a group boundary.
+template <class KeyType, unsigned int Arity>
+void SimdHeap<KeyType, Arity>::reallocate(unsigned int newCapacity) {
+	size_t slots = (Arity - 1) + newCapacity;
+	void* newStorage = ::operator new(slots*sizeof(KeyType) + ALIGNMENT - 1);
+	uintptr_t aligned = (reinterpret_cast<uintptr_t>(newStorage) + ALIGNMENT - 1) & ~(uintptr_t)(ALIGNMENT - 1);
+	KeyType* newElements = reinterpret_cast<KeyType*>(aligned) + (Arity - 1);
+
+	if (elementCount > 0)
+		memcpy(newElements, elements, elementCount*sizeof(KeyType));
+	for (unsigned int i = elementCount; i < newCapacity; i++)
+		newElements[i] = sentinel();
+
+	::operator delete(storage);
+	storage = newStorage;
+	elements = newElements;
+	capacity = newCapacity;
+}
+
+// Utility method - Moves the hole at index up past every larger parent, then fills it with key.
+template <class KeyType, unsigned int Arity>
+void SimdHeap<KeyType, Arity>::reHeapUp(unsigned int index, KeyType key) {
+	while (index > 0) {
+		unsigned int indexOfParent = parentOf(index);
+		if (!(key < elements[indexOfParent]))
+			break;
+		elements[index] = elements[indexOfParent];
+		index = indexOfParent;
+	}
+	elements[index] = key;
+
+} // end reHeapUp
+
+// Utility method - Moves the hole at index down past every smaller child, then fills it with key.
+//                  The sentinels after the last element are never smaller than a real child,
+//                  so the smallest child is always a real one.
+template <class KeyType, unsigned int Arity>
+void SimdHeap<KeyType, Arity>::reHeapDown(unsigned int index, KeyType key) {
+	size_t indexOfFirstChild = firstChildOf(index);
+	while (indexOfFirstChild < elementCount) {
+		unsigned int indexOfMinChild = indexOfFirstChild + SmallestChild<KeyType, Arity>::indexIn(elements + indexOfFirstChild);
+		if (!(elements[indexOfMinChild] < key))
+			break;
+		elements[index] = elements[indexOfMinChild];
+		index = indexOfMinChild;
+		indexOfFirstChild = firstChildOf(index);
+	}
+	elements[index] = key;
+
+} // end reHeapDown
+
+// Description: Returns the number of elements in the Simd Heap.
+// Time Efficiency: O(1)
+template <class KeyType, unsigned int Arity>
+unsigned int SimdHeap<KeyType, Arity>::getElementCount() const {
+	return elementCount;
+}
+
+// Description: Inserts newElement into the Simd Heap.
+//              The storage doubles its groups of children whenever it is full.
+// Exceptions: Throws length_error if the storage cannot grow any further.
+// Time Efficiency: O(logd n) amortized, where d is Arity
+template <class KeyType, unsigned int Arity>
+bool SimdHeap<KeyType, Arity>::insert(KeyType newElement) {
+	if (elementCount == capacity) {
+		if (capacity > numeric_limits<unsigned int>::max()/2)
+			throw length_error("SimdHeap storage cannot hold more elements.");
+		reallocate(capacity == 0 ? 1 + Arity*((INITIAL_CAPACITY + Arity - 1)/Arity) : 2*capacity - 1);
+	}
+	reHeapUp(elementCount++, newElement);
+	return true;
+}
+
+// Description: Removes (but does not return) the element located at the root.
+// Precondition: This Simd Heap is not empty.
+// Exceptions: Throws EmptyDataCollectionException if this Simd Heap is empty.
+template <class KeyType, unsigned int Arity>
+void SimdHeap<KeyType, Arity>::remove() {
+	if (elementCount == 0)
+		throw EmptyDataCollectionException("remove() called with an empty SimdHeap.");
+	pop();
+}
+
+// Description: Removes and returns the element located at the root.
+//              The last element fills the root's hole, and its old slot
+//              becomes a sentinel before it sifts down.
+// Precondition: This Simd Heap is not empty.
+// Exceptions: Throws EmptyDataCollectionException if this Simd Heap is empty.
+template <class KeyType, unsigned int Arity>
+KeyType SimdHeap<KeyType, Arity>::pop() {
+	if (elementCount == 0)
+		throw EmptyDataCollectionException("pop() called with an empty SimdHeap.");
+	KeyType top = elements[0];
+	KeyType last = elements[--elementCount];
+	elements[elementCount] = sentinel();
+	if (elementCount > 0)
+		reHeapDown(0, last);
+	return top;
+}
+
+// Description: Retrieves (but does not remove) the element located at the root.
+// Precondition: This Simd Heap is not empty.
+// Exceptions: Throws EmptyDataCollectionException if this Simd Heap is empty.
+template <class KeyType, unsigned int Arity>
+KeyType SimdHeap<KeyType, Arity>::retrieve() const {
+	if (elementCount == 0)
+		throw EmptyDataCollectionException("retrieve() called with an empty SimdHeap.");
+	return elements[0];
+}
+
+//  End of implementation file.
\ No newline at end of file
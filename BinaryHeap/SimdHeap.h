@@ -0,0 +1,130 @@
+/*
+ * SimdHeap.h
+ *
+ * Description: Minimum Heap data collection ADT class for arithmetic keys.
+ *              Wide implementation: every node has Arity children (by default
+ *              as many keys as fit in 64 bytes: 16 ints or floats, 8 doubles
+ *              or 64-bit integers). The storage is 64-byte aligned and laid
+ *              out so that the children of a node fill exactly one cache line,
+ *              which SmallestChild scans with vector compares (AVX2, AVX or
+ *              SSE4.1, whichever the compiler targets) or a scalar loop.
+ *              Unused slots hold a sentinel no key is smaller than, so a
+ *              last, partly filled group of children needs no special case.
+ *
+ * Class Invariant:  Always a Minimum Heap, and elements[elementCount .. capacity-1]
+ *                   hold the sentinel.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#pragma once
+
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <type_traits>
+#include "EmptyDataCollectionException.h"
+
+using namespace std;
+
+// Finds the smallest of the Arity keys starting at children and returns its
+// offset; the first one wins a tie. children is aligned to the size of the
+// group when that size divides 64. This is the portable version; SimdHeap.cpp
+// specializes it for the common key types when vector instructions are available.
+template <class KeyType, unsigned int Arity>
+struct SmallestChild {
+	static unsigned int indexIn(const KeyType* children) {
+		unsigned int indexOfMin = 0;
+		for (unsigned int i = 1; i < Arity; i++)
+			indexOfMin = children[i] < children[indexOfMin] ? i : indexOfMin;
+		return indexOfMin;
+	}
+};
+
+template <class KeyType, unsigned int Arity = (64 / sizeof(KeyType) >= 2 ? 64 / sizeof(KeyType) : 2)>
+class SimdHeap {
+
+	static_assert(is_arithmetic<KeyType>::value, "SimdHeap only holds arithmetic keys.");
+	static_assert(Arity >= 2, "SimdHeap needs at least two children per node.");
+
+private:
+	static const unsigned int INITIAL_CAPACITY = 50;
+	static const size_t ALIGNMENT = 64;
+	unsigned int elementCount;
+	unsigned int capacity;    // Always 1 + a multiple of Arity: the root and whole groups of children
+	void* storage;            // As returned by operator new
+	KeyType* elements;        // elements + 1 is ALIGNMENT-aligned, so every group of children is too
+
+	static unsigned int parentOf(unsigned int index) { return (index - 1)/Arity; }
+	// In size_t: Arity*index + 1 passes UINT_MAX long before the storage is full
+	static size_t firstChildOf(unsigned int index) { return Arity*(size_t)index + 1; }
+
+	// Utility method - Key no element is smaller than: +infinity, or the largest value.
+	static KeyType sentinel();
+
+	// Utility methods - Place key, starting from the hole at index, moving the hole
+	//                   up past larger parents or down past smaller children.
+	void reHeapUp(unsigned int index, KeyType key);
+	void reHeapDown(unsigned int index, KeyType key);
+
+	// Utility method - Moves the elements into new aligned storage able to hold
+	//                  newCapacity elements and fills the rest with the sentinel.
+	void reallocate(unsigned int newCapacity);
+
+public:
+	// Default Constructor
+	SimdHeap();
+
+	// Copy Constructor
+	SimdHeap(const SimdHeap<KeyType, Arity>& aHeap);
+
+	// Destructor
+	~SimdHeap();
+
+	// Assignment operator
+	SimdHeap<KeyType, Arity>& operator=(SimdHeap<KeyType, Arity> rhs);
+
+	// Description: Returns the number of elements in the Simd Heap.
+	// Postcondition:  The Simd Heap is unchanged by this operation.
+	// Time Efficiency: O(1)
+	unsigned int getElementCount() const;
+
+	// Description: Inserts newElement into the Simd Heap.
+	//              It returns "true" if successful, otherwise "false".
+	// Precondition: newElement is not NaN.
+	// Postcondition: Remains a Minimum Heap after the insertion.
+	// Exceptions: Throws length_error if the storage cannot grow any further.
+	// Time Efficiency: O(logd n) amortized, where d is Arity
+	bool insert(KeyType newElement);
+
+	// Description: Removes (but does not return) the element located at the root.
+	// Precondition: This Simd Heap is not empty.
+	// Postcondition: Remains a Minimum Heap after the removal.
+	// Exceptions: Throws EmptyDataCollectionException if this Simd Heap is empty.
+	// Time Efficiency: O(logd n), with one vector scan of the children per level
+	void remove();
+
+	// Description: Removes and returns the element located at the root.
+	// Precondition: This Simd Heap is not empty.
+	// Postcondition: Remains a Minimum Heap after the removal.
+	// Exceptions: Throws EmptyDataCollectionException if this Simd Heap is empty.
+	// Time Efficiency: O(logd n), with one vector scan of the children per level
+	KeyType pop();
+
+	// Description: Retrieves (but does not remove) the element located at the root.
+	// Precondition: This Simd Heap is not empty.
+	// Postcondition: This Simd Heap is unchanged.
+	// Exceptions: Throws EmptyDataCollectionException if this Simd Heap is empty.
+	// Time Efficiency: O(1)
+	KeyType retrieve() const;
+
+}; // end SimdHeap
+
+#include "SimdHeap.cpp"
@@ -16,82 +16,212 @@
 /* Constructors and destructor */
 
 	// Default constructor
-    template<class ElementType>
-	BST<ElementType>::BST() {
+    template<class ElementType, class Balance, template <class> class NodeAllocator>
+	BST<ElementType, Balance, NodeAllocator>::BST() {
 		root = NULL;
 		elementCount = 0;
 	}
 	
 	// Parameterized constructor
-    template<class ElementType>      
-    BST<ElementType>::BST(ElementType& element) {
-		root = new BSTNode<ElementType>(element);
+    template<class ElementType, class Balance, template <class> class NodeAllocator>      
+    BST<ElementType, Balance, NodeAllocator>::BST(ElementType& element) {
+		root = nodes.create(element);
+		Balance::inserted(root, root);
 		elementCount = 1;	
 	}               
 
     // Copy constructor 
-	// Precondition: aBST is not empty
-	// Postcondition: Creates a new BST which is a copy of aBST
-    template<class ElementType>  
-	BST<ElementType>::BST(const BST<ElementType>& aBST)  
+	// Postcondition: Creates a new BST which is a copy of aBST, with the same shape
+	// Time efficiency: O(n)
+    template<class ElementType, class Balance, template <class> class NodeAllocator>  
+	BST<ElementType, Balance, NodeAllocator>::BST(const BST<ElementType, Balance, NodeAllocator>& aBST)  
 	{
-		if (aBST.getElementCount() == 0) {
-			throw EmptyDataCollectionException("Binary search tree is empty.");
+		root = NULL;
+		elementCount = 0;
+		cloneFrom(aBST.root);
+		elementCount = aBST.getElementCount();
+	}
+
+    // Move constructor 
+	// Postcondition: Takes over the nodes of aBST, which is left empty
+	// Time efficiency: O(1)
+    template<class ElementType, class Balance, template <class> class NodeAllocator>  
+	BST<ElementType, Balance, NodeAllocator>::BST(BST<ElementType, Balance, NodeAllocator>&& aBST) noexcept
+	{
+		root = aBST.root;
+		elementCount = aBST.elementCount;
+		nodes.swap(aBST.nodes);
+		aBST.root = NULL;
+		aBST.elementCount = 0;
+	}
+
+	// cloneFrom
+	// Description: Helper for the copy constructor. Copies the subtree rooted at 
+	//				"source" node for node. Walks the source down its child links and
+	//				back up its parent links, building the copy in step, so there is
+	//				no recursion and no comparison. If an element cannot be copied,
+	//				the nodes copied so far are destroyed.
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	void BST<ElementType, Balance, NodeAllocator>::cloneFrom(const BSTNode<ElementType>* source){
+		if(source == NULL){
+			return;
 		}
-		else{
-			copyR(aBST.root);
-			elementCount = aBST->getElementCount();
+		try{
+			root = cloneNode(source, NULL);
+			const BSTNode<ElementType>* from = source;
+			BSTNode<ElementType>* to = root;
+			while(true){
+				if(from->hasLeft() && !to->hasLeft()){
+					to->left = cloneNode(from->left, to);
+					from = from->left;
+					to = to->left;
+				}
+				else if(from->hasRight() && !to->hasRight()){
+					to->right = cloneNode(from->right, to);
+					from = from->right;
+					to = to->right;
+				}
+				else if(from == source){
+					break;
+				}
+				else{
+					// Both subtrees copied: back up to the parent
+					from = from->parent;
+					to = to->parent;
+				}
+			}
+		}
+		catch(...){
+			destroy(root);
+			root = NULL;
+			throw;
 		}
 	}
-	// copyR
-	// Description: Recursive helper for the constructor. Inserts the current
-	//				element into the BST. Checks if a left or right element needs
-	//				to be added into the BST, and calls itself accordingly if so.
-	template<class ElementType>
-	void BST<ElementType>::copyR(BSTNode<ElementType>* current){
-		insert(current->element);
-		if(current->hasLeft()){
-			copyR(current->left);
+
+	// cloneNode
+	// Description: Creates a node holding a copy of source's element, rank and size,
+	//				below "parent".
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	BSTNode<ElementType>* BST<ElementType, Balance, NodeAllocator>::cloneNode(const BSTNode<ElementType>* source, BSTNode<ElementType>* parent){
+		BSTNode<ElementType>* node = nodes.create(source->element);
+		node->parent = parent;
+		node->rank = source->rank;
+		node->size = source->size;
+		return node;
+	}
+
+	// Description: Returns a binary search tree holding the elements in [first, last),
+	//              with every level full but the last. The nodes are created in order,
+	//              then linked with linkBalanced, so the elements are never compared.
+	// Precondition: [first, last) is in increasing order, without duplicates.
+	// Time efficiency: O(n)
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	template<class InputIterator>
+	BST<ElementType, Balance, NodeAllocator> BST<ElementType, Balance, NodeAllocator>::fromSorted(InputIterator first, InputIterator last){
+		BST<ElementType, Balance, NodeAllocator> tree;
+		vector<BSTNode<ElementType>*> inOrder;
+		try{
+			for(; first != last; ++first){
+				inOrder.push_back(NULL);
+				inOrder.back() = tree.nodes.create(*first);
+			}
 		}
-		if(current->hasRight()){
-			copyR(current->right);
+		catch(...){
+			// Not linked yet, so the tree's destructor would not find them
+			for(unsigned int i = 0; i < inOrder.size(); i++){
+				if(inOrder[i] != NULL){
+					tree.nodes.destroy(inOrder[i]);
+				}
+			}
+			throw;
+		}
+		unsigned int height = 0;
+		while(height < 32 && (1u << height) <= inOrder.size()){
+			height++;
 		}
+		tree.root = linkBalanced(inOrder.data(), inOrder.size(), NULL, 0, height);
+		tree.elementCount = inOrder.size();
+		return tree;
 	}
 
 
 	// Destructor
-	// Precondition: BST is not empty
 	// Postcondition: All elements in the BST are deleted 
-    template<class ElementType> 
-	BST<ElementType>::~BST() {
-		if(elementCount > 0){
-			destructorR(root);
+    template<class ElementType, class Balance, template <class> class NodeAllocator> 
+	BST<ElementType, Balance, NodeAllocator>::~BST() {
+		// Nodes with nothing to destroy go when their allocator frees its memory
+		if(!(NodeAllocator< BSTNode<ElementType> >::FREES_ALL_NODES && is_trivially_destructible<ElementType>::value)){
+			destroy(root);
 		}
     }
 
-	// destructorR
-	// Description: Recursive helper for the destructor. Deletes the current
-	//				element after checking and calling destructorR if left or
-	//				right elements exist
-	template<class ElementType> 
-	void BST<ElementType>::destructorR(BSTNode<ElementType>* current){
-		if(current->hasLeft()){
-			destructorR(current->left);
-		}
-		if(current->hasRight()){
-			destructorR(current->right);
+	// destroy
+	// Description: Helper for the destructor. Deletes the nodes of the subtree 
+	//				rooted at "current" without recursion: goes down to a leaf, 
+	//				deletes it, unlinks it from its parent and carries on from there.
+	template<class ElementType, class Balance, template <class> class NodeAllocator> 
+	void BST<ElementType, Balance, NodeAllocator>::destroy(BSTNode<ElementType>* current){
+		BSTNode<ElementType>* top = current == NULL ? NULL : current->parent;
+		while(current != top){
+			if(current->hasLeft()){
+				current = current->left;
+			}
+			else if(current->hasRight()){
+				current = current->right;
+			}
+			else{
+				BSTNode<ElementType>* parent = current->parent;
+				if(parent != top){
+					if(parent->left == current){
+						parent->left = NULL;
+					}
+					else{
+						parent->right = NULL;
+					}
+				}
+				nodes.destroy(current);
+				current = parent;
+			}
 		}
-		delete current;
-		current = NULL;
 	}                 
 	
 	
+/* Assignment operators */
+
+	// Copy assignment operator
+	// Description: Makes this BST a copy of rhs, with the same shape. If copying
+	//              fails, this BST is unchanged.
+	// Time efficiency: O(n + m)
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	BST<ElementType, Balance, NodeAllocator>& BST<ElementType, Balance, NodeAllocator>::operator=(const BST<ElementType, Balance, NodeAllocator>& rhs) {
+		if(this != &rhs){
+			BST<ElementType, Balance, NodeAllocator> copy(rhs);
+			*this = move(copy);
+		}
+		return *this;
+	}
+
+	// Move assignment operator
+	// Description: Takes over the nodes of rhs, which is left empty, as after the
+	//              move constructor; this BST's old nodes are deleted.
+	// Time efficiency: O(1), plus O(m) to delete the m old nodes
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	BST<ElementType, Balance, NodeAllocator>& BST<ElementType, Balance, NodeAllocator>::operator=(BST<ElementType, Balance, NodeAllocator>&& rhs) noexcept {
+		// The old nodes leave with "taken"; a self-move gets its own nodes back
+		BST<ElementType, Balance, NodeAllocator> taken(move(rhs));
+		swap(root, taken.root);
+		swap(elementCount, taken.elementCount);
+		nodes.swap(taken.nodes);
+		return *this;
+	}
+	
+	
 /* Getters and setters */
 
     // Description: Returns the number of elements currently stored in the binary search tree.	
 	// Time efficiency: O(1)
-    template<class ElementType>	
-	unsigned int BST<ElementType>::getElementCount() const {		
+    template<class ElementType, class Balance, template <class> class NodeAllocator>	
+	unsigned int BST<ElementType, Balance, NodeAllocator>::getElementCount() const {		
 
 		return this->elementCount;
 	}
@@ -100,144 +230,491 @@
 /* BST Operations */
 
     // Description: Inserts an element into the binary search tree.
-	//              This is a wrapper method which calls the recursive insertR( ).
 	// Precondition: "newElement" does not already exist in the binary search tree.
     // Exception: Throws the exception "ElementAlreadyExistsException" 
 	//            if "newElement" already exists in the binary search tree.
 	// Time efficiency: O(log2 n)	
-    template<class ElementType>
-	void BST<ElementType>::insert(const ElementType& newElement) {
+    template<class ElementType, class Balance, template <class> class NodeAllocator>
+	void BST<ElementType, Balance, NodeAllocator>::insert(const ElementType& newElement) {
 		
-	    // Binary search tree is empty, so add the new element as the root
-		if (elementCount == 0) {
-			root = new BSTNode<ElementType>(newElement);
-			elementCount++;
-		}
-		else if ( !insertR(newElement,root) ) {
-  	        throw ElementAlreadyExistsException("Element already exists in the data collection.\n");
+		// Walk down to the empty spot where newElement belongs. Nothing is
+		// changed until the new node exists, so a throwing comparison or
+		// element copy leaves the tree as it was.
+		BSTNode<ElementType>* parent = NULL;
+		BSTNode<ElementType>* current = root;
+		bool goesLeft = false;
+		while(current != NULL){
+			if(current->element == newElement){
+				throw ElementAlreadyExistsException("Element already exists in the data collection.\n");
+			}
+			parent = current;
+			goesLeft = current->element > newElement;
+			current = goesLeft ? current->left : current->right;
 		}
-		
-  	}
 
-    // Description: Recursive insertion into a binary search tree.
-	//              Returns true when "anElement" has been successfully inserted into the 
-	//              binary search tree. Otherwise, returns false.
-    template<class ElementType>
-	bool BST<ElementType>::insertR(const ElementType& anElement, BSTNode<ElementType>* current) { 
-		// If element already exists in the BST...
-		if(current->element == anElement){
-			return false;
+		BSTNode<ElementType>* newNode = nodes.create(newElement);
+		// newElement is now in the subtree of every node on the way down
+		for(BSTNode<ElementType>* ancestor = parent; ancestor != NULL; ancestor = ancestor->parent){
+			ancestor->size++;
 		}
-		// CASE 1: anElement is greater than element checked
-		// 		   so it continues down the left branch. Calls itself if
-		//		   current already has a left element, inserts itself otherwise.
-		else if(current->element > anElement){
-			if(current->hasLeft()){
-				return insertR(anElement,current->left);
-			}
-			else{
-				BSTNode<ElementType>* newNode = new BSTNode<ElementType>(anElement);
-				current->left = newNode;
-				elementCount++;
-			}
+		newNode->parent = parent;
+	    // Binary search tree is empty, so add the new element as the root
+		if(parent == NULL){
+			root = newNode;
+		}
+		else if(goesLeft){
+			parent->left = newNode;
 		}
-		// CASE 2: anElement is less than the element checked
-		//  	   so it continues down the right branch. Calls itself if
-		//		   current already has a right element, inserts itself otherwise.
 		else{
-			if(current->hasRight()){					
-				return insertR(anElement,current->right);
-			}
-			else{
-				BSTNode<ElementType>* newNode = new BSTNode<ElementType>(anElement);
-				current->right = newNode;
-				elementCount++;			
-			}
+			parent->right = newNode;
 		}
-		return true;
-	}
+		elementCount++;
+		// Let the balancing policy rotate the tree back into shape
+		Balance::inserted(newNode, root);
+  	}
 
-	
     // Description: Retrieves "targetElement" from the binary search tree.
-	//              This is a wrapper method which calls the recursive retrieveR( ).
 	// Precondition: Binary search tree is not empty.
     // Exception: Throws the exception "EmptyDataCollectionException" 
 	//            if the binary search tree is empty.
-	// Exception: Throws (propagates) the exception "ElementDoesNotExistException" 
-	//            thrown from the retrieveR(...)
+	// Exception: Throws the exception "ElementDoesNotExistException" 
 	//            if "targetElement" is not in the binary search tree.
 	// Time efficiency: O(log2 n)
-    template<class ElementType>
-    ElementType& BST<ElementType>::retrieve(const ElementType& targetElement) const {
+    template<class ElementType, class Balance, template <class> class NodeAllocator>
+    ElementType& BST<ElementType, Balance, NodeAllocator>::retrieve(const ElementType& targetElement) const {
         
 	    // Check precondition: If binary search tree is empty
 		if (elementCount == 0){ 
 			throw EmptyDataCollectionException("Binary search tree is empty.\n");
 		}
 		// Otherwise, search for it		
-		ElementType& translated = retrieveR(targetElement, root);
-
-		return translated;
+		BSTNode<ElementType>* found = findNode(targetElement);
+		if(found == NULL){
+			throw ElementDoesNotExistException("Element was unable to be located");
+		}
+		return found->element;
 	}
 
-    // Description: Recursive retrieval from a binary search tree.
-	// Exception: Throws the exception "ElementDoesNotExistException" 
-	//            if "targetElement" is not found in the binary search tree.
-    template<class ElementType>
-    ElementType& BST<ElementType>::retrieveR(const ElementType& targetElement, BSTNode<ElementType>* current) const {
-		// If the current element is the target element, return current->element
-		if(current->element == targetElement){
-			return current->element;
+    // Description: Removes "targetElement" from the binary search tree.
+    // Exception: Throws the exception "ElementDoesNotExistException" 
+	//            if "targetElement" is not in the binary search tree.
+	// Time efficiency: O(log2 n)
+    template<class ElementType, class Balance, template <class> class NodeAllocator>
+	void BST<ElementType, Balance, NodeAllocator>::remove(const ElementType& targetElement) {
+		BSTNode<ElementType>* found = findNode(targetElement);
+		if(found == NULL){
+			throw ElementDoesNotExistException("Element was unable to be located");
 		}
-		// If the current element is larger than the target element and a left
-		// element exists, continue down the left branch
-		else if(current->element > targetElement){
-			if(current-> hasLeft()){
-				return retrieveR(targetElement, current->left);
+		removeNode(found);
+	}
+
+    // Description: Removes every element for which pred(element) returns true, and 
+	//              returns how many were removed. The remaining nodes are relinked
+	//              into a tree with every level full but the last.
+	// Time efficiency: O(n)
+    template<class ElementType, class Balance, template <class> class NodeAllocator>
+	template<class Predicate>
+	unsigned int BST<ElementType, Balance, NodeAllocator>::removeIf(Predicate&& pred) {
+		// Sort the nodes out first, so that a throwing pred leaves the tree as it was
+		vector<BSTNode<ElementType>*> kept;
+		vector<BSTNode<ElementType>*> removed;
+		kept.reserve(elementCount);
+		for(BSTNode<ElementType>* current = firstOf(root); current != NULL; current = successor(current)){
+			if(pred(static_cast<const ElementType&>(current->element))){
+				removed.push_back(current);
 			}
-		}
-		// Otherwise, if a right element exists, continue down the right branch
-		else{
-			if(current-> hasRight()){
-				return retrieveR(targetElement, current->right);
+			else{
+				kept.push_back(current);
 			}
 		}
-		// If none of these conditions apply, throw ELementDoesNotExist exception
-		throw ElementDoesNotExistException("Element was unable to be located");
-	} // end of retrieveR
+		if(removed.empty()){
+			return 0;
+		}
+
+		// All at once, so that the NodeAllocator can take them back in bulk
+		nodes.destroyAll(removed.data(), removed.size());
+		unsigned int height = 0;
+		while(height < 32 && (1u << height) <= kept.size()){
+			height++;
+		}
+		root = linkBalanced(kept.data(), kept.size(), NULL, 0, height);
+		elementCount = kept.size();
+		return removed.size();
+	}
+
+    // Description: Returns the node holding "targetElement", or NULL if there is none.
+	// Time efficiency: O(log2 n)
+    template<class ElementType, class Balance, template <class> class NodeAllocator>
+    BSTNode<ElementType>* BST<ElementType, Balance, NodeAllocator>::findNode(const ElementType& targetElement) const {
+		BSTNode<ElementType>* current = root;
+		while(current != NULL && !(current->element == targetElement)){
+			// Larger elements are on the right, smaller ones on the left
+			current = current->element > targetElement ? current->left : current->right;
+		}
+		return current;
+	}
 				
 	
     // Description: Traverses the binary search tree in order.
-	//              This is a wrapper method which calls the recursive traverseInOrderR( ).
 	//              The action to be done on each element during the traverse is the function "visit".
 	// Precondition: Binary search tree is not empty.
     // Exception: Throws the exception "EmptyDataCollectionException" 
 	//            if the binary search tree is empty.
 	// Time efficiency: O(n)		
-    template<class ElementType>
-	void BST<ElementType>::traverseInOrder(void visit(const ElementType&)) const {
+    template<class ElementType, class Balance, template <class> class NodeAllocator>
+	void BST<ElementType, Balance, NodeAllocator>::traverseInOrder(void visit(const ElementType&)) const {
 		
 		// Check precondition: If binary search tree is empty
 		if (elementCount == 0)  
 			throw EmptyDataCollectionException("Binary search tree is empty.");
 		else {
-			traverseInOrderR(visit,root);
+			forEach(visit);
+		}
+	}
+
+    // Description: Calls visit(element) on every element, in order. If visit returns
+	//              a bool, returning false stops the traversal there.
+	//              Returns "false" if the traversal was stopped, otherwise "true".
+	// Time efficiency: O(n), or O(k + log2 n) when stopped after k elements
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	template<class Function>
+	bool BST<ElementType, Balance, NodeAllocator>::forEach(Function&& visit) const {
+		for(BSTNode<ElementType>* current = firstOf(root); current != NULL; current = successor(current)){
+			if(!visitElement(visit, current->element, typename is_void<decltype(visit(current->element))>::type())){
+				return false;
+			}
+		}
+		return true;
+	}
+
+
+/* Removal helpers */
+
+	// Description: Unlinks "node" from the binary search tree, lets the balancing 
+	//              policy repair the tree, and destroys it. A node with two children
+	//              is replaced by its successor, moved there link by link rather than
+	//              by copying elements, so iterators to other elements stay valid.
+	// Time efficiency: O(log2 n)
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	void BST<ElementType, Balance, NodeAllocator>::removeNode(BSTNode<ElementType>* node) {
+		// The node whose spot in the tree becomes empty: node itself, or its successor
+		BSTNode<ElementType>* leaving = node->hasLeft() && node->hasRight() ? firstOf(node->right) : node;
+		for(BSTNode<ElementType>* ancestor = leaving->parent; ancestor != NULL; ancestor = ancestor->parent){
+			ancestor->size--;
+		}
+
+		unsigned char removedRank = leaving->rank;
+		BSTNode<ElementType>* child = leaving->hasLeft() ? leaving->left : leaving->right;
+		BSTNode<ElementType>* parent = leaving->parent;
+		if(leaving == node){
+			replaceChild(node, child);
+		}
+		else{
+			// The successor has no left child; its right subtree takes its spot,
+			// then it takes node's spot, links and rank.
+			if(parent == node){
+				parent = leaving;
+			}
+			else{
+				replaceChild(leaving, child);
+				leaving->right = node->right;
+				leaving->right->parent = leaving;
+			}
+			replaceChild(node, leaving);
+			leaving->left = node->left;
+			leaving->left->parent = leaving;
+			leaving->rank = node->rank;
+			leaving->size = node->size;
 		}
+		elementCount--;
+		Balance::removed(child, parent, removedRank, root);
+		nodes.destroy(node);
 	}
 
-    // Description: Recursive in order traversal of a binary search tree.	
-	template<class ElementType>
-	void BST<ElementType>::traverseInOrderR(void visit(const ElementType&), BSTNode<ElementType>* current) const {
+	// Description: Replaces the subtree rooted at "node" with the one rooted at
+	//              "replacement" (which may be NULL) in the eyes of node's parent.
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	void BST<ElementType, Balance, NodeAllocator>::replaceChild(BSTNode<ElementType>* node, BSTNode<ElementType>* replacement) {
+		if(node->parent == NULL){
+			root = replacement;
+		}
+		else if(node->parent->left == node){
+			node->parent->left = replacement;
+		}
+		else{
+			node->parent->right = replacement;
+		}
+		if(replacement != NULL){
+			replacement->parent = node->parent;
+		}
+	}
+
+	// Description: Links the "count" nodes starting at "nodes", which are in order,
+	//              into a tree with every level full but the last, and returns its root.
+	//              The middle node becomes the root and each half a subtree, so the
+	//              subtrees of every node differ in size by at most one.
+	// Time efficiency: O(count)
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	BSTNode<ElementType>* BST<ElementType, Balance, NodeAllocator>::linkBalanced(BSTNode<ElementType>** nodes, unsigned int count, BSTNode<ElementType>* parent, 
+	                                                                            unsigned int depth, unsigned int height) {
+		if(count == 0){
+			return NULL;
+		}
+		unsigned int middle = count / 2;
+		BSTNode<ElementType>* node = nodes[middle];
+		node->parent = parent;
+		node->left = linkBalanced(nodes, middle, node, depth + 1, height);
+		node->right = linkBalanced(nodes + middle + 1, count - middle - 1, node, depth + 1, height);
+		node->size = count;
+		Balance::built(node, depth, height);
+		return node;
+	}
+
+
+/* Range queries and order statistics */
+
+    // Description: Returns an iterator to the smallest element not smaller than 
+	//              "element", or end() if there is none.
+	// Time efficiency: O(log2 n)
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	typename BST<ElementType, Balance, NodeAllocator>::Iterator BST<ElementType, Balance, NodeAllocator>::lowerBound(const ElementType& element) const {
+		return Iterator(lowerBoundNode(element), this);
+	}
+
+    // Description: Returns an iterator to the smallest element larger than 
+	//              "element", or end() if there is none.
+	// Time efficiency: O(log2 n)
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	typename BST<ElementType, Balance, NodeAllocator>::Iterator BST<ElementType, Balance, NodeAllocator>::upperBound(const ElementType& element) const {
+		BSTNode<ElementType>* found = NULL;
+		BSTNode<ElementType>* current = root;
+		while(current != NULL){
+			if(current->element > element){
+				// A candidate; a smaller one can only be on its left
+				found = current;
+				current = current->left;
+			}
+			else{
+				current = current->right;
+			}
+		}
+		return Iterator(found, this);
+	}
+
+    // Description: Calls visit(element) on every element from "low" to "high", 
+	//              both included, in order. Returns "false" if visit stopped it.
+	// Time efficiency: O(log2 n + k) for the k elements visited
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	template<class Function>
+	bool BST<ElementType, Balance, NodeAllocator>::rangeForEach(const ElementType& low, const ElementType& high, Function&& visit) const {
+		for(BSTNode<ElementType>* current = lowerBoundNode(low); current != NULL && !(current->element > high); current = successor(current)){
+			if(!visitElement(visit, current->element, typename is_void<decltype(visit(current->element))>::type())){
+				return false;
+			}
+		}
+		return true;
+	}
+
+    // Description: Returns the number of elements from "low" to "high", both included.
+	// Time efficiency: O(log2 n)
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	unsigned int BST<ElementType, Balance, NodeAllocator>::countInRange(const ElementType& low, const ElementType& high) const {
+		if(low > high){
+			return 0;
+		}
+		return countUpTo(high) - rank(low);
+	}
+
+    // Description: Returns the number of elements smaller than "element".
+	// Time efficiency: O(log2 n)
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	unsigned int BST<ElementType, Balance, NodeAllocator>::rank(const ElementType& element) const {
+		unsigned int count = 0;
+		BSTNode<ElementType>* current = root;
+		while(current != NULL){
+			if(element > current->element){
+				// current and its whole left subtree are smaller
+				count += sizeOf(current->left) + 1;
+				current = current->right;
+			}
+			else{
+				current = current->left;
+			}
+		}
+		return count;
+	}
+
+    // Description: Returns the element at position k in order, counting from 0.
+    // Exception: Throws the exception "ElementDoesNotExistException" 
+	//            if k >= getElementCount().
+	// Time efficiency: O(log2 n)
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	const ElementType& BST<ElementType, Balance, NodeAllocator>::select(unsigned int k) const {
+		if(k >= elementCount){
+			throw ElementDoesNotExistException("select() position is past the last element.");
+		}
+		BSTNode<ElementType>* current = root;
+		while(k != sizeOf(current->left)){
+			if(k < sizeOf(current->left)){
+				current = current->left;
+			}
+			else{
+				// Skip current and its left subtree
+				k -= sizeOf(current->left) + 1;
+				current = current->right;
+			}
+		}
+		return current->element;
+	}
+
+    // Description: Returns the first node whose element is not smaller than
+	//              "element", or NULL if there is none.
+	// Time efficiency: O(log2 n)
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	BSTNode<ElementType>* BST<ElementType, Balance, NodeAllocator>::lowerBoundNode(const ElementType& element) const {
+		BSTNode<ElementType>* found = NULL;
+		BSTNode<ElementType>* current = root;
+		while(current != NULL){
+			if(element > current->element){
+				current = current->right;
+			}
+			else{
+				// A candidate; a smaller one can only be on its left
+				found = current;
+				current = current->left;
+			}
+		}
+		return found;
+	}
+
+    // Description: Returns the number of elements not larger than "element".
+	// Time efficiency: O(log2 n)
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	unsigned int BST<ElementType, Balance, NodeAllocator>::countUpTo(const ElementType& element) const {
+		unsigned int count = 0;
+		BSTNode<ElementType>* current = root;
+		while(current != NULL){
+			if(current->element > element){
+				current = current->left;
+			}
+			else{
+				// current and its whole left subtree are not larger
+				count += sizeOf(current->left) + 1;
+				current = current->right;
+			}
+		}
+		return count;
+	}
+
+
+/* Iterators */
+
+    // Description: Returns an iterator to the smallest element, or end() if 
+	//              the binary search tree is empty.
+	// Time efficiency: O(log2 n)
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	typename BST<ElementType, Balance, NodeAllocator>::Iterator BST<ElementType, Balance, NodeAllocator>::begin() const {
+		return Iterator(firstOf(root), this);
+	}
+
+    // Description: Returns the iterator past the largest element.
+	// Time efficiency: O(1)
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	typename BST<ElementType, Balance, NodeAllocator>::Iterator BST<ElementType, Balance, NodeAllocator>::end() const {
+		return Iterator(NULL, this);
+	}
+
+/* Snapshots */
+
+    // Description: Returns a read-only copy of the elements laid out in Eytzinger
+	//              order. The elements are copied in order, never compared.
+	// Time efficiency: O(n)
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	FrozenBST<ElementType> BST<ElementType, Balance, NodeAllocator>::freeze() const {
+		return FrozenBST<ElementType>(begin(), elementCount);
+	}
+
+/* Checks */
+
+    // Description: Returns "true" if the parent links, the subtree sizes, the BST
+	//              order and the element count agree with one another, and the
+	//              balancing policy's invariant holds. Visits the nodes in order,
+	//              checking each one against its children and its predecessor.
+	// Time efficiency: O(n)
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	bool BST<ElementType, Balance, NodeAllocator>::isValid() const {
+		if(root == NULL){
+			return elementCount == 0;
+		}
+		if(root->parent != NULL || root->size != elementCount){
+			return false;
+		}
+		BSTNode<ElementType>* previous = NULL;
+		for(BSTNode<ElementType>* current = firstOf(root); current != NULL; current = successor(current)){
+			if((current->hasLeft() && current->left->parent != current) ||
+			   (current->hasRight() && current->right->parent != current) ||
+			   current->size != 1 + sizeOf(current->left) + sizeOf(current->right) ||
+			   (previous != NULL && !(current->element > previous->element))){
+				return false;
+			}
+			previous = current;
+		}
+		return Balance::isValid(static_cast<const BSTNode<ElementType>*>(root));
+	}
+
+	// Description: Returns the first (smallest) node of the subtree rooted at 
+	//              "current", or NULL if it is empty.
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	BSTNode<ElementType>* BST<ElementType, Balance, NodeAllocator>::firstOf(BSTNode<ElementType>* current) {
+		if(current != NULL){
+			while(current->hasLeft()){
+				current = current->left;
+			}
+		}
+		return current;
+	}
+
+	// Description: Returns the last (largest) node of the subtree rooted at 
+	//              "current", or NULL if it is empty.
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	BSTNode<ElementType>* BST<ElementType, Balance, NodeAllocator>::lastOf(BSTNode<ElementType>* current) {
+		if(current != NULL){
+			while(current->hasRight()){
+				current = current->right;
+			}
+		}
+		return current;
+	}
+
+	// Description: Returns the node after "current" in order, or NULL if there is none: 
+	//              the first node of its right subtree if it has one, otherwise the 
+	//              nearest ancestor it is on the left of.
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	BSTNode<ElementType>* BST<ElementType, Balance, NodeAllocator>::successor(BSTNode<ElementType>* current) {
+		if(current->hasRight()){
+			return firstOf(current->right);
+		}
+		BSTNode<ElementType>* parent = current->parent;
+		while(parent != NULL && parent->right == current){
+			current = parent;
+			parent = parent->parent;
+		}
+		return parent;
+	}
 
-		// If a left element exists, visit the left element
+	// Description: Returns the node before "current" in order, or NULL if there is none: 
+	//              the last node of its left subtree if it has one, otherwise the 
+	//              nearest ancestor it is on the right of.
+	template<class ElementType, class Balance, template <class> class NodeAllocator>
+	BSTNode<ElementType>* BST<ElementType, Balance, NodeAllocator>::predecessor(BSTNode<ElementType>* current) {
 		if(current->hasLeft()){
-			traverseInOrderR(visit,current->left);
+			return lastOf(current->left);
 		}
-		// Visit the current element before checking if the right element exists
-		visit(current->element);
-		// If a right element exists, visit the right element 
-		if(current -> hasRight()){
-			traverseInOrderR(visit,current->right);
+		BSTNode<ElementType>* parent = current->parent;
+		while(parent != NULL && parent->left == current){
+			current = parent;
+			parent = parent->parent;
 		}
+		return parent;
 	}
 	
@@ -4,6 +4,13 @@
  * Description: Binary Search Tree data collection ADT class.
  *              Link-based implementation.
  *              Duplicated elements are not allowed.
+ *              The Balance policy (see BSTBalance.h) keeps the height in
+ *              O(log2 n): AVLBalance (default) or RedBlackBalance.
+ *              NoBalance leaves the tree as inserted.
+ *              The NodeAllocator (see BSTNodeAllocator.h) creates the nodes:
+ *              NewNodeAllocator (default) or PooledNodeAllocator.
+ *              freeze() takes a read-only FrozenBST snapshot (see FrozenBST.h)
+ *              for tables that are built once and then only searched.
  *
  * Class invariant: It is always a BST.
  * 
@@ -14,13 +21,20 @@
 
 #pragma once
 
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
 #include "BSTNode.h" 
+#include "BSTBalance.h"
+#include "BSTNodeAllocator.h"
+#include "FrozenBST.h"
 #include "ElementAlreadyExistsException.h"
 #include "ElementDoesNotExistException.h"
 #include "EmptyDataCollectionException.h"
 
 
-template <class ElementType>
+template <class ElementType, class Balance = AVLBalance, template <class> class NodeAllocator = NewNodeAllocator>
 class BST {
 	
 private:
@@ -28,27 +42,76 @@ private:
 	// You cannot change the following data members of this class.
 	BSTNode<ElementType>* root; 
     unsigned int elementCount;           
+	NodeAllocator< BSTNode<ElementType> > nodes;
 
     /* Utility methods */
 
 	// Feel free to add private methods to this class.
 	
-	// Description: Recursive insertion into a binary search tree.
-	//              Returns true when "anElement" has been successfully inserted into the 
-	//              binary search tree. Otherwise, returns false.
-    bool insertR(const ElementType& element, BSTNode<ElementType>* current); 
+	// Description: Returns the node holding "targetElement", or NULL if there is none.
+	// Time efficiency: O(log2 n)
+	BSTNode<ElementType>* findNode(const ElementType& targetElement) const;
 
-    // Description: Recursive retrieval from a binary search tree.
-	// Exception: Throws the exception "ElementDoesNotExistException" 
-	//            if "targetElement" is not found in the binary search tree.
-    ElementType& retrieveR(const ElementType& targetElement, BSTNode<ElementType>* current) const;
+	// Description: Returns the first node whose element is not smaller than
+	//              "element", or NULL if there is none.
+	// Time efficiency: O(log2 n)
+	BSTNode<ElementType>* lowerBoundNode(const ElementType& element) const;
+
+	// Description: Returns the number of elements not larger than "element".
+	// Time efficiency: O(log2 n)
+	unsigned int countUpTo(const ElementType& element) const;
+
+	static unsigned int sizeOf(const BSTNode<ElementType>* current) { return current == NULL ? 0 : current->size; }
+
+	// Description: Unlinks "node" from the binary search tree, lets the balancing 
+	//              policy repair the tree, and destroys it.
+	// Time efficiency: O(log2 n)
+	void removeNode(BSTNode<ElementType>* node);
+
+	// Description: Replaces the subtree rooted at "node" with the one rooted at
+	//              "replacement" (which may be NULL) in the eyes of node's parent.
+	void replaceChild(BSTNode<ElementType>* node, BSTNode<ElementType>* replacement);
+
+	// Description: Links the "count" nodes starting at "nodes", which are in order,
+	//              into a tree with every level full but the last, and returns its
+	//              root. "depth" is the depth of that root and "height" the height 
+	//              of the whole tree. Recurses only log2 n deep.
+	// Time efficiency: O(count)
+	static BSTNode<ElementType>* linkBalanced(BSTNode<ElementType>** nodes, unsigned int count, BSTNode<ElementType>* parent, 
+	                                          unsigned int depth, unsigned int height);
+
+	// Description: Returns the first (smallest) or last (largest) node of the
+	//              subtree rooted at "current", or NULL if it is empty.
+	static BSTNode<ElementType>* firstOf(BSTNode<ElementType>* current);
+	static BSTNode<ElementType>* lastOf(BSTNode<ElementType>* current);
+
+	// Description: Returns the node after (or before) "current" in order, or NULL
+	//              if there is none. Climbs the parent pointers when "current"
+	//              has no subtree on that side.
+	// Time efficiency: O(1) amortized over a full traversal
+	static BSTNode<ElementType>* successor(BSTNode<ElementType>* current);
+	static BSTNode<ElementType>* predecessor(BSTNode<ElementType>* current);
 
-	// Description: Recursive in order traversal of a binary search tree.	
-	void traverseInOrderR(void visit(const ElementType&), BSTNode<ElementType>* current) const;
+	// Description: Calls visit(element). Returns what visit returned, or "true" 
+	//              when visit returns nothing, so that forEach knows whether to go on.
+	template <class Function>
+	static bool visitElement(Function& visit, const ElementType& element, true_type) { visit(element); return true; }
+	template <class Function>
+	static bool visitElement(Function& visit, const ElementType& element, false_type) { return static_cast<bool>(visit(element)); }
 
-	void copyR(BSTNode<ElementType>* current);
+	// Description: Makes this (empty) binary search tree a copy of the subtree rooted at 
+	//              "source", node for node: same shape, ranks and sizes, no comparisons.
+	// Time efficiency: O(n)
+	void cloneFrom(const BSTNode<ElementType>* source);
+
+	// Description: Creates a node holding a copy of source's element, rank and size,
+	//              below "parent".
+	BSTNode<ElementType>* cloneNode(const BSTNode<ElementType>* source, BSTNode<ElementType>* parent);
+
+	// Description: Deletes every node of the subtree rooted at "current", 
+	//              children before parents, without recursion.
+	void destroy(BSTNode<ElementType>* current);
 
-	void destructorR(BSTNode<ElementType>* current);	 
 public:
 
 	// You cannot change the prototype of the public methods of this class.
@@ -56,11 +119,54 @@ public:
 	// - the one we will use to mark this assignment - will not know about them
 	// since we will use these public method prototypes to create our test driver.
 
+	// Bidirectional iterator over the elements, in order. It walks the 
+	// parent pointers, so it needs no stack. Elements cannot be modified 
+	// through it, since that could break the BST order.
+	// Valid until its element is removed from the binary search tree.
+	class Iterator {
+		friend class BST<ElementType, Balance, NodeAllocator>;
+		BSTNode<ElementType>* node;              // NULL at end()
+		const BST<ElementType, Balance, NodeAllocator>* tree;   // So that --end() can find the last element
+
+		Iterator(BSTNode<ElementType>* node, const BST<ElementType, Balance, NodeAllocator>* tree) : node(node), tree(tree) {}
+	public:
+		typedef bidirectional_iterator_tag iterator_category;
+		typedef ElementType value_type;
+		typedef ptrdiff_t difference_type;
+		typedef const ElementType* pointer;
+		typedef const ElementType& reference;
+
+		Iterator() : node(NULL), tree(NULL) {}
+		reference operator*() const { return node->element; }
+		pointer operator->() const { return &node->element; }
+		Iterator& operator++() { node = successor(node); return *this; }
+		Iterator operator++(int) { Iterator old = *this; node = successor(node); return old; }
+		Iterator& operator--() { node = node == NULL ? lastOf(tree->root) : predecessor(node); return *this; }
+		Iterator operator--(int) { Iterator old = *this; --*this; return old; }
+		bool operator==(const Iterator& rhs) const { return node == rhs.node; }
+		bool operator!=(const Iterator& rhs) const { return node != rhs.node; }
+	};
+	typedef Iterator iterator;
+	typedef Iterator const_iterator;
+
     /* Constructors and destructor */
 	BST();                               // Default constructor
     BST(ElementType& element);           // Parameterized constructor 
-	BST(const BST<ElementType>& aBST);   // Copy constructor 
+	BST(const BST<ElementType, Balance, NodeAllocator>& aBST);   // Copy constructor 
+	BST(BST<ElementType, Balance, NodeAllocator>&& aBST) noexcept;   // Move constructor
     ~BST();                              // Destructor 
+
+	/* Assignment operators */
+	BST<ElementType, Balance, NodeAllocator>& operator=(const BST<ElementType, Balance, NodeAllocator>& rhs);
+	BST<ElementType, Balance, NodeAllocator>& operator=(BST<ElementType, Balance, NodeAllocator>&& rhs) noexcept;
+
+    // Description: Returns a binary search tree holding the elements in [first, last),
+	//              with every level full but the last. The elements are only copied,
+	//              never compared.
+	// Precondition: [first, last) is in increasing order, without duplicates.
+	// Time efficiency: O(n)
+	template <class InputIterator>
+	static BST<ElementType, Balance, NodeAllocator> fromSorted(InputIterator first, InputIterator last);
 	
 	/* Getters and setters */
 	unsigned int getElementCount() const;
@@ -72,7 +178,6 @@ public:
     /* BST Operations */
 
     // Description: Inserts an element into the binary search tree.
-	//              This is a wrapper method which calls the recursive insertR( ).
 	// Precondition: "newElement" does not already exist in the binary search tree.
     // Exception: Throws the exception "ElementAlreadyExistsException" 
 	//            if "newElement" already exists in the binary search tree.
@@ -80,24 +185,118 @@ public:
 	void insert(const ElementType& newElement);	
 	
     // Description: Retrieves "targetElement" from the binary search tree.
-	//              This is a wrapper method which calls the recursive retrieveR( ).
 	// Precondition: Binary search tree is not empty.
     // Exception: Throws the exception "EmptyDataCollectionException" 
 	//            if the binary search tree is empty.
-	// Exception: Throws (propagates) the exception "ElementDoesNotExistException" 
-	//            thrown from the retrieveR(...)
+	// Exception: Throws the exception "ElementDoesNotExistException" 
 	//            if "targetElement" is not in the binary search tree.
 	// Time efficiency: O(log2 n)
 	ElementType& retrieve(const ElementType& targetElement) const;
+
+    // Description: Removes "targetElement" from the binary search tree. The balancing
+	//              policy keeps its height bound, and the node goes back to the
+	//              NodeAllocator. Iterators to other elements stay valid.
+    // Exception: Throws the exception "ElementDoesNotExistException" 
+	//            if "targetElement" is not in the binary search tree.
+	// Time efficiency: O(log2 n)
+	void remove(const ElementType& targetElement);
+
+    // Description: Removes every element for which pred(element) returns true, and 
+	//              returns how many were removed. Done in one pass: the remaining 
+	//              nodes are relinked, in order, into a tree with every level full 
+	//              but the last, whatever the balancing policy. The removed nodes
+	//              go back to the NodeAllocator together, through destroyAll().
+	//              If pred throws, the binary search tree is unchanged.
+	// Time efficiency: O(n)
+	template <class Predicate>
+	unsigned int removeIf(Predicate&& pred);
 	
     // Description: Traverses the binary search tree in order.
-	//              This is a wrapper method which calls the recursive traverseInOrderR( ).
 	//              The action to be done on each element during the traverse is the function "visit".
 	// Precondition: Binary search tree is not empty.
     // Exception: Throws the exception "EmptyDataCollectionException" 
 	//            if the binary search tree is empty.
 	// Time efficiency: O(n)	
 	void traverseInOrder(void visit(const ElementType&)) const;
+
+    // Description: Calls visit(element) on every element, in order. "visit" may be 
+	//              any callable, e.g. a lambda. If it returns a bool, returning
+	//              false stops the traversal there.
+	//              Returns "false" if the traversal was stopped, otherwise "true".
+	// Postcondition: The binary search tree is unchanged by this operation.
+	// Time efficiency: O(n), or O(k + log2 n) when stopped after k elements
+	template <class Function>
+	bool forEach(Function&& visit) const;
+
+	/* Range queries and order statistics */
+	// These use the size of every subtree, kept in its root node, and only 
+	// visit the nodes on one or two paths from the root (plus the elements
+	// they hand out). None of them has a precondition on the element count.
+
+    // Description: Returns an iterator to the smallest element not smaller than 
+	//              "element", or end() if there is none.
+	// Time efficiency: O(log2 n)
+	Iterator lowerBound(const ElementType& element) const;
+
+    // Description: Returns an iterator to the smallest element larger than 
+	//              "element", or end() if there is none.
+	// Time efficiency: O(log2 n)
+	Iterator upperBound(const ElementType& element) const;
+
+    // Description: Calls visit(element) on every element from "low" to "high", 
+	//              both included, in order. As with forEach, "visit" may return
+	//              false to stop there, and then rangeForEach returns "false".
+	// Time efficiency: O(log2 n + k) for the k elements visited
+	template <class Function>
+	bool rangeForEach(const ElementType& low, const ElementType& high, Function&& visit) const;
+
+    // Description: Returns the number of elements from "low" to "high", both included.
+	// Time efficiency: O(log2 n)
+	unsigned int countInRange(const ElementType& low, const ElementType& high) const;
+
+    // Description: Returns the number of elements smaller than "element": the position
+	//              "element" has, or would have, in order, counting from 0.
+	// Time efficiency: O(log2 n)
+	unsigned int rank(const ElementType& element) const;
+
+    // Description: Returns the element at position k in order, counting from 0,
+	//              so that select(0) is the smallest and rank(select(k)) == k.
+	// Precondition: k < getElementCount().
+    // Exception: Throws the exception "ElementDoesNotExistException" 
+	//            if k >= getElementCount().
+	// Time efficiency: O(log2 n)
+	const ElementType& select(unsigned int k) const;
+
+	/* Iterators */
+
+    // Description: Returns an iterator to the smallest element, or end() if 
+	//              the binary search tree is empty.
+	// Time efficiency: O(log2 n)
+	Iterator begin() const;
+
+    // Description: Returns the iterator past the largest element.
+	// Time efficiency: O(1)
+	Iterator end() const;
+
+	/* Snapshots */
+
+    // Description: Returns a read-only copy of the elements laid out in Eytzinger
+	//              order, whose searches are several times faster than retrieve()
+	//              on a large binary search tree. Later changes to the binary
+	//              search tree do not show in it.
+	// Postcondition: The binary search tree is unchanged by this operation.
+	// Time efficiency: O(n)
+	FrozenBST<ElementType> freeze() const;
+
+	/* Checks */
+
+    // Description: Returns "true" if the parent links, the subtree sizes, the BST
+	//              order and the element count agree with one another, and the
+	//              balancing policy's invariant holds, otherwise "false".
+	//              Meant for tests.
+	// Postcondition: The binary search tree is unchanged by this operation.
+	// Time efficiency: O(n)
+	bool isValid() const;
 	
 	
 }; // end BST
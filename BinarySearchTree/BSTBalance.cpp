@@ -0,0 +1,286 @@
+/*
+ * BSTBalance.cpp
+ *
+ * Description: Balancing policies for the Binary Search Tree data collection ADT class.
+ *
+ * Author: Amanda Ngo
+ * Date of last modification: March 2022
+ *
+ */
+
+#include "BSTBalance.h"
+
+/* Rotations */
+
+	// Description: Moves node's right child up into node's place and returns it.
+	template <class Node>
+	Node* BSTRotations::rotateLeft(Node* node, Node*& root) {
+		Node* child = node->right;
+		node->right = child->left;
+		if (child->left != NULL)
+			child->left->parent = node;
+		child->parent = node->parent;
+		if (node->parent == NULL)
+			root = child;
+		else if (node->parent->left == node)
+			node->parent->left = child;
+		else
+			node->parent->right = child;
+		child->left = node;
+		node->parent = child;
+		child->size = node->size;
+		node->size = 1 + sizeOf(node->left) + sizeOf(node->right);
+		return child;
+	}
+
+	// Description: Moves node's left child up into node's place and returns it.
+	template <class Node>
+	Node* BSTRotations::rotateRight(Node* node, Node*& root) {
+		Node* child = node->left;
+		node->left = child->right;
+		if (child->right != NULL)
+			child->right->parent = node;
+		child->parent = node->parent;
+		if (node->parent == NULL)
+			root = child;
+		else if (node->parent->left == node)
+			node->parent->left = child;
+		else
+			node->parent->right = child;
+		child->right = node;
+		node->parent = child;
+		child->size = node->size;
+		node->size = 1 + sizeOf(node->left) + sizeOf(node->right);
+		return child;
+	}
+
+/* AVL */
+
+	// Description: Restores the AVL property after the leaf "node" has been linked in.
+	//              Walks up updating heights; stops at the first subtree whose
+	//              height did not change, which is always the case after a rotation.
+	template <class Node>
+	void AVLBalance::inserted(Node* node, Node*& root) {
+		node->rank = 1;
+		for (Node* current = node->parent; current != NULL; current = current->parent) {
+			unsigned char oldHeight = current->rank;
+			current = rebalance(current, root);
+			if (current->rank == oldHeight)
+				break;
+		}
+	}
+
+	// Description: Restores the AVL property after a node has been unlinked.
+	//              Walks up from "parent" rebalancing; stops at the first subtree
+	//              whose height did not change. Unlike insertion, a rotation
+	//              can shorten its subtree, so the walk may go on past it.
+	template <class Node>
+	void AVLBalance::removed(Node*, Node* parent, unsigned char, Node*& root) {
+		for (Node* current = parent; current != NULL; current = current->parent) {
+			unsigned char oldHeight = current->rank;
+			current = rebalance(current, root);
+			if (current->rank == oldHeight)
+				break;
+		}
+	}
+
+	// Description: Sets the height of "node" in a tree built balanced.
+	template <class Node>
+	void AVLBalance::built(Node* node, unsigned int, unsigned int) {
+		updateHeight(node);
+	}
+
+	template <class Node>
+	void AVLBalance::updateHeight(Node* node) {
+		unsigned char leftHeight = heightOf(node->left);
+		unsigned char rightHeight = heightOf(node->right);
+		node->rank = (leftHeight > rightHeight ? leftHeight : rightHeight) + 1;
+	}
+
+	// Utility method - Rotates node's subtree back into balance if its subtrees
+	//                  differ in height by 2, updates its height, and returns
+	//                  the node now at the top of the subtree.
+	template <class Node>
+	Node* AVLBalance::rebalance(Node* node, Node*& root) {
+		int balance = (int)heightOf(node->left) - (int)heightOf(node->right);
+		if (balance > 1) {
+			// Left-right case: first turn it into a left-left case
+			if (heightOf(node->left->left) < heightOf(node->left->right)) {
+				rotateLeft(node->left, root);
+				updateHeight(node->left->left);
+			}
+			node = rotateRight(node, root);
+			updateHeight(node->right);
+			updateHeight(node->left);
+		}
+		else if (balance < -1) {
+			// Right-left case: first turn it into a right-right case
+			if (heightOf(node->right->right) < heightOf(node->right->left)) {
+				rotateRight(node->right, root);
+				updateHeight(node->right->right);
+			}
+			node = rotateLeft(node, root);
+			updateHeight(node->left);
+			updateHeight(node->right);
+		}
+		updateHeight(node);
+		return node;
+	}
+
+	// Utility method - Returns the height of the subtree rooted at node, or -1
+	//                  if the AVL property fails anywhere in it.
+	template <class Node>
+	int AVLBalance::checkedHeight(const Node* node) {
+		if (node == NULL)
+			return 0;
+		int leftHeight = checkedHeight(node->left);
+		int rightHeight = checkedHeight(node->right);
+		if (leftHeight < 0 || rightHeight < 0 || leftHeight - rightHeight > 1 || rightHeight - leftHeight > 1)
+			return -1;
+		int height = (leftHeight > rightHeight ? leftHeight : rightHeight) + 1;
+		return node->rank == height ? height : -1;
+	}
+
+/* Red-black */
+
+	// Description: Restores the red-black properties after the leaf "node" has been linked in.
+	//              A new node is red; while its parent is red too, either both the
+	//              parent and the uncle are red and the colours move up to the
+	//              grandparent, or one or two rotations end the repair.
+	template <class Node>
+	void RedBlackBalance::inserted(Node* node, Node*& root) {
+		node->rank = RED;
+		while (isRed(node->parent)) {
+			Node* parent = node->parent;
+			Node* grandparent = parent->parent;    // Exists, since the root is black
+			if (parent == grandparent->left) {
+				Node* uncle = grandparent->right;
+				if (isRed(uncle)) {
+					parent->rank = BLACK;
+					uncle->rank = BLACK;
+					grandparent->rank = RED;
+					node = grandparent;
+					continue;
+				}
+				if (node == parent->right) {
+					rotateLeft(parent, root);
+					parent = node;
+				}
+				parent->rank = BLACK;
+				grandparent->rank = RED;
+				rotateRight(grandparent, root);
+			}
+			else {
+				Node* uncle = grandparent->left;
+				if (isRed(uncle)) {
+					parent->rank = BLACK;
+					uncle->rank = BLACK;
+					grandparent->rank = RED;
+					node = grandparent;
+					continue;
+				}
+				if (node == parent->left) {
+					rotateRight(parent, root);
+					parent = node;
+				}
+				parent->rank = BLACK;
+				grandparent->rank = RED;
+				rotateLeft(grandparent, root);
+			}
+			break;
+		}
+		root->rank = BLACK;
+	}
+
+	// Description: Restores the red-black properties after a node of colour
+	//              "removedRank" has been unlinked. Removing a black node leaves
+	//              "child" one black short; while it is black, either its sibling's
+	//              side gives up a black too and the shortage moves up to the parent,
+	//              or one to three rotations end the repair.
+	template <class Node>
+	void RedBlackBalance::removed(Node* child, Node* parent, unsigned char removedRank, Node*& root) {
+		if (removedRank == RED)
+			return;
+		while (child != root && !isRed(child)) {
+			if (child == parent->left) {
+				Node* sibling = parent->right;       // Not NULL: its side has a black to spare
+				if (isRed(sibling)) {
+					sibling->rank = BLACK;
+					parent->rank = RED;
+					rotateLeft(parent, root);
+					sibling = parent->right;
+				}
+				if (!isRed(sibling->left) && !isRed(sibling->right)) {
+					sibling->rank = RED;
+					child = parent;
+					parent = child->parent;
+					continue;
+				}
+				if (!isRed(sibling->right)) {
+					sibling->left->rank = BLACK;
+					sibling->rank = RED;
+					rotateRight(sibling, root);
+					sibling = parent->right;
+				}
+				sibling->rank = parent->rank;
+				parent->rank = BLACK;
+				sibling->right->rank = BLACK;
+				rotateLeft(parent, root);
+			}
+			else {
+				Node* sibling = parent->left;
+				if (isRed(sibling)) {
+					sibling->rank = BLACK;
+					parent->rank = RED;
+					rotateRight(parent, root);
+					sibling = parent->left;
+				}
+				if (!isRed(sibling->left) && !isRed(sibling->right)) {
+					sibling->rank = RED;
+					child = parent;
+					parent = child->parent;
+					continue;
+				}
+				if (!isRed(sibling->left)) {
+					sibling->right->rank = BLACK;
+					sibling->rank = RED;
+					rotateLeft(sibling, root);
+					sibling = parent->left;
+				}
+				sibling->rank = parent->rank;
+				parent->rank = BLACK;
+				sibling->left->rank = BLACK;
+				rotateRight(parent, root);
+			}
+			child = root;
+		}
+		if (child != NULL)
+			child->rank = BLACK;
+	}
+
+	// Description: Colours "node" in a tree built with every level full but the last.
+	//              Every path then has the same number of black nodes, and the
+	//              red ones, all on the last level, have no children.
+	template <class Node>
+	void RedBlackBalance::built(Node* node, unsigned int depth, unsigned int height) {
+		node->rank = depth > 0 && depth + 1 == height ? RED : BLACK;
+	}
+
+	// Utility method - Returns the number of black nodes on every path down from
+	//                  node, or -1 if the red-black properties fail anywhere below it.
+	template <class Node>
+	int RedBlackBalance::checkedBlackHeight(const Node* node) {
+		if (node == NULL)
+			return 0;
+		if (node->rank != RED && node->rank != BLACK)
+			return -1;
+		if (isRed(node) && (isRed(node->left) || isRed(node->right)))
+			return -1;
+		int leftHeight = checkedBlackHeight(node->left);
+		int rightHeight = checkedBlackHeight(node->right);
+		if (leftHeight < 0 || leftHeight != rightHeight)
+			return -1;
+		return leftHeight + (isRed(node) ? 0 : 1);
+	}
+
+//  End of implementation file.
\ No newline at end of file
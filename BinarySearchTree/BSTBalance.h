@@ -0,0 +1,141 @@
+/*
+ * BSTBalance.h
+ *
+ * Description: Balancing policies for the Binary Search Tree data collection ADT class.
+ *              A policy is given every node the BST links in and every spot
+ *              a node is unlinked from, and may rotate the tree to keep its
+ *              height in O(log2 n). It keeps whatever it needs in the "rank"
+ *              field of the nodes, and sets it on trees the BST builds
+ *              already balanced.
+ *                - NoBalance:       nodes stay where they are inserted (sorted
+ *                                   input builds a linked list).
+ *                - AVLBalance:      rank is the height of the node's subtree;
+ *                                   sibling subtrees differ in height by at most 1.
+ *                                   Height <= 1.44 log2 n, the best for lookups.
+ *                - RedBlackBalance: rank is the node's colour. Height <= 2 log2 n,
+ *                                   at most 2 rotations per insertion and 3
+ *                                   per removal.
+ *
+ * Author: Amanda Ngo
+ * Date of last modification: March 2022
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+
+using namespace std;
+
+// Rotations shared by the balancing policies. Both keep the in order
+// sequence of the tree and fix the parent pointers, the subtree sizes
+// and the root.
+struct BSTRotations {
+	// Description: Moves node's right child up into node's place and returns it.
+	template <class Node>
+	static Node* rotateLeft(Node* node, Node*& root);
+
+	// Description: Moves node's left child up into node's place and returns it.
+	template <class Node>
+	static Node* rotateRight(Node* node, Node*& root);
+
+private:
+	template <class Node>
+	static unsigned int sizeOf(const Node* node) { return node == NULL ? 0 : node->size; }
+};
+
+// The tree is left as inserted.
+struct NoBalance {
+	template <class Node>
+	static void inserted(Node*, Node*&) {}
+	template <class Node>
+	static void removed(Node*, Node*, unsigned char, Node*&) {}
+	template <class Node>
+	static void built(Node*, unsigned int, unsigned int) {}
+	template <class Node>
+	static bool isValid(const Node*) { return true; }
+};
+
+// AVL tree: the heights of the two subtrees of every node differ by at most 1.
+struct AVLBalance : BSTRotations {
+	// Description: Restores the AVL property after the leaf "node" has been linked in.
+	// Time Efficiency: O(log2 n), with at most 2 rotations
+	template <class Node>
+	static void inserted(Node* node, Node*& root);
+
+	// Description: Restores the AVL property after a node has been unlinked.
+	//              "child" took its spot below "parent"; both may be NULL.
+	// Time Efficiency: O(log2 n), with O(log2 n) rotations at worst
+	template <class Node>
+	static void removed(Node* child, Node* parent, unsigned char removedRank, Node*& root);
+
+	// Description: Sets the height of "node" in a tree built balanced,
+	//              once the heights of its children are set.
+	template <class Node>
+	static void built(Node* node, unsigned int depth, unsigned int height);
+
+	// Description: Returns "true" if every rank is the height of its subtree and
+	//              sibling subtrees differ in height by at most 1. For checks.
+	// Time Efficiency: O(n)
+	template <class Node>
+	static bool isValid(const Node* root) { return checkedHeight(root) >= 0; }
+
+private:
+	template <class Node>
+	static unsigned char heightOf(const Node* node) { return node == NULL ? 0 : node->rank; }
+
+	// Utility method - Returns the height of the subtree rooted at node, or -1
+	//                  if the AVL property fails anywhere in it.
+	template <class Node>
+	static int checkedHeight(const Node* node);
+
+	template <class Node>
+	static void updateHeight(Node* node);
+
+	// Utility method - Rotates node's subtree back into balance if its subtrees
+	//                  differ in height by 2, updates its height, and returns
+	//                  the node now at the top of the subtree.
+	template <class Node>
+	static Node* rebalance(Node* node, Node*& root);
+};
+
+// Red-black tree: no red node has a red child, and every path from a node
+// down to a NULL child goes through the same number of black nodes.
+struct RedBlackBalance : BSTRotations {
+	static const unsigned char RED = 0;
+	static const unsigned char BLACK = 1;
+
+	// Description: Restores the red-black properties after the leaf "node" has been linked in.
+	// Time Efficiency: O(log2 n) recolourings, with at most 2 rotations
+	template <class Node>
+	static void inserted(Node* node, Node*& root);
+
+	// Description: Restores the red-black properties after a node of colour
+	//              "removedRank" has been unlinked. "child" took its spot below
+	//              "parent"; both may be NULL.
+	// Time Efficiency: O(log2 n) recolourings, with at most 3 rotations
+	template <class Node>
+	static void removed(Node* child, Node* parent, unsigned char removedRank, Node*& root);
+
+	// Description: Colours "node" in a tree built with every level full but
+	//              the last: the nodes of that level are red, the others black.
+	template <class Node>
+	static void built(Node* node, unsigned int depth, unsigned int height);
+
+	// Description: Returns "true" if the root is black, no red node has a red child
+	//              and every path down has the same number of black nodes. For checks.
+	// Time Efficiency: O(n)
+	template <class Node>
+	static bool isValid(const Node* root) { return !isRed(root) && checkedBlackHeight(root) >= 0; }
+
+private:
+	template <class Node>
+	static bool isRed(const Node* node) { return node != NULL && node->rank == RED; }
+
+	// Utility method - Returns the number of black nodes on every path down from
+	//                  node, or -1 if the red-black properties fail anywhere below it.
+	template <class Node>
+	static int checkedBlackHeight(const Node* node);
+};
+
+#include "BSTBalance.cpp"
@@ -0,0 +1,317 @@
+/*
+ * BSTBenchmark.cpp
+ *
+ * Description: Benchmark driver for the Binary Search Tree.
+ *              Usage: ./bstbench [section] [n]
+ *              section is one of the names below, or "all" (the default);
+ *              n is the number of elements (1000000 by default).
+ *              "make bench" builds it with optimizations and runs it.
+ *
+ *              balance   n inserts in increasing, decreasing and random order,
+ *                        then n successful retrieves in random order, for
+ *                        AVLBalance, RedBlackBalance and NoBalance. Sorted
+ *                        input makes an unbalanced tree a linked list, so
+ *                        NoBalance only gets min(n, 20000) elements there.
+ *              allocator NewNodeAllocator against PooledNodeAllocator (AVL, int
+ *                        keys), in random and increasing order: n inserts, n
+ *                        retrieves, a forEach scan and the destruction, and
+ *                        how much the resident set grew while the tree was
+ *                        built (from /proc/self/statm; 0 where there is none).
+ *                        Each row runs in a child process of its own, so that
+ *                        no row reuses memory freed by the one before.
+ *              frozen    freeze() of an AVL tree of n random keys, then n
+ *                        searches for random keys, half of them present: BST
+ *                        lowerBound against FrozenBST contains (one at a time
+ *                        and batched) and lowerBound. The batch uses AVX2 for
+ *                        32-bit keys when built with it ("make bench" builds
+ *                        with -march=native).
+              scan      An in-order pass over an AVL tree of n random keys:
+                        begin()/end() iterators forwards and backwards,
+                        forEach, traverseInOrder, and a std::set iterated
+                        over the same keys.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <set>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "BST.h"
+
+using namespace std;
+
+// Utility function - Milliseconds since "start".
+static double millisecondsSince(chrono::steady_clock::time_point start) {
+	return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Utility function - Returns the n distinct keys 0, 2, 4, ... in random order.
+static vector<int> shuffledKeys(unsigned int n, unsigned int seed) {
+	vector<int> keys(n);
+	for (unsigned int i = 0; i < n; i++)
+		keys[i] = 2 * i;
+	shuffle(keys.begin(), keys.end(), mt19937(seed));
+	return keys;
+}
+
+// Keeps the compiler from dropping work whose result is never used.
+static unsigned long long checksum = 0;
+
+// Utility function - Times inserting "keys" in the given order, then retrieving
+//                    every key in random order, and prints one row.
+template <class Balance>
+static void benchBalanceRow(const char* name, const vector<int>& keys, const vector<int>& lookups) {
+	BST<int, Balance> tree;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (unsigned int i = 0; i < keys.size(); i++)
+		tree.insert(keys[i]);
+	double insert = millisecondsSince(start);
+
+	start = chrono::steady_clock::now();
+	for (unsigned int i = 0; i < lookups.size(); i++)
+		checksum += tree.retrieve(lookups[i]);
+	printf("  %-16s %8u %10.1f ms %10.1f ms\n", name, (unsigned int)keys.size(), insert, millisecondsSince(start));
+}
+
+// Utility function - Runs every balancing policy on the first n of "keys",
+//                    NoBalance on at most "unbalancedLimit" of them.
+static void benchBalanceOrder(const char* order, vector<int> keys, unsigned int unbalancedLimit) {
+	printf("balance: %s inserts\n  %-16s %8s %13s %13s\n", order, "policy", "n", "insert", "retrieve");
+	vector<int> lookups = keys;
+	shuffle(lookups.begin(), lookups.end(), mt19937(7));
+	benchBalanceRow<AVLBalance>("AVLBalance", keys, lookups);
+	benchBalanceRow<RedBlackBalance>("RedBlackBalance", keys, lookups);
+
+	if (keys.size() > unbalancedLimit) {
+		keys.resize(unbalancedLimit);
+		lookups = keys;
+		shuffle(lookups.begin(), lookups.end(), mt19937(7));
+	}
+	benchBalanceRow<NoBalance>("NoBalance", keys, lookups);
+}
+
+static void benchBalance(unsigned int n) {
+	vector<int> keys = shuffledKeys(n, 1);
+	benchBalanceOrder("random", keys, n);
+
+	sort(keys.begin(), keys.end());
+	unsigned int limit = n < 20000 ? n : 20000;
+	benchBalanceOrder("increasing", keys, limit);
+
+	reverse(keys.begin(), keys.end());
+	benchBalanceOrder("decreasing", keys, limit);
+}
+
+// Utility function - Returns the resident set size in bytes, or 0 if unknown.
+static unsigned long long residentBytes() {
+	unsigned long long pages = 0, resident = 0;
+	FILE* statm = fopen("/proc/self/statm", "r");
+	if (statm == NULL)
+		return 0;
+	if (fscanf(statm, "%llu %llu", &pages, &resident) != 2)
+		resident = 0;
+	fclose(statm);
+	return resident * sysconf(_SC_PAGESIZE);
+}
+
+// Utility function - Times each stage of a tree's life with NodeAllocator,
+//                    and prints one row.
+template <template <class> class NodeAllocator>
+static void benchAllocatorRow(const char* name, const vector<int>& keys, const vector<int>& lookups) {
+	double insert, retrieve, scan, destroy;
+	long long grown;
+	{
+		unsigned long long before = residentBytes();
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		BST<int, AVLBalance, NodeAllocator>* tree = new BST<int, AVLBalance, NodeAllocator>();
+		for (unsigned int i = 0; i < keys.size(); i++)
+			tree->insert(keys[i]);
+		insert = millisecondsSince(start);
+		grown = (long long)residentBytes() - (long long)before;
+
+		start = chrono::steady_clock::now();
+		for (unsigned int i = 0; i < lookups.size(); i++)
+			checksum += tree->retrieve(lookups[i]);
+		retrieve = millisecondsSince(start);
+
+		start = chrono::steady_clock::now();
+		tree->forEach([](int element) { checksum += element; });
+		scan = millisecondsSince(start);
+
+		start = chrono::steady_clock::now();
+		delete tree;
+		destroy = millisecondsSince(start);
+	}
+	printf("  %-8s %10.1f ms %10.1f ms %8.1f ms %8.1f ms %8.1f MiB\n", name, insert, retrieve, scan, destroy, grown / 1048576.0);
+}
+
+// Utility function - Runs benchAllocatorRow in a child process with a fresh heap.
+template <template <class> class NodeAllocator>
+static void benchAllocatorInChild(const char* name, const vector<int>& keys, const vector<int>& lookups) {
+	fflush(stdout);
+	pid_t child = fork();
+	if (child == 0) {
+		benchAllocatorRow<NodeAllocator>(name, keys, lookups);
+		fflush(stdout);
+		_exit(0);
+	}
+	if (child < 0)
+		benchAllocatorRow<NodeAllocator>(name, keys, lookups);
+	else
+		waitpid(child, NULL, 0);
+}
+
+static void benchAllocatorOrder(const char* order, const vector<int>& keys) {
+	vector<int> lookups = keys;
+	shuffle(lookups.begin(), lookups.end(), mt19937(7));
+	printf("allocator: n = %u, %s inserts\n  %-8s %13s %13s %11s %11s %12s\n", (unsigned int)keys.size(), order,
+	       "nodes", "insert", "retrieve", "scan", "destroy", "RSS growth");
+	benchAllocatorInChild<NewNodeAllocator>("new", keys, lookups);
+	benchAllocatorInChild<PooledNodeAllocator>("pooled", keys, lookups);
+}
+
+static void benchAllocator(unsigned int n) {
+	vector<int> keys = shuffledKeys(n, 2);
+	benchAllocatorOrder("random", keys);
+	sort(keys.begin(), keys.end());
+	benchAllocatorOrder("increasing", keys);
+}
+
+// Utility function - Prints one row of the frozen section.
+static void printSearchRow(const char* name, double milliseconds, unsigned int searches, unsigned int found) {
+	printf("  %-24s %10.1f ms %8.1f ns %10u\n", name, milliseconds, milliseconds * 1e6 / searches, found);
+}
+
+static void benchFrozen(unsigned int n) {
+	vector<int> keys = shuffledKeys(n, 3);
+	BST<int> tree;
+	for (unsigned int i = 0; i < n; i++)
+		tree.insert(keys[i]);
+	mt19937 random(4);
+	vector<int> probes(n);
+	for (unsigned int i = 0; i < n; i++)
+		probes[i] = random() % (2 * n);
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	FrozenBST<int> frozen = tree.freeze();
+	printf("frozen: n = %u, freeze() %.1f ms\n  %-24s %13s %11s %10s\n", n, millisecondsSince(start),
+	       "search", "total", "each", "found");
+
+	unsigned int found = 0;
+	start = chrono::steady_clock::now();
+	for (unsigned int i = 0; i < n; i++) {
+		BST<int>::Iterator bound = tree.lowerBound(probes[i]);
+		found += bound != tree.end() && *bound == probes[i];
+	}
+	printSearchRow("BST lowerBound", millisecondsSince(start), n, found);
+
+	found = 0;
+	start = chrono::steady_clock::now();
+	for (unsigned int i = 0; i < n; i++)
+		found += frozen.contains(probes[i]);
+	printSearchRow("FrozenBST contains", millisecondsSince(start), n, found);
+
+	bool* results = new bool[n];
+	found = 0;
+	start = chrono::steady_clock::now();
+	frozen.contains(probes.data(), n, results);
+	double batch = millisecondsSince(start);
+	for (unsigned int i = 0; i < n; i++)
+		found += results[i];
+	delete[] results;
+	printSearchRow("FrozenBST batch contains", batch, n, found);
+
+	found = 0;
+	start = chrono::steady_clock::now();
+	for (unsigned int i = 0; i < n; i++) {
+		FrozenBST<int>::Iterator bound = frozen.lowerBound(probes[i]);
+		found += bound != frozen.end() && *bound == probes[i];
+	}
+	printSearchRow("FrozenBST lowerBound", millisecondsSince(start), n, found);
+	checksum += found;
+}
+
+// Utility function - traverseInOrder's visit, which only takes a function.
+static void addToChecksum(const int& element) {
+	checksum += element;
+}
+
+static void printScanRow(const char* name, double milliseconds, unsigned int n) {
+	printf("  %-24s %10.1f ms %8.2f ns\n", name, milliseconds, milliseconds * 1e6 / n);
+}
+
+static void benchScan(unsigned int n) {
+	vector<int> keys = shuffledKeys(n, 5);
+	BST<int, AVLBalance> tree;
+	set<int> reference;
+	for (unsigned int i = 0; i < n; i++) {
+		tree.insert(keys[i]);
+		reference.insert(keys[i]);
+	}
+	printf("scan: n = %u random inserts\n  %-24s %13s %11s\n", n, "scan", "total", "each");
+
+	unsigned long long sum = 0;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (BST<int, AVLBalance>::Iterator element = tree.begin(); element != tree.end(); ++element)
+		sum += *element;
+	printScanRow("BST iterator", millisecondsSince(start), n);
+
+	start = chrono::steady_clock::now();
+	for (BST<int, AVLBalance>::Iterator element = tree.end(); element != tree.begin(); )
+		sum += *--element;
+	printScanRow("BST iterator, backwards", millisecondsSince(start), n);
+
+	start = chrono::steady_clock::now();
+	tree.forEach([&](int element) { sum += element; });
+	printScanRow("BST forEach", millisecondsSince(start), n);
+
+	start = chrono::steady_clock::now();
+	tree.traverseInOrder(addToChecksum);
+	printScanRow("BST traverseInOrder", millisecondsSince(start), n);
+
+	start = chrono::steady_clock::now();
+	for (set<int>::const_iterator element = reference.begin(); element != reference.end(); ++element)
+		sum += *element;
+	printScanRow("std::set iterator", millisecondsSince(start), n);
+	checksum += sum;
+}
+
+int main(int argc, char** argv) {
+	const char* section = argc > 1 ? argv[1] : "all";
+	unsigned int n = argc > 2 ? strtoul(argv[2], NULL, 10) : 1000000;
+	bool all = strcmp(section, "all") == 0;
+	bool ran = false;
+
+	if (all || strcmp(section, "balance") == 0) {
+		benchBalance(n);
+		ran = true;
+	}
+	if (all || strcmp(section, "allocator") == 0) {
+		benchAllocator(n);
+		ran = true;
+	}
+	if (all || strcmp(section, "frozen") == 0) {
+		benchFrozen(n);
+		ran = true;
+	}
+	if (all || strcmp(section, "scan") == 0) {
+		benchScan(n);
+		ran = true;
+	}
+	if (!ran) {
+		printf("Unknown section \"%s\".\n", section);
+		return 1;
+	}
+	printf("(checksum %llu)\n", checksum);
+	return 0;
+}
@@ -0,0 +1,482 @@
+/*
+ * BSTCheck.cpp
+ *
+ * Description: Randomized checks of the Binary Search Tree. Random inserts
+ *              and removes (duplicates and missing elements included) run
+ *              next to a std::set, for every balancing policy; after each
+ *              step the tree must pass isValid() (parent links, subtree sizes,
+ *              order, and the AVL or red-black invariants) and hold what the
+ *              set holds. Both node allocators are covered, and elements
+ *              count their live copies, so that a leaked or doubly destroyed
+ *              node shows. Iterators must walk the set's order forwards and
+              backwards (from --end() too), and forEach must stop at the
+              first false it gets. lowerBound, upperBound, rangeForEach and
+              countInRange must agree with the set for bounds below, inside
+              and above the elements, and for low > high. fromSorted must
+              build a valid tree of every size up to 300, and moves and copies
+              (of empty trees too) must leave both trees valid. FrozenBST snapshots are checked against a set
+ *              too: iteration, lowerBound, retrieve and batch contains. Built
+ *              with AddressSanitizer and UndefinedBehaviorSanitizer by "make
+ *              check", which also runs it twice: with -march=native, for the
+ *              AVX2 batch searches, and without.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include "BST.h"
+
+using namespace std;
+
+// Stops the run with the failed condition and its line.
+#define CHECK(condition) \
+	do { if (!(condition)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); exit(1); } } while (0)
+
+// Utility function - Checks that tree holds exactly the elements of reference,
+//                    in order, and that rank() and select() agree with it.
+template <class Tree>
+static void checkSame(const Tree& tree, const set<int>& reference) {
+	CHECK(tree.isValid());
+	CHECK(tree.getElementCount() == reference.size());
+	unsigned int position = 0;
+	typename Tree::Iterator element = tree.begin();
+	for (set<int>::const_iterator expected = reference.begin(); expected != reference.end(); ++expected, ++element, position++) {
+		CHECK(element != tree.end() && *element == *expected);
+		CHECK(tree.rank(*expected) == position);
+		CHECK(tree.select(position) == *expected);
+	}
+	CHECK(element == tree.end());
+}
+
+// Random inserts and removes on a BST<int, Balance, NodeAllocator>, against a set.
+template <class Balance, template <class> class NodeAllocator>
+static void checkBalance(mt19937& random) {
+	for (unsigned int round = 0; round < 30; round++) {
+		BST<int, Balance, NodeAllocator> tree;
+		set<int> reference;
+		unsigned int range = 1 + random() % 2000;
+		for (unsigned int step = 0; step < 2000; step++) {
+			int element = random() % range;
+			if (random() % 3 != 0) {
+				bool exists = reference.count(element) > 0;
+				try { tree.insert(element); CHECK(!exists); } catch (ElementAlreadyExistsException&) { CHECK(exists); }
+				reference.insert(element);
+			}
+			else {
+				bool exists = reference.count(element) > 0;
+				try { tree.remove(element); CHECK(exists); } catch (ElementDoesNotExistException&) { CHECK(!exists); }
+				reference.erase(element);
+			}
+			CHECK(tree.isValid());
+			CHECK(tree.getElementCount() == reference.size());
+		}
+		checkSame(tree, reference);
+
+		BST<int, Balance, NodeAllocator> copy(tree);
+		checkSame(copy, reference);
+	}
+
+	// Sorted and reverse sorted input, the worst case for an unbalanced tree
+	BST<int, Balance, NodeAllocator> increasing;
+	BST<int, Balance, NodeAllocator> decreasing;
+	set<int> reference;
+	for (int i = 0; i < 3000; i++) {
+		increasing.insert(i);
+		decreasing.insert(2999 - i);
+		reference.insert(i);
+	}
+	checkSame(increasing, reference);
+	checkSame(decreasing, reference);
+	for (int i = 0; i < 3000; i += 2) {
+		increasing.remove(i);
+		decreasing.remove(i);
+		reference.erase(i);
+	}
+	checkSame(increasing, reference);
+	checkSame(decreasing, reference);
+}
+
+// Iterators in both directions, and forEach stopped early, against a set.
+template <class Balance>
+static void checkIteration(mt19937& random) {
+	BST<int, Balance> empty;
+	CHECK(empty.begin() == empty.end());
+	CHECK(empty.forEach([](int) { return false; }));
+
+	for (unsigned int round = 0; round < 20; round++) {
+		BST<int, Balance> tree;
+		set<int> reference;
+		unsigned int count = 1 + random() % 500;
+		while (reference.size() < count) {
+			int element = random() % 5000;
+			if (reference.insert(element).second)
+				tree.insert(element);
+		}
+
+		// --end() is the largest element, and walking back reaches begin()
+		typename BST<int, Balance>::Iterator last = tree.end();
+		--last;
+		CHECK(*last == *reference.rbegin());
+		vector<int> backwards;
+		for (typename BST<int, Balance>::Iterator element = tree.end(); element != tree.begin(); )
+			backwards.push_back(*--element);
+		CHECK(backwards == vector<int>(reference.rbegin(), reference.rend()));
+		typename BST<int, Balance>::Iterator element = tree.end();
+		CHECK(element-- == tree.end());
+		CHECK(element == last && element++ == last);
+		CHECK(element == tree.end());
+
+		// Forwards then back again from the middle
+		typename BST<int, Balance>::Iterator middle = tree.begin();
+		set<int>::const_iterator expected = reference.begin();
+		for (unsigned int i = 0; i < count / 2; i++, ++middle, ++expected) {}
+		CHECK(*middle == *expected);
+		if (expected != reference.begin())
+			CHECK(*--middle == *--expected);
+
+		// forEach stops at the first false, and says so
+		unsigned int stopAfter = random() % (count + 1);
+		vector<int> visited;
+		bool finished = tree.forEach([&](int element) {
+			if (visited.size() == stopAfter)
+				return false;
+			visited.push_back(element);
+			return true;
+		});
+		CHECK(finished == (stopAfter == count));
+		CHECK(visited == vector<int>(reference.begin(), next(reference.begin(), stopAfter)));
+		visited.clear();
+		CHECK(tree.forEach([&](int element) { visited.push_back(element); }));
+		CHECK(visited == vector<int>(reference.begin(), reference.end()));
+	}
+}
+
+// Utility function - The elements of reference from low to high, both included.
+static vector<int> inRange(const set<int>& reference, int low, int high) {
+	if (low > high)
+		return vector<int>();
+	return vector<int>(reference.lower_bound(low), reference.upper_bound(high));
+}
+
+// lowerBound, upperBound, rangeForEach and countInRange against a set, with
+// bounds below, inside and above the elements, and low > high.
+template <class Balance>
+static void checkRanges(mt19937& random) {
+	for (unsigned int round = 0; round < 30; round++) {
+		BST<int, Balance> tree;
+		set<int> reference;
+		unsigned int count = round == 0 ? 0 : random() % 400;
+		while (reference.size() < count) {
+			int element = random() % 2000;
+			if (reference.insert(element).second)
+				tree.insert(element);
+		}
+
+		for (unsigned int probe = 0; probe < 300; probe++) {
+			int element = (int)(random() % 2200) - 100;
+			typename BST<int, Balance>::Iterator lower = tree.lowerBound(element);
+			set<int>::const_iterator expectedLower = reference.lower_bound(element);
+			CHECK(expectedLower == reference.end() ? lower == tree.end() : lower != tree.end() && *lower == *expectedLower);
+			typename BST<int, Balance>::Iterator upper = tree.upperBound(element);
+			set<int>::const_iterator expectedUpper = reference.upper_bound(element);
+			CHECK(expectedUpper == reference.end() ? upper == tree.end() : upper != tree.end() && *upper == *expectedUpper);
+
+			int low = (int)(random() % 2200) - 100;
+			int high = random() % 4 == 0 ? low - 1 - (int)(random() % 50) : low + (int)(random() % 600);
+			vector<int> expected = inRange(reference, low, high);
+			vector<int> visited;
+			CHECK(tree.rangeForEach(low, high, [&](int element) { visited.push_back(element); }));
+			CHECK(visited == expected);
+			CHECK(tree.countInRange(low, high) == expected.size());
+
+			// Stopped before the end of the range
+			if (!expected.empty()) {
+				unsigned int stopAfter = random() % expected.size();
+				visited.clear();
+				CHECK(!tree.rangeForEach(low, high, [&](int element) {
+					if (visited.size() == stopAfter)
+						return false;
+					visited.push_back(element);
+					return true;
+				}));
+				CHECK(visited == vector<int>(expected.begin(), expected.begin() + stopAfter));
+			}
+		}
+
+		// The whole tree, and nothing at all
+		CHECK(tree.countInRange(INT_MIN, INT_MAX) == reference.size());
+		CHECK(tree.countInRange(INT_MAX, INT_MIN) == 0);
+		CHECK(tree.countInRange(2000, INT_MAX) == 0 && tree.countInRange(INT_MIN, -1) == 0);
+		CHECK(tree.lowerBound(INT_MIN) == tree.begin() && tree.upperBound(INT_MAX) == tree.end());
+	}
+}
+
+// fromSorted for every size up to 300, then moves and copies, including of an
+// empty tree: the results and the trees moved from must all be valid.
+template <class Balance, template <class> class NodeAllocator>
+static void checkConstruction(mt19937& random) {
+	typedef BST<int, Balance, NodeAllocator> Tree;
+	for (unsigned int size = 0; size <= 300; size++) {
+		vector<int> sorted;
+		for (unsigned int i = 0; i < size; i++)
+			sorted.push_back(3 * i + random() % 3);
+		Tree tree = Tree::fromSorted(sorted.begin(), sorted.end());
+		checkSame(tree, set<int>(sorted.begin(), sorted.end()));
+	}
+
+	set<int> reference;
+	for (int i = 0; i < 500; i++)
+		reference.insert(random() % 3000);
+	Tree tree = Tree::fromSorted(reference.begin(), reference.end());
+
+	// Move constructor and move assignment leave the source empty and valid
+	Tree moved(move(tree));
+	checkSame(moved, reference);
+	checkSame(tree, set<int>());
+	tree.insert(7);
+	checkSame(tree, set<int>({ 7 }));
+	Tree assigned;
+	assigned.insert(1);
+	assigned = move(moved);
+	checkSame(assigned, reference);
+	checkSame(moved, set<int>());
+
+	// Copies of an empty tree, and copy assignment over a full and an empty tree
+	Tree empty;
+	Tree emptyCopy(empty);
+	checkSame(emptyCopy, set<int>());
+	Tree copy;
+	copy.insert(-1);
+	copy.insert(-2);
+	copy = assigned;
+	checkSame(copy, reference);
+	checkSame(assigned, reference);
+	copy.insert(-5);
+	CHECK(assigned.getElementCount() == reference.size());
+	copy = empty;
+	checkSame(copy, set<int>());
+	const Tree& self = copy = assigned;
+	copy = self;
+	checkSame(copy, reference);
+}
+
+// Element that counts how many of its objects exist, and owns heap memory.
+struct Counted {
+	static int alive;
+	int key;
+	string payload;
+
+	Counted(int key = 0) : key(key), payload(32, '*') { alive++; }
+	Counted(const Counted& other) : key(other.key), payload(other.payload) { alive++; }
+	Counted& operator=(const Counted& other) { key = other.key; payload = other.payload; return *this; }
+	~Counted() { alive--; }
+	bool operator==(const Counted& other) const { return key == other.key; }
+	bool operator>(const Counted& other) const { return key > other.key; }
+	bool operator<(const Counted& other) const { return key < other.key; }
+};
+int Counted::alive = 0;
+
+// Inserts, removes, copies, assignments and removeIf on trees of Counted
+// elements: once the trees are gone, so must every element be.
+template <template <class> class NodeAllocator>
+static void checkElementLifetimes(mt19937& random) {
+	{
+		BST<Counted, AVLBalance, NodeAllocator> tree;
+		set<int> reference;
+		for (unsigned int step = 0; step < 5000; step++) {
+			int key = random() % 1000;
+			if (random() % 3 != 0) {
+				if (reference.insert(key).second)
+					tree.insert(Counted(key));
+			}
+			else if (reference.erase(key) > 0) {
+				tree.remove(Counted(key));
+			}
+			CHECK(tree.isValid());
+		}
+		BST<Counted, AVLBalance, NodeAllocator> copy(tree);
+		BST<Counted, AVLBalance, NodeAllocator> assigned;
+		assigned.insert(Counted(-1));
+		assigned = copy;
+		CHECK(copy.getElementCount() == reference.size() && assigned.getElementCount() == reference.size());
+		unsigned int odd = tree.removeIf([](const Counted& element) { return element.key % 2 != 0; });
+		CHECK(tree.isValid() && tree.getElementCount() + odd == reference.size());
+		CHECK(Counted::alive == (int)(tree.getElementCount() + 2 * reference.size()));
+	}
+	CHECK(Counted::alive == 0);
+}
+
+// Element whose copies and comparisons throw once the shared budget runs out.
+struct Fragile {
+	static int budget;
+	int key;
+
+	Fragile(int key = 0) : key(key) {}
+	Fragile(const Fragile& other) : key(other.key) { spend(); }
+	Fragile& operator=(const Fragile& other) { key = other.key; return *this; }
+	bool operator==(const Fragile& other) const { spend(); return key == other.key; }
+	bool operator>(const Fragile& other) const { spend(); return key > other.key; }
+	static void spend() { if (--budget < 0) throw budget; }
+};
+int Fragile::budget = 1 << 30;
+
+// Inserts interrupted by a throwing copy or comparison, at every point of
+// the walk down and of the node's creation: the tree must be left as it was.
+template <class Balance, template <class> class NodeAllocator>
+static void checkInsertExceptionSafety(mt19937& random) {
+	BST<Fragile, Balance, NodeAllocator> tree;
+	set<int> reference;
+	for (unsigned int step = 0; step < 2000; step++) {
+		int key = random() % 5000;
+		if (reference.count(key) > 0)
+			continue;
+		Fragile element(key);
+		for (int budget = 0; ; budget++) {
+			Fragile::budget = budget;
+			try {
+				tree.insert(element);
+				break;
+			}
+			catch (int) {
+				Fragile::budget = 1 << 30;
+				CHECK(tree.isValid());
+				CHECK(tree.getElementCount() == reference.size());
+			}
+		}
+		Fragile::budget = 1 << 30;
+		reference.insert(key);
+		CHECK(tree.isValid());
+	}
+	CHECK(tree.getElementCount() == reference.size());
+}
+
+// Utility function - Returns a random key, now and then an extreme one, so that
+//                    signed and unsigned comparisons disagree on some of them.
+static int32_t randomKey(mt19937& random, int32_t*) {
+	static const int32_t extremes[] = { INT32_MIN, INT32_MIN + 1, -1, 0, 1, INT32_MAX - 1, INT32_MAX };
+	return random() % 8 == 0 ? extremes[random() % 7] : (int32_t)(random() % 4000) - 2000;
+}
+static uint32_t randomKey(mt19937& random, uint32_t*) {
+	static const uint32_t extremes[] = { 0, 1, 0x7fffffffu, 0x80000000u, 0x80000001u, UINT32_MAX - 1, UINT32_MAX };
+	return random() % 8 == 0 ? extremes[random() % 7] : random() % 4000;
+}
+static float randomKey(mt19937& random, float*) {
+	static const float extremes[] = { -1e30f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1e30f };
+	return random() % 8 == 0 ? extremes[random() % 7] : ((int)(random() % 4000) - 2000) * 0.25f;
+}
+static Counted randomKey(mt19937& random, Counted*) {
+	return Counted(random() % 4000);
+}
+
+// Snapshots of random trees of every size up to 70, and a few larger ones,
+// against a set: iteration both ways, lowerBound, retrieve, and contains one
+// key at a time and in batches (the AVX2 path for 32-bit keys, where compiled
+// in). Also the range constructors, copies, moves, and the empty snapshot.
+template <class Key>
+static void checkFrozen(mt19937& random) {
+	for (unsigned int round = 0; round < 100; round++) {
+		unsigned int size = round <= 70 ? round : 1 + random() % 2000;    // Of about 4000 possible keys
+		BST<Key, AVLBalance> tree;
+		set<Key> reference;
+		while (reference.size() < size) {
+			Key key = randomKey(random, (Key*)NULL);
+			if (reference.insert(key).second)
+				tree.insert(key);
+		}
+		FrozenBST<Key> frozen = tree.freeze();
+		CHECK(frozen.getElementCount() == size);
+
+		typename FrozenBST<Key>::Iterator element = frozen.begin();
+		for (typename set<Key>::const_iterator expected = reference.begin(); expected != reference.end(); ++expected, ++element)
+			CHECK(element != frozen.end() && *element == *expected);
+		CHECK(element == frozen.end());
+		for (typename set<Key>::const_reverse_iterator expected = reference.rbegin(); expected != reference.rend(); ++expected)
+			CHECK(*--element == *expected);
+		CHECK(element == frozen.begin());
+		typename set<Key>::const_iterator visited = reference.begin();
+		frozen.forEach([&](const Key& key) { CHECK(visited != reference.end() && *visited++ == key); });
+
+		// Probes: every element, and random keys, most of them missing
+		vector<Key> probes(reference.begin(), reference.end());
+		for (unsigned int i = 0; i < 2 * size + 13; i++)
+			probes.push_back(randomKey(random, (Key*)NULL));
+		shuffle(probes.begin(), probes.end(), random);
+		unsigned int batch = probes.size() - random() % 9;
+		bool* found = new bool[batch];
+		frozen.contains(probes.data(), batch, found);
+		for (unsigned int i = 0; i < probes.size(); i++) {
+			typename set<Key>::const_iterator expected = reference.lower_bound(probes[i]);
+			typename FrozenBST<Key>::Iterator bound = frozen.lowerBound(probes[i]);
+			CHECK(expected == reference.end() ? bound == frozen.end() : bound != frozen.end() && *bound == *expected);
+			bool exists = reference.count(probes[i]) > 0;
+			CHECK(frozen.contains(probes[i]) == exists);
+			CHECK(i >= batch || found[i] == exists);
+			if (i % 16 != 0) {
+				continue;    // Misses throw, which is slow under the sanitizers
+			}
+			if (size == 0) {
+				try { frozen.retrieve(probes[i]); CHECK(false); } catch (EmptyDataCollectionException&) {}
+			}
+			else {
+				try { CHECK(frozen.retrieve(probes[i]) == probes[i] && exists); } catch (ElementDoesNotExistException&) { CHECK(!exists); }
+			}
+		}
+		delete[] found;
+
+		FrozenBST<Key> ranged(reference.begin(), reference.end());
+		FrozenBST<Key> counted(reference.begin(), (unsigned int)reference.size());
+		FrozenBST<Key> copy(frozen);
+		FrozenBST<Key> assigned;
+		assigned = ranged;
+		FrozenBST<Key> moved(move(counted));
+		CHECK(counted.getElementCount() == 0 && counted.begin() == counted.end());
+		const FrozenBST<Key>* snapshots[] = { &ranged, &copy, &assigned, &moved };
+		for (unsigned int s = 0; s < 4; s++) {
+			CHECK(snapshots[s]->getElementCount() == size);
+			CHECK(equal(reference.begin(), reference.end(), snapshots[s]->begin()));
+		}
+	}
+}
+
+int main() {
+	mt19937 random(2022);
+	checkBalance<NoBalance, NewNodeAllocator>(random);
+	checkBalance<AVLBalance, NewNodeAllocator>(random);
+	checkBalance<RedBlackBalance, NewNodeAllocator>(random);
+	checkBalance<AVLBalance, PooledNodeAllocator>(random);
+	checkBalance<RedBlackBalance, PooledNodeAllocator>(random);
+	checkIteration<NoBalance>(random);
+	checkIteration<AVLBalance>(random);
+	checkIteration<RedBlackBalance>(random);
+	checkRanges<NoBalance>(random);
+	checkRanges<AVLBalance>(random);
+	checkRanges<RedBlackBalance>(random);
+	checkConstruction<NoBalance, NewNodeAllocator>(random);
+	checkConstruction<AVLBalance, NewNodeAllocator>(random);
+	checkConstruction<RedBlackBalance, NewNodeAllocator>(random);
+	checkConstruction<AVLBalance, PooledNodeAllocator>(random);
+	checkConstruction<RedBlackBalance, PooledNodeAllocator>(random);
+	checkElementLifetimes<NewNodeAllocator>(random);
+	checkElementLifetimes<PooledNodeAllocator>(random);
+	checkInsertExceptionSafety<AVLBalance, NewNodeAllocator>(random);
+	checkInsertExceptionSafety<RedBlackBalance, PooledNodeAllocator>(random);
+	checkFrozen<int32_t>(random);
+	checkFrozen<uint32_t>(random);
+	checkFrozen<float>(random);
+	checkFrozen<Counted>(random);
+	CHECK(Counted::alive == 0);
+	printf("All binary search tree checks passed.\n");
+	return 0;
+}
@@ -15,6 +15,9 @@ template <class ElementType>
 BSTNode<ElementType>::BSTNode() {
 	left = NULL;
 	right = NULL;
+	parent = NULL;
+	rank = 0;
+	size = 1;
 }
 
 template <class ElementType>
@@ -22,6 +25,9 @@ BSTNode<ElementType>::BSTNode(ElementType element) {
 	this->element = element;
 	left = NULL;
 	right = NULL;
+	parent = NULL;
+	rank = 0;
+	size = 1;
 }
 
 template <class ElementType>
@@ -29,6 +35,9 @@ BSTNode<ElementType>::BSTNode(ElementType element, BSTNode<ElementType>* left, B
 	this->element = element;
 	this->left = left;
 	this->right = right;	
+	parent = NULL;
+	rank = 0;
+	size = 1;
 }
 
 // Boolean helper functions
@@ -19,6 +19,9 @@ public:
 	ElementType element;
 	BSTNode<ElementType>* left;
 	BSTNode<ElementType>* right;
+	BSTNode<ElementType>* parent;
+	unsigned char rank;    // Kept by the BST's balancing policy: height (AVL) or colour (red-black)
+	unsigned int size;     // Number of nodes in the subtree rooted here, this one included
 
 	// Constructors
 	BSTNode() ;
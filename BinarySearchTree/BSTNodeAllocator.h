@@ -0,0 +1,86 @@
+/*
+ * BSTNodeAllocator.h
+ *
+ * Description: Node allocators for the Binary Search Tree data collection ADT class.
+ *              A node allocator creates and destroys the BST's nodes:
+ *                - NewNodeAllocator:    every node comes from new and goes back
+ *                                       with delete.
+ *                - PooledNodeAllocator: nodes are carved out of contiguous
+ *                                       NodePool chunks and recycled through its
+ *                                       free list. All chunks are freed at once
+ *                                       when the tree is destroyed.
+ *              destroyAll() takes back a whole batch of nodes, as removeIf()
+ *              produces them, so that an allocator can return them together.
+ *
+ * Author: Amanda Ngo
+ * Date of last modification: March 2022
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "NodePool.h"
+
+using namespace std;
+
+// Default NodeAllocator. FREES_ALL_NODES tells the BST whether destroying the
+// allocator frees every node it created, so that a tree of trivially
+// destructible nodes need not be walked on destruction.
+template <class NodeType>
+struct NewNodeAllocator {
+	static const bool FREES_ALL_NODES = false;
+
+	template <class... Args>
+	NodeType* create(Args&&... args) { return new NodeType(forward<Args>(args)...); }
+
+	void destroy(NodeType* node) { delete node; }
+
+	void destroyAll(NodeType* const* nodes, size_t count) {
+		for (size_t i = 0; i < count; i++)
+			delete nodes[i];
+	}
+
+	void swap(NewNodeAllocator<NodeType>&) {}
+};
+
+// NodeAllocator backed by a NodePool: one allocation per 256 nodes, neighbours
+// in insertion order share cache lines, and removed nodes are reused first.
+// Memory only goes back to the system when the allocator is destroyed.
+template <class NodeType>
+class PooledNodeAllocator {
+	NodePool<NodeType> pool;
+public:
+	static const bool FREES_ALL_NODES = true;
+
+	template <class... Args>
+	NodeType* create(Args&&... args) {
+		void* slot = pool.acquire();
+		try {
+			return new (slot) NodeType(forward<Args>(args)...);
+		}
+		catch (...) {
+			pool.release(static_cast<NodeType*>(slot));
+			throw;
+		}
+	}
+
+	void destroy(NodeType* node) {
+		node->~NodeType();
+		pool.release(node);
+	}
+
+	// The slots go back to the pool in one splice, in the order given.
+	void destroyAll(NodeType* const* nodes, size_t count) {
+		if (!is_trivially_destructible<NodeType>::value) {
+			for (size_t i = 0; i < count; i++)
+				nodes[i]->~NodeType();
+		}
+		pool.releaseAll(nodes, count);
+	}
+
+	void swap(PooledNodeAllocator<NodeType>& other) { pool.swap(other.pool); }
+};
@@ -0,0 +1,471 @@
+/*
+ * FrozenBST.cpp
+ *
+ * Description: Read-only snapshot of a Binary Search Tree, in Eytzinger
+ *              (breadth-first) order: the children of elements[k] are
+ *              elements[2k] and elements[2k + 1].
+ *              Duplicated elements are not allowed.
+ *
+ * Class invariant: An in order walk of the implicit tree visits the elements
+ *                  in increasing order.
+ *
+ * Author: Amanda Ngo
+ * Date of last modification: July 18, 2022
+ *
+ */
+
+#include "FrozenBST.h"
+
+#if defined(__GNUC__) && defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Utility function - A search that ran off the bottom of the implicit tree ends
+//                    at 2k or 2k + 1 below the last node k it went left or right
+//                    from. Its answer is the last node it went left from: drop the
+//                    right turns (trailing 1 bits) and the left turn before them.
+//                    Returns 0 if it never went left.
+static inline unsigned int lastLeftTurn(unsigned int k) {
+#if defined(__GNUC__)
+	return k >> __builtin_ffs(~k);
+#else
+	while (k & 1)
+		k >>= 1;
+	return k >> 1;
+#endif
+}
+
+// Utility function - Prefetches the cache line at "address" for reading.
+static inline void prefetch(const void* address) {
+#if defined(__GNUC__)
+	__builtin_prefetch(address);
+#endif
+}
+
+// Vector versions of EytzingerBatch for 32-bit keys. Each one runs 8 searches
+// in the lanes of a vector, loading elements[k] for all of them with one gather.
+// Every search takes the same number of steps but the last, where lanes that
+// ran off the bottom of the tree keep their index.
+#if defined(__GNUC__) && defined(__AVX2__)
+
+// Utility functions - Lanes where x > a are all ones, the others are zero.
+static inline __m256i lanesGreater(__m256i x, __m256i a, int32_t*) {
+	return _mm256_cmpgt_epi32(x, a);
+}
+static inline __m256i lanesGreater(__m256i x, __m256i a, uint32_t*) {
+	// No unsigned compare: flip the sign bits and compare signed
+	const __m256i signBits = _mm256_set1_epi32(INT32_MIN);
+	return _mm256_cmpgt_epi32(_mm256_xor_si256(x, signBits), _mm256_xor_si256(a, signBits));
+}
+static inline __m256i lanesGreater(__m256i x, __m256i a, float*) {
+	return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(x), _mm256_castsi256_ps(a), _CMP_GT_OQ));
+}
+
+// Utility function - EytzingerBatch::lowerBounds for a 32-bit KeyType.
+// Precondition: n < 2^31, so that indices compare correctly as signed lanes.
+template <class KeyType>
+static inline void lowerBounds8(const KeyType* elements, unsigned int n, unsigned int levels,
+                                const KeyType* targets, unsigned int count, unsigned int* indices) {
+	const int* base = reinterpret_cast<const int*>(elements);
+	const __m256i one = _mm256_set1_epi32(1);
+	const __m256i pastLast = _mm256_set1_epi32(n + 1);
+	for (unsigned int i = 0; i < count; i += 8) {
+		// A last, partial group repeats its first target in the unused lanes
+		KeyType group[8];
+		for (unsigned int lane = 0; lane < 8; lane++)
+			group[lane] = targets[i + (i + lane < count ? lane : 0)];
+		__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(group));
+		__m256i k = one;
+
+		// Levels 1 .. levels-1 are full, so every lane is on a node. Each lane
+		// prefetches elements[16k], its 16 descendants four levels down.
+		unsigned int ahead[8];
+		for (unsigned int level = 1; level < levels; level++) {
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(ahead), _mm256_slli_epi32(k, 4));
+			for (unsigned int lane = 0; lane < 8; lane++)
+				prefetch(elements + ahead[lane]);
+			__m256i a = _mm256_i32gather_epi32(base, k, 4);
+			k = _mm256_sub_epi32(_mm256_add_epi32(k, k), lanesGreater(x, a, (KeyType*)NULL));
+		}
+		// The last level may be partly filled: only lanes with k <= n take a step
+		__m256i onNode = _mm256_cmpgt_epi32(pastLast, k);
+		__m256i a = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), base, k, onNode, 4);
+		__m256i next = _mm256_sub_epi32(_mm256_add_epi32(k, k), lanesGreater(x, a, (KeyType*)NULL));
+		k = _mm256_blendv_epi8(k, next, onNode);
+
+		unsigned int ends[8];
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(ends), k);
+		for (unsigned int lane = 0; lane < 8 && i + lane < count; lane++)
+			indices[i + lane] = lastLeftTurn(ends[lane]);
+	}
+}
+
+template <>
+struct EytzingerBatch<int32_t> {
+	static void lowerBounds(const int32_t* elements, unsigned int n, unsigned int levels,
+	                        const int32_t* targets, unsigned int count, unsigned int* indices) {
+		lowerBounds8(elements, n, levels, targets, count, indices);
+	}
+};
+
+template <>
+struct EytzingerBatch<uint32_t> {
+	static void lowerBounds(const uint32_t* elements, unsigned int n, unsigned int levels,
+	                        const uint32_t* targets, unsigned int count, unsigned int* indices) {
+		lowerBounds8(elements, n, levels, targets, count, indices);
+	}
+};
+
+template <>
+struct EytzingerBatch<float> {
+	static void lowerBounds(const float* elements, unsigned int n, unsigned int levels,
+	                        const float* targets, unsigned int count, unsigned int* indices) {
+		lowerBounds8(elements, n, levels, targets, count, indices);
+	}
+};
+
+#endif
+
+// Portable version: 8 scalar searches, one level at a time, each prefetching
+// its descendants a few levels down before the next level is compared.
+template <class ElementType>
+void EytzingerBatch<ElementType>::lowerBounds(const ElementType* elements, unsigned int n, unsigned int levels,
+                                              const ElementType* targets, unsigned int count, unsigned int* indices) {
+	const unsigned int LANES = 8;
+	const size_t stride = 64 / sizeof(ElementType) >= 2 ? 64 / sizeof(ElementType) : 2;
+	for (unsigned int i = 0; i < count; i += LANES) {
+		unsigned int lanes = count - i < LANES ? count - i : LANES;
+		unsigned int k[LANES];
+		for (unsigned int lane = 0; lane < lanes; lane++)
+			k[lane] = 1;
+		for (unsigned int level = 1; level < levels; level++) {
+			for (unsigned int lane = 0; lane < lanes; lane++) {
+				prefetch(elements + k[lane]*stride);
+				k[lane] = 2*k[lane] + (targets[i + lane] > elements[k[lane]]);
+			}
+		}
+		for (unsigned int lane = 0; lane < lanes; lane++) {
+			if (k[lane] <= n)
+				k[lane] = 2*k[lane] + (targets[i + lane] > elements[k[lane]]);
+			indices[i + lane] = lastLeftTurn(k[lane]);
+		}
+	}
+}
+
+/* Constructors and destructor */
+
+	// Default constructor
+	template <class ElementType>
+	FrozenBST<ElementType>::FrozenBST() {
+		elementCount = 0;
+		levels = 0;
+		storage = NULL;
+		elements = NULL;
+	}
+
+	// Range constructor
+	// Description: Counts the elements of [first, last), then builds the snapshot
+	//              from them as the counted range constructor does.
+	// Time efficiency: O(n)
+	template <class ElementType>
+	template <class ForwardIterator>
+	FrozenBST<ElementType>::FrozenBST(ForwardIterator first, ForwardIterator last)
+		: FrozenBST(first, (unsigned int)distance(first, last)) {}
+
+	// Counted range constructor
+	// Description: Visits the positions of the implicit tree in order and copies
+	//              the next element from "first" to each one, in a single pass.
+	//              If an element cannot be copied, the ones copied so far are destroyed.
+	// Time efficiency: O(n)
+	template <class ElementType>
+	template <class InputIterator>
+	FrozenBST<ElementType>::FrozenBST(InputIterator first, unsigned int count) {
+		allocate(count);
+		unsigned int constructed = 0;
+		try {
+			for (unsigned int k = firstIndex(); k != 0; k = successor(k), ++first) {
+				new (elements + k) ElementType(*first);
+				constructed++;
+			}
+		}
+		catch (...) {
+			release(constructed, false);
+			throw;
+		}
+	}
+
+	// Copy constructor
+	// Description: Copies the array of aFrozenBST as is, so no element is compared.
+	// Time efficiency: O(n)
+	template <class ElementType>
+	FrozenBST<ElementType>::FrozenBST(const FrozenBST<ElementType>& aFrozenBST) {
+		allocate(aFrozenBST.elementCount);
+		unsigned int k = 1;
+		try {
+			for (; k <= elementCount; k++)
+				new (elements + k) ElementType(aFrozenBST.elements[k]);
+		}
+		catch (...) {
+			release(k - 1, true);
+			throw;
+		}
+	}
+
+	// Move constructor
+	// Description: Takes over the array of aFrozenBST, which is left empty.
+	template <class ElementType>
+	FrozenBST<ElementType>::FrozenBST(FrozenBST<ElementType>&& aFrozenBST) noexcept {
+		elementCount = aFrozenBST.elementCount;
+		levels = aFrozenBST.levels;
+		storage = aFrozenBST.storage;
+		elements = aFrozenBST.elements;
+		aFrozenBST.elementCount = 0;
+		aFrozenBST.levels = 0;
+		aFrozenBST.storage = NULL;
+		aFrozenBST.elements = NULL;
+	}
+
+	// Destructor
+	template <class ElementType>
+	FrozenBST<ElementType>::~FrozenBST() {
+		release(elementCount, true);
+	}
+
+/* Assignment operators */
+
+	// Copy assignment operator
+	template <class ElementType>
+	FrozenBST<ElementType>& FrozenBST<ElementType>::operator=(const FrozenBST<ElementType>& rhs) {
+		if (this != &rhs) {
+			FrozenBST<ElementType> copy(rhs);
+			*this = move(copy);
+		}
+		return *this;
+	}
+
+	// Move assignment operator
+	template <class ElementType>
+	FrozenBST<ElementType>& FrozenBST<ElementType>::operator=(FrozenBST<ElementType>&& rhs) noexcept {
+		swap(elementCount, rhs.elementCount);
+		swap(levels, rhs.levels);
+		swap(storage, rhs.storage);
+		swap(elements, rhs.elements);
+		return *this;
+	}
+
+/* Getters */
+
+	// Description: Returns the number of elements in the snapshot.
+	// Time efficiency: O(1)
+	template <class ElementType>
+	unsigned int FrozenBST<ElementType>::getElementCount() const {
+		return elementCount;
+	}
+
+/* Frozen BST Operations */
+
+	// Description: Retrieves "targetElement" from the snapshot.
+	// Precondition: The snapshot is not empty.
+	// Exception: Throws the exception "EmptyDataCollectionException"
+	//            if the snapshot is empty.
+	// Exception: Throws the exception "ElementDoesNotExistException"
+	//            if "targetElement" is not in the snapshot.
+	// Time efficiency: O(log2 n)
+	template <class ElementType>
+	const ElementType& FrozenBST<ElementType>::retrieve(const ElementType& targetElement) const {
+		if (elementCount == 0) {
+			throw EmptyDataCollectionException("Frozen binary search tree is empty.\n");
+		}
+		unsigned int k = lowerBoundIndex(targetElement);
+		if (k == 0 || !(elements[k] == targetElement)) {
+			throw ElementDoesNotExistException("Element was unable to be located");
+		}
+		return elements[k];
+	}
+
+	// Description: Returns "true" if "targetElement" is in the snapshot, otherwise "false".
+	// Time efficiency: O(log2 n)
+	template <class ElementType>
+	bool FrozenBST<ElementType>::contains(const ElementType& targetElement) const {
+		unsigned int k = lowerBoundIndex(targetElement);
+		return k != 0 && elements[k] == targetElement;
+	}
+
+	// Description: Sets results[i] to contains(targets[i]) for every i < count,
+	//              finding the lower bounds with EytzingerBatch a chunk at a time.
+	// Time efficiency: O(count log2 n)
+	template <class ElementType>
+	void FrozenBST<ElementType>::contains(const ElementType* targets, unsigned int count, bool* results) const {
+		const unsigned int CHUNK = 256;
+		unsigned int indices[CHUNK];
+		for (unsigned int i = 0; i < count; i += CHUNK) {
+			unsigned int chunk = count - i < CHUNK ? count - i : CHUNK;
+			EytzingerBatch<ElementType>::lowerBounds(elements, elementCount, levels, targets + i, chunk, indices);
+			for (unsigned int j = 0; j < chunk; j++)
+				results[i + j] = indices[j] != 0 && elements[indices[j]] == targets[i + j];
+		}
+	}
+
+	// Description: Returns an iterator to the smallest element not smaller than
+	//              "element", or end() if there is none.
+	// Time efficiency: O(log2 n)
+	template <class ElementType>
+	typename FrozenBST<ElementType>::Iterator FrozenBST<ElementType>::lowerBound(const ElementType& element) const {
+		return Iterator(this, lowerBoundIndex(element));
+	}
+
+	// Description: Calls visit(element) on every element, in order. If visit returns
+	//              a bool, returning false stops the traversal there.
+	//              Returns "false" if the traversal was stopped, otherwise "true".
+	// Time efficiency: O(n)
+	template <class ElementType>
+	template <class Function>
+	bool FrozenBST<ElementType>::forEach(Function&& visit) const {
+		typedef typename is_void<decltype(visit(declval<const ElementType&>()))>::type returnsVoid;
+		for (unsigned int k = firstIndex(); k != 0; k = successor(k)) {
+			if (!visitElement(visit, elements[k], returnsVoid())) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+/* Iterators */
+
+	// Description: Returns an iterator to the smallest element, or end() if
+	//              the snapshot is empty.
+	// Time efficiency: O(log2 n)
+	template <class ElementType>
+	typename FrozenBST<ElementType>::Iterator FrozenBST<ElementType>::begin() const {
+		return Iterator(this, firstIndex());
+	}
+
+	// Description: Returns the iterator past the largest element.
+	// Time efficiency: O(1)
+	template <class ElementType>
+	typename FrozenBST<ElementType>::Iterator FrozenBST<ElementType>::end() const {
+		return Iterator(this, 0);
+	}
+
+/* Utility methods */
+
+	// Description: Returns the index of the first element not smaller than "element",
+	//              or 0 if there is none. Goes to 2k when "element" is not larger than
+	//              elements[k] and to 2k + 1 when it is, computed from the comparison
+	//              rather than branched on, until it runs off the bottom. Each step
+	//              prefetches the block of descendants of elements[k] a few levels
+	//              down, so the misses of those levels are already on their way.
+	// Time efficiency: O(log2 n)
+	template <class ElementType>
+	unsigned int FrozenBST<ElementType>::lowerBoundIndex(const ElementType& element) const {
+		unsigned int k = 1;
+		while (k <= elementCount) {
+			prefetch(elements + (size_t)k*PREFETCH_STRIDE);
+			k = 2*k + (element > elements[k]);
+		}
+		return lastLeftTurn(k);
+	}
+
+	// Description: Returns the index of the first element in order: the leftmost
+	//              node, or 0 if there is none.
+	template <class ElementType>
+	unsigned int FrozenBST<ElementType>::firstIndex() const {
+		if (elementCount == 0) {
+			return 0;
+		}
+		unsigned int k = 1;
+		while (2*k <= elementCount) {
+			k = 2*k;
+		}
+		return k;
+	}
+
+	// Description: Returns the index of the last element in order: the rightmost
+	//              node, or 0 if there is none.
+	template <class ElementType>
+	unsigned int FrozenBST<ElementType>::lastIndex() const {
+		if (elementCount == 0) {
+			return 0;
+		}
+		unsigned int k = 1;
+		while (2*k + 1 <= elementCount) {
+			k = 2*k + 1;
+		}
+		return k;
+	}
+
+	// Description: Returns the index of the element after elements[k] in order, or 0
+	//              if there is none: the leftmost node of its right subtree if it has
+	//              one, otherwise the nearest ancestor it is on the left of.
+	template <class ElementType>
+	unsigned int FrozenBST<ElementType>::successor(unsigned int k) const {
+		if (2*k + 1 <= elementCount) {
+			k = 2*k + 1;
+			while (2*k <= elementCount) {
+				k = 2*k;
+			}
+			return k;
+		}
+		return lastLeftTurn(k);
+	}
+
+	// Description: Returns the index of the element before elements[k] in order, or 0
+	//              if there is none: the rightmost node of its left subtree if it has
+	//              one, otherwise the nearest ancestor it is on the right of.
+	template <class ElementType>
+	unsigned int FrozenBST<ElementType>::predecessor(unsigned int k) const {
+		if (2*k <= elementCount) {
+			k = 2*k;
+			while (2*k + 1 <= elementCount) {
+				k = 2*k + 1;
+			}
+			return k;
+		}
+		// Drop the left turns (trailing 0 bits) and the right turn before them
+		while ((k & 1) == 0) {
+			k >>= 1;
+		}
+		return k >> 1;
+	}
+
+	// Description: Allocates aligned storage for "count" elements, elements[0] being
+	//              an unused slot, and sets the counts. No element is constructed.
+	//              With the array aligned, the 64 / sizeof(ElementType) descendants of
+	//              a node that many levels down share one cache line.
+	template <class ElementType>
+	void FrozenBST<ElementType>::allocate(unsigned int count) {
+		elementCount = 0;
+		levels = 0;
+		storage = NULL;
+		elements = NULL;
+		if (count == 0) {
+			return;
+		}
+		size_t alignment = ALIGNMENT > alignof(ElementType) ? ALIGNMENT : alignof(ElementType);
+		storage = ::operator new((count + 1)*sizeof(ElementType) + alignment - 1);
+		uintptr_t aligned = (reinterpret_cast<uintptr_t>(storage) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+		elements = reinterpret_cast<ElementType*>(aligned);
+		elementCount = count;
+		while (levels < 32 && (1u << levels) <= count) {
+			levels++;
+		}
+	}
+
+	// Description: Destroys the first "constructed" elements, taken in index order if
+	//              "inIndexOrder" is set and in order of the elements otherwise, and
+	//              frees the storage. Leaves the snapshot empty.
+	template <class ElementType>
+	void FrozenBST<ElementType>::release(unsigned int constructed, bool inIndexOrder) {
+		if (!is_trivially_destructible<ElementType>::value) {
+			unsigned int k = inIndexOrder ? 1 : firstIndex();
+			for (unsigned int i = 0; i < constructed; i++) {
+				elements[k].~ElementType();
+				k = inIndexOrder ? k + 1 : successor(k);
+			}
+		}
+		::operator delete(storage);
+		elementCount = 0;
+		levels = 0;
+		storage = NULL;
+		elements = NULL;
+	}
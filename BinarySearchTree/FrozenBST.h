@@ -0,0 +1,204 @@
+/*
+ * FrozenBST.h
+ *
+ * Description: Read-only snapshot of a Binary Search Tree, as returned by
+ *              BST::freeze(). The elements are kept in one array in Eytzinger
+ *              (breadth-first) order: the root is elements[1] and the children
+ *              of elements[k] are elements[2k] and elements[2k + 1]. There are
+ *              no pointers to follow, the top levels share a few cache lines,
+ *              and a search does the same steps whatever it compares, so it
+ *              needs no branch on the comparisons. It prefetches the 64-byte
+ *              block holding the descendants a few levels down, and the batch
+ *              version of contains() runs 8 searches side by side, with vector
+ *              compares for 32-bit keys where AVX2 is available.
+ *              Duplicated elements are not allowed.
+ *
+ * Class invariant: An in order walk of the implicit tree (left child, element,
+ *                  right child) visits the elements in increasing order.
+ *
+ * Author: Amanda Ngo
+ * Date of last modification: July 18, 2022
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "ElementDoesNotExistException.h"
+#include "EmptyDataCollectionException.h"
+
+using namespace std;
+
+// Runs the searches for targets[0 .. count-1] and stores, for each one, the index
+// of the first element not smaller than it, or 0 if there is none. elements is
+// the Eytzinger array of a FrozenBST holding n elements, in "levels" levels.
+// This is the portable version: it keeps 8 searches in flight, so that their cache
+// misses overlap. FrozenBST.cpp specializes it for 32-bit keys when AVX2 is available.
+template <class ElementType>
+struct EytzingerBatch {
+	static void lowerBounds(const ElementType* elements, unsigned int n, unsigned int levels,
+	                        const ElementType* targets, unsigned int count, unsigned int* indices);
+};
+
+template <class ElementType>
+class FrozenBST {
+
+private:
+	static const size_t ALIGNMENT = 64;
+	// elements[k * PREFETCH_STRIDE] starts the block holding the descendants of
+	// elements[k] log2(PREFETCH_STRIDE) levels down
+	static const unsigned int PREFETCH_STRIDE = ALIGNMENT / sizeof(ElementType) >= 2 ? ALIGNMENT / sizeof(ElementType) : 2;
+
+	unsigned int elementCount;
+	unsigned int levels;        // Levels of the implicit tree, 0 when empty
+	void* storage;              // As returned by operator new
+	ElementType* elements;      // ALIGNMENT-aligned; elements[1 .. elementCount] are constructed
+
+	/* Utility methods */
+
+	// Description: Returns the index of the first element not smaller than "element",
+	//              or 0 if there is none.
+	// Time efficiency: O(log2 n), branch-free on the comparisons
+	unsigned int lowerBoundIndex(const ElementType& element) const;
+
+	// Description: Returns the index of the first (or last) element in order, or 0
+	//              if there is none.
+	unsigned int firstIndex() const;
+	unsigned int lastIndex() const;
+
+	// Description: Returns the index of the element after (or before) elements[k]
+	//              in order, or 0 if there is none.
+	// Time efficiency: O(1) amortized over a full traversal
+	unsigned int successor(unsigned int k) const;
+	unsigned int predecessor(unsigned int k) const;
+
+	// Description: Allocates aligned storage for "count" elements and sets the counts,
+	//              without constructing any element.
+	void allocate(unsigned int count);
+
+	// Description: Destroys the elements at the "constructed" first indices visited in order
+	//              (in index order if "inIndexOrder" is set), then frees the storage.
+	void release(unsigned int constructed, bool inIndexOrder);
+
+	// Description: Calls visit(element). Returns what visit returned, or "true"
+	//              when visit returns nothing, so that forEach knows whether to go on.
+	template <class Function>
+	static bool visitElement(Function& visit, const ElementType& element, true_type) { visit(element); return true; }
+	template <class Function>
+	static bool visitElement(Function& visit, const ElementType& element, false_type) { return static_cast<bool>(visit(element)); }
+
+public:
+
+	// Bidirectional iterator over the elements, in order. It walks the implicit
+	// tree, so it needs no stack. Elements cannot be modified through it.
+	class Iterator {
+		friend class FrozenBST<ElementType>;
+		const FrozenBST<ElementType>* tree;
+		unsigned int index;         // 0 at end()
+
+		Iterator(const FrozenBST<ElementType>* tree, unsigned int index) : tree(tree), index(index) {}
+	public:
+		typedef bidirectional_iterator_tag iterator_category;
+		typedef ElementType value_type;
+		typedef ptrdiff_t difference_type;
+		typedef const ElementType* pointer;
+		typedef const ElementType& reference;
+
+		Iterator() : tree(NULL), index(0) {}
+		reference operator*() const { return tree->elements[index]; }
+		pointer operator->() const { return &tree->elements[index]; }
+		Iterator& operator++() { index = tree->successor(index); return *this; }
+		Iterator operator++(int) { Iterator old = *this; ++*this; return old; }
+		Iterator& operator--() { index = index == 0 ? tree->lastIndex() : tree->predecessor(index); return *this; }
+		Iterator operator--(int) { Iterator old = *this; --*this; return old; }
+		bool operator==(const Iterator& rhs) const { return index == rhs.index; }
+		bool operator!=(const Iterator& rhs) const { return index != rhs.index; }
+	};
+	typedef Iterator iterator;
+	typedef Iterator const_iterator;
+
+	/* Constructors and destructor */
+	FrozenBST();                                                     // Default constructor
+	FrozenBST(const FrozenBST<ElementType>& aFrozenBST);             // Copy constructor
+	FrozenBST(FrozenBST<ElementType>&& aFrozenBST) noexcept;         // Move constructor
+	~FrozenBST();                                                    // Destructor
+
+	// Range constructor
+	// Description: Builds the snapshot from the elements in [first, last), copying
+	//              each one straight to its place. The elements are never compared.
+	// Precondition: [first, last) is in increasing order, without duplicates.
+	// Time efficiency: O(n)
+	template <class ForwardIterator>
+	FrozenBST(ForwardIterator first, ForwardIterator last);
+
+	// Counted range constructor
+	// Description: Builds the snapshot from the "count" elements starting at "first",
+	//              reading each one once.
+	// Precondition: They are in increasing order, without duplicates.
+	// Time efficiency: O(n)
+	template <class InputIterator>
+	FrozenBST(InputIterator first, unsigned int count);
+
+	/* Assignment operators */
+	FrozenBST<ElementType>& operator=(const FrozenBST<ElementType>& rhs);
+	FrozenBST<ElementType>& operator=(FrozenBST<ElementType>&& rhs) noexcept;
+
+	/* Getters */
+
+	// Description: Returns the number of elements in the snapshot.
+	// Time efficiency: O(1)
+	unsigned int getElementCount() const;
+
+	/* Frozen BST Operations */
+
+	// Description: Retrieves "targetElement" from the snapshot.
+	// Precondition: The snapshot is not empty.
+	// Exception: Throws the exception "EmptyDataCollectionException"
+	//            if the snapshot is empty.
+	// Exception: Throws the exception "ElementDoesNotExistException"
+	//            if "targetElement" is not in the snapshot.
+	// Time efficiency: O(log2 n)
+	const ElementType& retrieve(const ElementType& targetElement) const;
+
+	// Description: Returns "true" if "targetElement" is in the snapshot, otherwise "false".
+	// Time efficiency: O(log2 n)
+	bool contains(const ElementType& targetElement) const;
+
+	// Description: Sets results[i] to contains(targets[i]) for every i < count.
+	//              Faster per element than one call at a time, since the searches
+	//              are interleaved and their cache misses overlap.
+	// Time efficiency: O(count log2 n)
+	void contains(const ElementType* targets, unsigned int count, bool* results) const;
+
+	// Description: Returns an iterator to the smallest element not smaller than
+	//              "element", or end() if there is none.
+	// Time efficiency: O(log2 n)
+	Iterator lowerBound(const ElementType& element) const;
+
+	// Description: Calls visit(element) on every element, in order. "visit" may be
+	//              any callable, e.g. a lambda. If it returns a bool, returning
+	//              false stops the traversal there.
+	//              Returns "false" if the traversal was stopped, otherwise "true".
+	// Time efficiency: O(n)
+	template <class Function>
+	bool forEach(Function&& visit) const;
+
+	/* Iterators */
+
+	// Description: Returns an iterator to the smallest element, or end() if
+	//              the snapshot is empty.
+	// Time efficiency: O(log2 n)
+	Iterator begin() const;
+
+	// Description: Returns the iterator past the largest element.
+	// Time efficiency: O(1)
+	Iterator end() const;
+
+}; // end FrozenBST
+
+#include "FrozenBST.cpp"
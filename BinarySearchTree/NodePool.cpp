@@ -0,0 +1,154 @@
+/*
+ * NodePool.cpp
+ *
+ * Description: Pool allocator for the nodes of a link-based data collection ADT class.
+ *              Hands out raw node slots from fixed-size chunks and recycles
+ *              released slots through a free list, so building and tearing
+ *              down a structure does not go to the global allocator per node.
+ *              Slots are raw storage: the caller constructs and destroys nodes.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#include "NodePool.h"
+
+// Default constructor
+template <class NodeType>
+NodePool<NodeType>::NodePool() {
+	chunks = NULL;
+	lastChunk = NULL;
+	usedInNewest = CHUNK_SIZE;
+	freeSlots = NULL;
+	lastFreeSlot = NULL;
+}
+
+// Destructor
+template <class NodeType>
+NodePool<NodeType>::~NodePool() {
+	while (chunks != NULL) {
+		Chunk* next = chunks->next;
+		delete chunks;
+		chunks = next;
+	}
+}
+
+// Description: Returns raw storage for one NodeType.
+// Time efficiency: O(1)
+template <class NodeType>
+void* NodePool<NodeType>::acquire() {
+	if (freeSlots != NULL) {
+		Slot* slot = freeSlots;
+		freeSlots = slot->nextFree;
+		if (freeSlots == NULL)
+			lastFreeSlot = NULL;
+		return &slot->storage;
+	}
+	if (usedInNewest == CHUNK_SIZE) {
+		Chunk* chunk = new Chunk;
+		chunk->next = chunks;
+		chunks = chunk;
+		if (lastChunk == NULL)
+			lastChunk = chunk;
+		usedInNewest = 0;
+	}
+	return &chunks->slots[usedInNewest++].storage;
+}
+
+// Description: Takes back the storage of a destroyed node.
+// Time efficiency: O(1)
+template <class NodeType>
+void NodePool<NodeType>::release(NodeType* node) {
+	Slot* slot = reinterpret_cast<Slot*>(node);
+	slot->nextFree = freeSlots;
+	if (freeSlots == NULL)
+		lastFreeSlot = slot;
+	freeSlots = slot;
+}
+
+// Description: Takes back the storage of "count" destroyed nodes at once, in the
+//              order given.
+// Time efficiency: O(count)
+template <class NodeType>
+void NodePool<NodeType>::releaseAll(NodeType* const* nodes, size_t count) {
+	if (count == 0)
+		return;
+	Slot* first = reinterpret_cast<Slot*>(nodes[0]);
+	Slot* last = first;
+	for (size_t i = 1; i < count; i++) {
+		Slot* slot = reinterpret_cast<Slot*>(nodes[i]);
+		last->nextFree = slot;
+		last = slot;
+	}
+	last->nextFree = freeSlots;
+	if (freeSlots == NULL)
+		lastFreeSlot = last;
+	freeSlots = first;
+}
+
+// Description: Takes over all chunks and free slots of "other", which is left empty,
+//              so nodes acquired from "other" can later be released here.
+//              Only one chunk can hand out slots that were never used, so the
+//              newest chunk with more of them keeps that role and the unused
+//              slots of the other one are put on the free list.
+// Time efficiency: O(CHUNK_SIZE)
+template <class NodeType>
+void NodePool<NodeType>::splice(NodePool<NodeType>& other) {
+	if (this == &other || other.chunks == NULL) return;
+
+	if (chunks == NULL) {
+		chunks = other.chunks;
+		lastChunk = other.lastChunk;
+		usedInNewest = other.usedInNewest;
+	}
+	else if (other.usedInNewest < usedInNewest) {
+		// The other pool's newest chunk has more room: it goes first
+		freeUnused(chunks, usedInNewest);
+		other.lastChunk->next = chunks;
+		chunks = other.chunks;
+		usedInNewest = other.usedInNewest;
+	}
+	else {
+		freeUnused(other.chunks, other.usedInNewest);
+		lastChunk->next = other.chunks;
+		lastChunk = other.lastChunk;
+	}
+
+	if (other.freeSlots != NULL) {
+		other.lastFreeSlot->nextFree = freeSlots;
+		if (freeSlots == NULL)
+			lastFreeSlot = other.lastFreeSlot;
+		freeSlots = other.freeSlots;
+	}
+
+	other.chunks = NULL;
+	other.lastChunk = NULL;
+	other.usedInNewest = CHUNK_SIZE;
+	other.freeSlots = NULL;
+	other.lastFreeSlot = NULL;
+}
+
+// Utility method - Puts the slots of "chunk" from "used" on onto the free list.
+template <class NodeType>
+void NodePool<NodeType>::freeUnused(Chunk* chunk, unsigned int used) {
+	for (unsigned int i = used; i < CHUNK_SIZE; i++) {
+		Slot* slot = &chunk->slots[i];
+		slot->nextFree = freeSlots;
+		if (freeSlots == NULL)
+			lastFreeSlot = slot;
+		freeSlots = slot;
+	}
+}
+
+// Description: Exchanges the contents of this pool and "other".
+// Time efficiency: O(1)
+template <class NodeType>
+void NodePool<NodeType>::swap(NodePool<NodeType>& other) {
+	std::swap(chunks, other.chunks);
+	std::swap(lastChunk, other.lastChunk);
+	std::swap(usedInNewest, other.usedInNewest);
+	std::swap(freeSlots, other.freeSlots);
+	std::swap(lastFreeSlot, other.lastFreeSlot);
+}
\ No newline at end of file
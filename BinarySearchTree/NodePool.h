@@ -0,0 +1,93 @@
+/*
+ * NodePool.h
+ *
+ * Description: Pool allocator for the nodes of a link-based data collection ADT class.
+ *              Hands out raw node slots from fixed-size chunks and recycles
+ *              released slots through a free list, so building and tearing
+ *              down a structure does not go to the global allocator per node.
+ *              Slots are raw storage: the caller constructs and destroys nodes.
+ *              PairingHeap and BinarySearchTree (through PooledNodeAllocator)
+ *              each keep their own copy of NodePool.h and NodePool.cpp.
+ *
+ * Class Invariant:  Every slot is either handed out, on the free list, or not yet
+ *                   used in the newest chunk.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#pragma once
+
+#include <cstddef>  // For NULL
+#include <type_traits>
+#include <utility>
+
+using namespace std;
+
+template <class NodeType>
+class NodePool {
+
+private:
+	static const unsigned int CHUNK_SIZE = 256;      // Slots per chunk
+
+	union Slot {
+		Slot* nextFree;
+		typename aligned_storage<sizeof(NodeType), alignof(NodeType)>::type storage;
+	};
+
+	struct Chunk {
+		Chunk* next;
+		Slot slots[CHUNK_SIZE];
+	};
+
+	Chunk* chunks;              // Newest chunk first
+	Chunk* lastChunk;
+	unsigned int usedInNewest;  // Slots of chunks[0] handed out at least once
+	Slot* freeSlots;            // Released slots, most recent first
+	Slot* lastFreeSlot;
+
+	// Utility method - Puts the slots of "chunk" from "used" on onto the free list.
+	void freeUnused(Chunk* chunk, unsigned int used);
+
+	NodePool(const NodePool<NodeType>&);
+	NodePool<NodeType>& operator=(const NodePool<NodeType>&);
+
+public:
+	// Default constructor
+	// Description: No memory is allocated until the first acquire().
+	NodePool();
+
+	// Destructor
+	// Description: Releases every chunk. Nodes still handed out must already be destroyed.
+	~NodePool();
+
+	// Description: Returns raw storage for one NodeType.
+	// Time efficiency: O(1)
+	void* acquire();
+
+	// Description: Takes back the storage of a destroyed node.
+	// Time efficiency: O(1)
+	void release(NodeType* node);
+
+	// Description: Takes back the storage of "count" destroyed nodes at once: they
+	//              are chained together and put on the free list in one step, to
+	//              be handed out again in the order given.
+	// Time efficiency: O(count)
+	void releaseAll(NodeType* const* nodes, size_t count);
+
+	// Description: Takes over all chunks and free slots of "other", which is left empty,
+	//              so nodes acquired from "other" can later be released here.
+	//              No slot is lost: the newest chunk with more unused slots keeps
+	//              handing them out, the other one's go on the free list.
+	// Time efficiency: O(CHUNK_SIZE)
+	void splice(NodePool<NodeType>& other);
+
+	// Description: Exchanges the contents of this pool and "other".
+	// Time efficiency: O(1)
+	void swap(NodePool<NodeType>& other);
+
+}; // end NodePool
+
+#include "NodePool.cpp"
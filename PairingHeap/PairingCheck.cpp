@@ -0,0 +1,175 @@
+/*
+ * PairingCheck.cpp
+ *
+ * Description: Randomized checks of the Pairing Heap and its NodePool.
+ *              Random enqueues, pops and melds (with many equal keys) run next
+ *              to a multiset and must agree with it after each step. Built
+ *              with AddressSanitizer and UndefinedBehaviorSanitizer by
+ *              "make check", which also runs it; the sanitizer also reports
+ *              any node that is never freed.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include "PairingHeap.h"
+
+using namespace std;
+
+// Stops the run with the failed condition and its line.
+#define CHECK(condition) \
+	do { if (!(condition)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); exit(1); } } while (0)
+
+// Every operator new in this program is counted, to see when the pools allocate chunks.
+static unsigned long long allocations = 0;
+
+void* operator new(size_t size) {
+	allocations++;
+	void* memory = malloc(size == 0 ? 1 : size);
+	if (memory == NULL) throw bad_alloc();
+	return memory;
+}
+void operator delete(void* memory) noexcept { free(memory); }
+void operator delete(void* memory, size_t) noexcept { free(memory); }
+
+// Random enqueues, pops and melds with a second heap, against a multiset.
+static void checkRandom(mt19937& random) {
+	for (unsigned int round = 0; round < 40; round++) {
+		PairingHeap<int> heap;
+		multiset<int> reference;
+		unsigned int range = 1 + random() % 1000;
+		for (unsigned int step = 0; step < 3000; step++) {
+			unsigned int operation = random() % 8;
+			if (operation <= 3 || reference.empty()) {
+				int key = random() % range;
+				CHECK(heap.enqueue(key));
+				reference.insert(key);
+			}
+			else if (operation <= 6) {
+				CHECK(heap.pop() == *reference.begin());
+				reference.erase(reference.begin());
+			}
+			else {
+				PairingHeap<int> other;
+				for (unsigned int i = random() % 300; i > 0; i--) {
+					int key = random() % range;
+					other.enqueue(key);
+					reference.insert(key);
+				}
+				heap.meld(other);
+				CHECK(other.isEmpty());
+			}
+			CHECK(heap.getElementCount() == reference.size());
+			if (!reference.empty())
+				CHECK(heap.peek() == *reference.begin());
+		}
+		PairingHeap<int> copy(heap);
+		while (!reference.empty()) {
+			CHECK(heap.pop() == *reference.begin());
+			CHECK(copy.pop() == *reference.begin());
+			reference.erase(reference.begin());
+		}
+	}
+}
+
+// Melding many small heaps keeps the unused node slots of their pools: filling
+// those slots afterwards allocates no further chunk.
+static void checkMeldKeepsSlots() {
+	const unsigned int heapCount = 100;
+	vector<PairingHeap<int> > heaps(heapCount);
+	for (unsigned int i = 0; i < heapCount; i++)
+		heaps[i].enqueue(i);
+	PairingHeap<int> all;
+	for (unsigned int i = 0; i < heapCount; i++)
+		all.meld(heaps[i]);
+
+	unsigned long long before = allocations;
+	// 100 chunks of 256 slots hold 100 elements: 25500 slots are left
+	for (int i = 0; i < 25000; i++)
+		all.enqueue(i);
+	CHECK(allocations == before);
+	CHECK(all.getElementCount() == 25100);
+}
+
+// Slots released together with releaseAll() are handed out again first, in the
+// order given, and filling them allocates no further chunk.
+static void checkReleaseAll(mt19937& random) {
+	NodePool<int> pool;
+	vector<int*> slots;
+	for (unsigned int i = 0; i < 1000; i++)
+		slots.push_back(static_cast<int*>(pool.acquire()));
+	shuffle(slots.begin(), slots.end(), random);
+	pool.release(slots[999]);
+	pool.releaseAll(slots.data(), 600);
+	pool.releaseAll(slots.data(), 0);
+
+	unsigned long long before = allocations;
+	for (unsigned int i = 0; i < 600; i++)
+		CHECK(pool.acquire() == slots[i]);
+	CHECK(pool.acquire() == slots[999]);
+	CHECK(allocations == before);
+	pool.releaseAll(slots.data(), 600);
+	for (unsigned int i = 600; i < 1000; i++)
+		pool.release(slots[i]);
+}
+
+// Element whose copies throw once the shared budget runs out. Moves never throw.
+struct Fragile {
+	static int budget;
+	static int alive;
+	int key;
+	string payload;
+
+	Fragile(int key) : key(key), payload(40, '*') { alive++; }
+	Fragile(const Fragile& other) : key(other.key), payload(other.payload) { spend(); alive++; }
+	Fragile(Fragile&& other) noexcept : key(other.key), payload(move(other.payload)) { alive++; }
+	~Fragile() { alive--; }
+	bool operator<(const Fragile& other) const { return key < other.key; }
+	static void spend() { if (--budget < 0) throw budget; }
+};
+int Fragile::budget = 1 << 30;
+int Fragile::alive = 0;
+
+// A copy interrupted by an element that cannot be copied destroys the elements
+// it copied so far, and leaves the original as it was.
+static void checkCopyExceptionSafety(mt19937& random) {
+	{
+		PairingHeap<Fragile> heap;
+		for (unsigned int i = 0; i < 500; i++)
+			heap.enqueue(Fragile(random() % 1000));
+		heap.dequeue();
+		for (int budget = 0; budget < 500; budget += 11) {
+			Fragile::budget = budget;
+			try { PairingHeap<Fragile> copy(heap); CHECK(false); } catch (int) {}
+			CHECK(Fragile::alive == 499);
+		}
+		Fragile::budget = 1 << 30;
+		int previous = -1;
+		while (!heap.isEmpty()) {
+			int key = heap.pop().key;
+			CHECK(key >= previous);
+			previous = key;
+		}
+	}
+	CHECK(Fragile::alive == 0);
+}
+
+int main() {
+	mt19937 random(2022);
+	checkRandom(random);
+	checkMeldKeepsSlots();
+	checkReleaseAll(random);
+	checkCopyExceptionSafety(random);
+	printf("All pairing heap checks passed.\n");
+	return 0;
+}
@@ -0,0 +1,274 @@
+/*
+ * PairingHeap.cpp
+ *
+ * Description: Meldable Priority Queue data collection ADT class.
+ *              Pointer-based Pairing Heap: a heap-ordered tree with any number
+ *              of children per node, kept as a first-child / next-sibling list.
+ *              Inserting and melding only link two roots; dequeuing pairs up
+ *              the root's children left to right, then links the pairs right
+ *              to left (two-pass pairing).
+ *
+ * Class Invariant:  Every node's element is not ranked after (by Compare) any element
+ *                   in its subtrees.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#include "PairingHeap.h"  // Header file
+
+using namespace std;
+
+// Default Constructor
+template <class ElementType, class Compare>
+PairingHeap<ElementType, Compare>::PairingHeap(const Compare& compare) : compare(compare) {
+	root = NULL;
+	elementCount = 0;
+}
+
+// Copy Constructor
+// Description: Copies the tree of aHeap node for node, with an explicit stack
+//              since the tree can be as deep as it has elements. Every copy is
+//              linked in as soon as it is built and starts with no children or
+//              siblings, so if an element cannot be copied the nodes copied so
+//              far form a tree, which is destroyed before rethrowing.
+template <class ElementType, class Compare>
+PairingHeap<ElementType, Compare>::PairingHeap(const PairingHeap<ElementType, Compare>& aHeap) : compare(aHeap.compare) {
+	root = NULL;
+	elementCount = 0;
+	if (aHeap.root == NULL) return;
+
+	try {
+		vector< pair<const Node*, Node**> > toCopy;   // Source node, and the link to point at its copy
+		toCopy.push_back(make_pair(aHeap.root, &root));
+		while (!toCopy.empty()) {
+			const Node* source = toCopy.back().first;
+			Node** link = toCopy.back().second;
+			toCopy.pop_back();
+			*link = newNode(source->element);
+			elementCount++;
+			if (source->sibling != NULL)
+				toCopy.push_back(make_pair(source->sibling, &(*link)->sibling));
+			if (source->child != NULL)
+				toCopy.push_back(make_pair(source->child, &(*link)->child));
+		}
+	}
+	catch (...) {
+		// The destructor does not run for a constructor that throws
+		destroyAll(root);
+		throw;
+	}
+}
+
+// Move Constructor
+template <class ElementType, class Compare>
+PairingHeap<ElementType, Compare>::PairingHeap(PairingHeap<ElementType, Compare>&& aHeap) noexcept : compare(aHeap.compare) {
+	root = aHeap.root;
+	elementCount = aHeap.elementCount;
+	pool.swap(aHeap.pool);
+	aHeap.root = NULL;
+	aHeap.elementCount = 0;
+}
+
+// Destructor
+template <class ElementType, class Compare>
+PairingHeap<ElementType, Compare>::~PairingHeap() {
+	destroyAll(root);
+}
+
+// Assignment operator
+template <class ElementType, class Compare>
+PairingHeap<ElementType, Compare>& PairingHeap<ElementType, Compare>::operator=(PairingHeap<ElementType, Compare> rhs) {
+	swap(root, rhs.root);
+	swap(elementCount, rhs.elementCount);
+	pool.swap(rhs.pool);
+	swap(compare, rhs.compare);
+	return *this;
+}
+
+// Utility method - Builds a node from pooled storage.
+template <class ElementType, class Compare>
+template <class... Args>
+typename PairingHeap<ElementType, Compare>::Node* PairingHeap<ElementType, Compare>::newNode(Args&&... args) {
+	void* slot = pool.acquire();
+	try {
+		return new (slot) Node(forward<Args>(args)...);
+	}
+	catch (...) {
+		pool.release(static_cast<Node*>(slot));
+		throw;
+	}
+}
+
+// Utility method - Destroys a node and gives its storage back to the pool.
+template <class ElementType, class Compare>
+void PairingHeap<ElementType, Compare>::deleteNode(Node* node) {
+	node->~Node();
+	pool.release(node);
+}
+
+// Utility method - Destroys every node in the tree rooted at "from".
+//                  Children are spliced into the sibling list as it is
+//                  walked, so no stack is needed.
+template <class ElementType, class Compare>
+void PairingHeap<ElementType, Compare>::destroyAll(Node* from) {
+	while (from != NULL) {
+		if (from->child != NULL) {
+			Node* lastChild = from->child;
+			while (lastChild->sibling != NULL)
+				lastChild = lastChild->sibling;
+			lastChild->sibling = from->sibling;
+			from->sibling = from->child;
+		}
+		Node* next = from->sibling;
+		deleteNode(from);
+		from = next;
+	}
+}
+
+// Utility method - Makes the root ranked after the other the leftmost child
+//                  of the other, and returns the remaining root. On a tie, a stays on top.
+template <class ElementType, class Compare>
+typename PairingHeap<ElementType, Compare>::Node* PairingHeap<ElementType, Compare>::link(Node* a, Node* b) {
+	if (compare(b->element, a->element))
+		swap(a, b);
+	b->sibling = a->child;
+	a->child = b;
+	return a;
+}
+
+// Utility method - Two-pass pairing of the sibling list starting at first.
+//                  The first pass links neighbours two by two, stacking the pairs
+//                  in reverse through their sibling links; the second pass links
+//                  that stack into one tree, so the pairs are merged right to left.
+template <class ElementType, class Compare>
+typename PairingHeap<ElementType, Compare>::Node* PairingHeap<ElementType, Compare>::mergePairs(Node* first) {
+	Node* pairs = NULL;
+	while (first != NULL) {
+		Node* a = first;
+		Node* b = a->sibling;
+		if (b == NULL) {
+			a->sibling = pairs;
+			pairs = a;
+			break;
+		}
+		first = b->sibling;
+		a->sibling = NULL;
+		b->sibling = NULL;
+		Node* linked = link(a, b);
+		linked->sibling = pairs;
+		pairs = linked;
+	}
+
+	if (pairs == NULL) return NULL;
+	Node* result = pairs;
+	pairs = pairs->sibling;
+	result->sibling = NULL;
+	while (pairs != NULL) {
+		Node* next = pairs->sibling;
+		pairs->sibling = NULL;
+		result = link(result, pairs);
+		pairs = next;
+	}
+	return result;
+}
+
+// Description: Returns "true" if this Pairing Heap is empty, otherwise "false".
+// Time Efficiency: O(1)
+template <class ElementType, class Compare>
+bool PairingHeap<ElementType, Compare>::isEmpty() const {
+	return elementCount == 0;
+}
+
+// Description: Returns the number of elements in the Pairing Heap.
+// Time Efficiency: O(1)
+template <class ElementType, class Compare>
+unsigned int PairingHeap<ElementType, Compare>::getElementCount() const {
+	return elementCount;
+}
+
+// Description: Inserts newElement in this Pairing Heap and
+//              returns "true" if successful, otherwise "false".
+// Time Efficiency: O(1) amortized
+template <class ElementType, class Compare>
+bool PairingHeap<ElementType, Compare>::enqueue(const ElementType& newElement) {
+	return emplace(newElement);
+}
+
+template <class ElementType, class Compare>
+bool PairingHeap<ElementType, Compare>::enqueue(ElementType&& newElement) {
+	return emplace(move(newElement));
+}
+
+// Description: Constructs a new element in place from args and inserts it.
+// Time Efficiency: O(1) amortized
+template <class ElementType, class Compare>
+template <class... Args>
+bool PairingHeap<ElementType, Compare>::emplace(Args&&... args) {
+	Node* node = newNode(forward<Args>(args)...);
+	root = (root == NULL) ? node : link(root, node);
+	elementCount++;
+	return true;
+}
+
+// Description: Removes (but does not return) the element with the next
+//              "highest" priority value from the Pairing Heap.
+// Precondition: This Pairing Heap is not empty.
+// Exception: Throws EmptyDataCollectionException if this Pairing Heap is empty.
+// Time Efficiency: O(log2 n) amortized
+template <class ElementType, class Compare>
+void PairingHeap<ElementType, Compare>::dequeue() {
+	if (elementCount == 0)
+		throw EmptyDataCollectionException("dequeue() called with an empty PairingHeap.");
+	Node* oldRoot = root;
+	root = mergePairs(oldRoot->child);
+	deleteNode(oldRoot);
+	elementCount--;
+}
+
+// Description: Removes and returns the element with the next
+//              "highest" priority value from the Pairing Heap.
+// Precondition: This Pairing Heap is not empty.
+// Exception: Throws EmptyDataCollectionException if this Pairing Heap is empty.
+// Time Efficiency: O(log2 n) amortized
+template <class ElementType, class Compare>
+ElementType PairingHeap<ElementType, Compare>::pop() {
+	if (elementCount == 0)
+		throw EmptyDataCollectionException("pop() called with an empty PairingHeap.");
+	ElementType top = move(root->element);
+	Node* oldRoot = root;
+	root = mergePairs(oldRoot->child);
+	deleteNode(oldRoot);
+	elementCount--;
+	return top;
+}
+
+// Description: Returns (but does not remove) the element with the next
+//              "highest" priority from the Pairing Heap.
+// Precondition: This Pairing Heap is not empty.
+// Exception: Throws EmptyDataCollectionException if this Pairing Heap is empty.
+// Time Efficiency: O(1)
+template <class ElementType, class Compare>
+const ElementType& PairingHeap<ElementType, Compare>::peek() const {
+	if (elementCount == 0)
+		throw EmptyDataCollectionException("peek() called with an empty PairingHeap.");
+	return root->element;
+}
+
+// Description: Moves every element of other into this Pairing Heap, together
+//              with the pool its nodes live in. other is left empty.
+// Time Efficiency: O(1)
+template <class ElementType, class Compare>
+void PairingHeap<ElementType, Compare>::meld(PairingHeap<ElementType, Compare>& other) {
+	if (this == &other) return;
+	if (other.root != NULL)
+		root = (root == NULL) ? other.root : link(root, other.root);
+	elementCount += other.elementCount;
+	pool.splice(other.pool);
+	other.root = NULL;
+	other.elementCount = 0;
+}
+
+//  End of implementation file.
\ No newline at end of file
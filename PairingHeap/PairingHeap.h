@@ -0,0 +1,145 @@
+/*
+ * PairingHeap.h
+ *
+ * Description: Meldable Priority Queue data collection ADT class.
+ *              Pointer-based Pairing Heap: a heap-ordered tree with any number
+ *              of children per node, kept as a first-child / next-sibling list.
+ *              Inserting and melding only link two roots; dequeuing pairs up
+ *              the root's children left to right, then links the pairs right
+ *              to left (two-pass pairing).
+ *              Nodes come from a NodePool, and meld() hands the other heap's
+ *              pool over to this one, so neither touches the global allocator.
+ *              Priority is decided by Compare (std::less by default, so the
+ *              smallest element comes out first; std::greater reverses it).
+ *
+ * Class Invariant:  Every node's element is not ranked after (by Compare) any element
+ *                   in its subtrees.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <functional>
+#include "NodePool.h"
+#include "EmptyDataCollectionException.h"
+
+using namespace std;
+
+template <class ElementType, class Compare = less<ElementType> >
+class PairingHeap {
+
+private:
+	struct Node {
+		ElementType element;
+		Node* child;      // Leftmost child
+		Node* sibling;    // Next sibling to the right
+
+		template <class... Args>
+		Node(Args&&... args) : element(forward<Args>(args)...), child(NULL), sibling(NULL) {}
+	};
+
+	Node* root;
+	unsigned int elementCount;
+	NodePool<Node> pool;
+	Compare compare;
+
+	// Utility methods - Build a node from pooled storage, and destroy one.
+	template <class... Args>
+	Node* newNode(Args&&... args);
+	void deleteNode(Node* node);
+
+	// Utility method - Makes the root ranked after the other the leftmost child
+	//                  of the other, and returns the remaining root.
+	// Precondition: Neither a nor b is NULL, and both have no siblings.
+	Node* link(Node* a, Node* b);
+
+	// Utility method - Two-pass pairing of the sibling list starting at first.
+	//                  Returns the root of the resulting tree (NULL if first is NULL).
+	Node* mergePairs(Node* first);
+
+	// Utility method - Destroys every node in the tree rooted at "from".
+	void destroyAll(Node* from);
+
+public:
+	/******* Start of Pairing Heap Public Interface *******/
+	// Default Constructor
+	PairingHeap(const Compare& compare = Compare());
+
+	// Copy Constructor
+	// Description: Copies the tree of aHeap node for node.
+	// Time Efficiency: O(n)
+	PairingHeap(const PairingHeap<ElementType, Compare>& aHeap);
+
+	// Move Constructor
+	// Description: Takes over the nodes of aHeap, which is left empty.
+	PairingHeap(PairingHeap<ElementType, Compare>&& aHeap) noexcept;
+
+	// Destructor
+	~PairingHeap();
+
+	// Assignment operator
+	PairingHeap<ElementType, Compare>& operator=(PairingHeap<ElementType, Compare> rhs);
+
+	// Description: Returns "true" if this Pairing Heap is empty, otherwise "false".
+	// Postcondition: This Pairing Heap is unchanged by this operation.
+	// Time Efficiency: O(1)
+	bool isEmpty() const;
+
+	// Description: Returns the number of elements in the Pairing Heap.
+	// Postcondition: This Pairing Heap is unchanged by this operation.
+	// Time Efficiency: O(1)
+	unsigned int getElementCount() const;
+
+	// Description: Inserts newElement in this Pairing Heap and
+	//              returns "true" if successful, otherwise "false".
+	// Time Efficiency: O(1) amortized
+	bool enqueue(const ElementType& newElement);
+	bool enqueue(ElementType&& newElement);
+
+	// Description: Constructs a new element in place from args and inserts it.
+	// Time Efficiency: O(1) amortized
+	template <class... Args>
+	bool emplace(Args&&... args);
+
+	// Description: Removes (but does not return) the element with the next
+	//              "highest" priority value from the Pairing Heap.
+	// Precondition: This Pairing Heap is not empty.
+	// Exception: Throws EmptyDataCollectionException if this Pairing Heap is empty.
+	// Time Efficiency: O(log2 n) amortized
+	void dequeue();
+
+	// Description: Removes and returns the element with the next
+	//              "highest" priority value from the Pairing Heap.
+	//              The element is moved out, not copied.
+	// Precondition: This Pairing Heap is not empty.
+	// Exception: Throws EmptyDataCollectionException if this Pairing Heap is empty.
+	// Time Efficiency: O(log2 n) amortized
+	ElementType pop();
+
+	// Description: Returns (but does not remove) the element with the next
+	//              "highest" priority from the Pairing Heap.
+	// Precondition: This Pairing Heap is not empty.
+	// Postcondition: This Pairing Heap is unchanged by this operation.
+	// Exception: Throws EmptyDataCollectionException if this Pairing Heap is empty.
+	// Time Efficiency: O(1)
+	const ElementType& peek() const;
+
+	// Description: Moves every element of other into this Pairing Heap, together
+	//              with the pool its nodes live in. other is left empty.
+	//              Both heaps are expected to use equivalent Compare objects.
+	// Postcondition: other is empty.
+	// Time Efficiency: O(1); at most one chunk's unused node slots are put on the
+	//                  pool's free list
+	void meld(PairingHeap<ElementType, Compare>& other);
+
+	/*******  End of Pairing Heap Public Interface *******/
+
+}; // end PairingHeap
+
+#include "PairingHeap.cpp"
@@ -0,0 +1,300 @@
+/* 
+ * AddressablePriorityQueue.cpp
+ *
+ * Description: Addressable Priority Queue data collection ADT class. 
+ *              Every element has a handle, kept in step with its position
+ *              in the Binary Heap by HandleTable.
+ *
+ * Class Invariant:  Always a Minimum Binary Heap
+ * 
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */  
+
+#include "AddressablePriorityQueue.h"
+
+    template <class ElementType, class Compare, class Stats>
+    const unsigned int AddressablePriorityQueue<ElementType, Compare, Stats>::HandleTable::NOT_QUEUED;
+
+    // Default Constructor
+    template <class ElementType, class Compare, class Stats>
+    AddressablePriorityQueue<ElementType, Compare, Stats>::AddressablePriorityQueue(const Compare& compare) : Queue(EntryCompare(compare)) {}
+
+    // Range Constructor
+    // Description: Builds the Priority Queue from the elements in [first, last)
+    //              with a bottom-up heap construction.
+    // Time Efficiency: O(n)
+    template <class ElementType, class Compare, class Stats>
+    template <class InputIterator>
+    AddressablePriorityQueue<ElementType, Compare, Stats>::AddressablePriorityQueue(InputIterator first, InputIterator last, const Compare& compare)
+        : Queue(EntryCompare(compare)) {
+        enqueueRange(first, last);
+    }
+    
+    // Description: Returns "true" if this Priority Queue is empty, otherwise "false".
+    // Postcondition: This Priority Queue is unchanged by this operation.
+    // Time Efficiency: O(1)
+    template <class ElementType, class Compare, class Stats>
+    bool AddressablePriorityQueue<ElementType, Compare, Stats>::isEmpty() const{
+        if(Queue.getElementCount() == 0){
+            return true;
+        }
+        return false;
+    }
+
+    // Description: Returns the number of elements in this Priority Queue.
+    // Time Efficiency: O(1)
+    template <class ElementType, class Compare, class Stats>
+    unsigned int AddressablePriorityQueue<ElementType, Compare, Stats>::getElementCount() const{
+        return Queue.getElementCount();
+    }
+
+    // Description: Inserts newElement in this Priority Queue and 
+    //              returns its handle.
+    template <class ElementType, class Compare, class Stats>
+    typename AddressablePriorityQueue<ElementType, Compare, Stats>::Handle AddressablePriorityQueue<ElementType, Compare, Stats>::enqueue(const ElementType& newElement){
+        return emplace(newElement);
+    }
+
+    // Description: Moves newElement into this Priority Queue and 
+    //              returns its handle.
+    template <class ElementType, class Compare, class Stats>
+    typename AddressablePriorityQueue<ElementType, Compare, Stats>::Handle AddressablePriorityQueue<ElementType, Compare, Stats>::enqueue(ElementType&& newElement){
+        return emplace(move(newElement));
+    }
+
+    // Description: Constructs a new element in place from args, inserts it
+    //              in this Priority Queue and returns its handle.
+    template <class ElementType, class Compare, class Stats>
+    template <class... Args>
+    typename AddressablePriorityQueue<ElementType, Compare, Stats>::Handle AddressablePriorityQueue<ElementType, Compare, Stats>::emplace(Args&&... args){
+        unsigned int slot = acquireSlot();
+        try {
+            Queue.emplace(slot, forward<Args>(args)...);
+        }
+        catch (...) {
+            // The entry never made it into the heap
+            if (!isQueuedSlot(slot))
+                releaseSlot(slot);
+            throw;
+        }
+        return handleOf(slot);
+    }
+
+    // Description: Inserts the elements in [first, last) in this Priority Queue.
+    // Time Efficiency: O(n + k) when k >= n, otherwise O(k log2 n)
+    template <class ElementType, class Compare, class Stats>
+    template <class InputIterator>
+    void AddressablePriorityQueue<ElementType, Compare, Stats>::enqueueRange(InputIterator first, InputIterator last){
+        // The elements are copied before any slot is given out, so a copy that
+        // throws leaves nothing to undo
+        vector<Entry> entries;
+        for (; first != last; ++first)
+            entries.push_back(Entry(0, *first));
+        unsigned int acquired = 0;
+        try {
+            for (; acquired < entries.size(); acquired++)
+                entries[acquired].slot = acquireSlot();
+            Queue.insertRange(make_move_iterator(entries.begin()), make_move_iterator(entries.end()));
+        }
+        catch (...) {
+            // Take back the slots of the entries that are not in the heap
+            for (unsigned int i = 0; i < acquired; i++)
+                if (!isQueuedSlot(entries[i].slot))
+                    releaseSlot(entries[i].slot);
+            throw;
+        }
+    }
+
+    // Description: Removes (but does not return) the element with the next
+    //              "highest" priority value from the Priority Queue.
+    // Precondition: This Priority Queue is not empty.
+    // Exception: Throws EmptyDataCollectionException if Priority Queue is empty.
+    template <class ElementType, class Compare, class Stats>
+    void AddressablePriorityQueue<ElementType, Compare, Stats>::dequeue(){
+        releaseSlot(Queue.pop().slot);
+    }
+
+    // Description: Removes and returns the element with the next
+    //              "highest" priority value from the Priority Queue.
+    //              The element is moved out, not copied.
+    // Precondition: This Priority Queue is not empty.
+    // Exception: Throws EmptyDataCollectionException if Priority Queue is empty.
+    template <class ElementType, class Compare, class Stats>
+    ElementType AddressablePriorityQueue<ElementType, Compare, Stats>::pop(){
+        Entry top = Queue.pop();
+        releaseSlot(top.slot);
+        return move(top.element);
+    }
+    
+    // Description: Returns (but does not remove) the element with the next 
+    //              "highest" priority from the Priority Queue.
+    // Precondition: This Priority Queue is not empty.
+    // Postcondition: This Priority Queue is unchanged by this operation.
+    // Exception: Throws EmptyDataCollectionException if this Priority Queue is empty.
+    template <class ElementType, class Compare, class Stats>
+    const ElementType& AddressablePriorityQueue<ElementType, Compare, Stats>::peek() const{
+        return Queue.retrieve().element;
+    }
+
+    // Description: Removes the element with the next "highest" priority and
+    //              inserts newElement with a single sift. Same result as
+    //              dequeue() followed by enqueue(newElement): the removed
+    //              element's handle is released, and the new handle of
+    //              newElement, which is returned, is never that one.
+    // Precondition: This Priority Queue is not empty.
+    // Exception: Throws EmptyDataCollectionException if this Priority Queue is empty.
+    // Time Efficiency: O(log2 n)
+    template <class ElementType, class Compare, class Stats>
+    typename AddressablePriorityQueue<ElementType, Compare, Stats>::Handle AddressablePriorityQueue<ElementType, Compare, Stats>::replaceTop(const ElementType& newElement){
+        if(isEmpty()){
+            throw EmptyDataCollectionException("replaceTop() called with an empty AddressablePriorityQueue.");
+        }
+        // The new slot is taken before the top's is released, so that newElement
+        // does not even share a slot with the handle released.
+        unsigned int slot = acquireSlot();
+        unsigned int top = Queue.retrieve().slot;
+        try {
+            Queue.replaceTop(Entry(slot, newElement));
+        }
+        catch (...) {
+            if (!isQueuedSlot(slot))
+                releaseSlot(slot);
+            throw;
+        }
+        releaseSlot(top);
+        return handleOf(slot);
+    }
+
+    // Description: Inserts newElement, then removes and returns the element
+    //              with the next "highest" priority. If that is newElement
+    //              itself, it is returned without touching the Priority Queue.
+    //              Otherwise the removed element's handle is released and
+    //              newElement gets a handle of its own, stored in *newHandle
+    //              (0 when newElement was returned) if newHandle is not NULL.
+    // Time Efficiency: O(1) when newElement is returned, otherwise O(log2 n)
+    template <class ElementType, class Compare, class Stats>
+    ElementType AddressablePriorityQueue<ElementType, Compare, Stats>::pushPop(const ElementType& newElement, Handle* newHandle){
+        if(isEmpty()){
+            if(newHandle != NULL) *newHandle = 0;
+            return newElement;
+        }
+        // As in replaceTop(), the new slot is never the one released.
+        unsigned int slot = acquireSlot();
+        bool pushed = false;
+        try {
+            Entry out = Queue.pushPop(Entry(slot, newElement));
+            pushed = true;
+            releaseSlot(out.slot);
+            if(newHandle != NULL) *newHandle = out.slot == slot ? 0 : handleOf(slot);
+            return move(out.element);
+        }
+        catch (...) {
+            if (!pushed && !isQueuedSlot(slot))
+                releaseSlot(slot);
+            throw;
+        }
+    }
+
+    // Description: Removes up to k elements in priority order, moving each one
+    //              to out, and returns the output iterator past the last one.
+    //              Uses Floyd's bottom-up deletion.
+    // Time Efficiency: O(k log2 n)
+    template <class ElementType, class Compare, class Stats>
+    template <class OutputIterator>
+    OutputIterator AddressablePriorityQueue<ElementType, Compare, Stats>::popN(unsigned int k, OutputIterator out){
+        ReleasingOutput<OutputIterator> releasing = { this, out };
+        return Queue.popN(k, releasing).out;
+    }
+
+    // Description: Returns "true" if handle refers to an element still in
+    //              this Priority Queue, otherwise "false": its slot must be
+    //              queued, and still be in handle's generation.
+    // Time Efficiency: O(1)
+    template <class ElementType, class Compare, class Stats>
+    bool AddressablePriorityQueue<ElementType, Compare, Stats>::isQueued(Handle handle) const{
+        const HandleTable& table = Queue.getTracker();
+        unsigned int slot = (unsigned int)handle;
+        return slot != 0 && slot < table.positions.size() && handleOf(slot) == handle && isQueuedSlot(slot);
+    }
+
+    // Description: Replaces the element referred to by handle with newElement,
+    //              whose priority may be higher or lower. The Binary Heap moves
+    //              it up or down, whichever way it is out of place.
+    // Exception: Throws ElementDoesNotExistException if handle is not queued.
+    // Time Efficiency: O(log2 n)
+    template <class ElementType, class Compare, class Stats>
+    void AddressablePriorityQueue<ElementType, Compare, Stats>::changeKey(Handle handle, const ElementType& newElement){
+        Queue.replaceAt(positionOf(handle), Entry((unsigned int)handle, newElement));
+    }
+
+    // Description: Removes the element referred to by handle.
+    // Exception: Throws ElementDoesNotExistException if handle is not queued.
+    // Time Efficiency: O(log2 n)
+    template <class ElementType, class Compare, class Stats>
+    void AddressablePriorityQueue<ElementType, Compare, Stats>::erase(Handle handle){
+        Queue.removeAt(positionOf(handle));
+        releaseSlot((unsigned int)handle);
+    }
+
+    // Description: Returns the Stats policy of the underlying Binary Heap.
+    // Time Efficiency: O(1)
+    template <class ElementType, class Compare, class Stats>
+    const Stats& AddressablePriorityQueue<ElementType, Compare, Stats>::getStats() const{
+        return Queue.getStats();
+    }
+
+    template <class ElementType, class Compare, class Stats>
+    void AddressablePriorityQueue<ElementType, Compare, Stats>::resetStats(){
+        Queue.getStats().reset();
+    }
+
+    // Utility method - Hands out an unused slot, recycling released ones first.
+    template <class ElementType, class Compare, class Stats>
+    unsigned int AddressablePriorityQueue<ElementType, Compare, Stats>::acquireSlot(){
+        HandleTable& table = Queue.getTracker();
+        if(!table.freeSlots.empty()){
+            unsigned int slot = table.freeSlots.back();
+            table.freeSlots.pop_back();
+            return slot;
+        }
+        table.generations.reserve(table.positions.size() + 1);
+        table.positions.push_back(HandleTable::NOT_QUEUED);
+        table.generations.push_back(0);
+        return table.positions.size() - 1;
+    }
+
+    // Utility method - Takes back the slot of an element that left the Priority
+    //                  Queue. Its next handle will be of the next generation, so
+    //                  the handle given out for that element stops being valid.
+    template <class ElementType, class Compare, class Stats>
+    void AddressablePriorityQueue<ElementType, Compare, Stats>::releaseSlot(unsigned int slot){
+        HandleTable& table = Queue.getTracker();
+        table.positions[slot] = HandleTable::NOT_QUEUED;
+        table.generations[slot]++;
+        table.freeSlots.push_back(slot);
+    }
+
+    // Utility method - Returns the handle of the slot's current generation.
+    template <class ElementType, class Compare, class Stats>
+    typename AddressablePriorityQueue<ElementType, Compare, Stats>::Handle AddressablePriorityQueue<ElementType, Compare, Stats>::handleOf(unsigned int slot) const{
+        return (Handle)Queue.getTracker().generations[slot] << 32 | slot;
+    }
+
+    // Utility method - Returns "true" if an entry with this slot is in the heap.
+    template <class ElementType, class Compare, class Stats>
+    bool AddressablePriorityQueue<ElementType, Compare, Stats>::isQueuedSlot(unsigned int slot) const{
+        return Queue.getTracker().positions[slot] != HandleTable::NOT_QUEUED;
+    }
+
+    // Utility method - Returns the index of the handle's entry in the heap array.
+    // Exception: Throws ElementDoesNotExistException if the handle is not queued.
+    template <class ElementType, class Compare, class Stats>
+    unsigned int AddressablePriorityQueue<ElementType, Compare, Stats>::positionOf(Handle handle) const{
+        if(!isQueued(handle)){
+            throw ElementDoesNotExistException("Handle does not refer to an element in the Priority Queue.");
+        }
+        return Queue.getTracker().positions[(unsigned int)handle];
+    }
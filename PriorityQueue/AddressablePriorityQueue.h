@@ -0,0 +1,220 @@
+/* 
+ * AddressablePriorityQueue.h
+ *
+ * Description: Addressable Priority Queue data collection ADT class. 
+ *              A Priority Queue where every element is given a handle when
+ *              it is enqueued, which can later be used to change its priority
+ *              or erase it. Keeping the handles up to date costs a table
+ *              write every time an element moves in the heap, so code that
+ *              does not need them should use PriorityQueue.
+ *              changeKey() both raises and lowers a priority: it stands for
+ *              the decreaseKey() and increaseKey() of textbook interfaces.
+ *              Priority is decided by Compare (std::less by default, so the
+ *              smallest element comes out first; std::greater reverses it).
+ *              Stats is passed on to the Binary Heap (see HeapStats).
+ *
+ * Class Invariant:  Always a Minimum Binary Heap
+ * 
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */  
+
+#pragma once
+
+#include <vector>
+#include "BinaryHeap.h"
+#include "ElementDoesNotExistException.h"
+
+template <class ElementType, class Compare = less<ElementType>, class Stats = NoHeapStats>
+class AddressablePriorityQueue {
+
+    public:
+        // Handle to an enqueued element. A handle is never 0 and stays valid
+        // until its element leaves the Priority Queue. Its low 32 bits name a
+        // slot of the handle table, which is reused, and its high 32 bits the
+        // slot's generation, which changes every time the slot is released: a
+        // handle kept after its element left is never valid again, even once
+        // its slot belongs to another element.
+        typedef unsigned long long Handle;
+
+    private:
+        // Heap entry: the element and the slot of its handle.
+        struct Entry {
+            ElementType element;
+            unsigned int slot;
+
+            template <class... Args>
+            Entry(unsigned int slot, Args&&... args) : element(forward<Args>(args)...), slot(slot) {}
+        };
+
+        // Orders heap entries by their elements only.
+        struct EntryCompare {
+            Compare compare;
+
+            EntryCompare(const Compare& compare = Compare()) : compare(compare) {}
+            bool operator()(const Entry& lhs, const Entry& rhs) const { return compare(lhs.element, rhs.element); }
+        };
+
+        // Tracker for the Binary Heap: keeps positions[slot] equal to the
+        // index of the slot's entry in the heap array.
+        class HandleTable {
+            public:
+                static const unsigned int NOT_QUEUED = ~0u;
+                vector<unsigned int> positions;    // positions[0] is never used
+                vector<unsigned int> generations;  // Generation of each slot's current handle
+                vector<unsigned int> freeSlots;
+
+                HandleTable() : positions(1, NOT_QUEUED), generations(1, 0) {}
+                void moved(const Entry& entry, unsigned int index) { positions[entry.slot] = index; }
+        };
+
+        BinaryHeap<Entry, 2, EntryCompare, HandleTable, Stats> Queue;
+
+        // Output iterator for popN(): releases the handle of every entry
+        // written to it and passes the element on to out.
+        template <class OutputIterator>
+        struct ReleasingOutput {
+            AddressablePriorityQueue<ElementType, Compare, Stats>* queue;
+            OutputIterator out;
+
+            ReleasingOutput& operator*() { return *this; }
+            ReleasingOutput& operator++() { return *this; }
+            ReleasingOutput& operator=(Entry&& entry) {
+                queue->releaseSlot(entry.slot);
+                *out = move(entry.element);
+                ++out;
+                return *this;
+            }
+        };
+
+        // Utility methods - Hand out and take back handle table slots. Releasing
+        //                   a slot moves it on to its next generation.
+        unsigned int acquireSlot();
+        void releaseSlot(unsigned int slot);
+
+        // Utility methods - Return the handle of a slot's current generation, and
+        //                   whether an entry with that slot is in the heap.
+        Handle handleOf(unsigned int slot) const;
+        bool isQueuedSlot(unsigned int slot) const;
+
+        // Utility method - Returns the index of the handle's entry in the heap array.
+        // Exception: Throws ElementDoesNotExistException if the handle is not queued.
+        unsigned int positionOf(Handle handle) const;
+
+    public:
+        /******* Start of Priority Queue Public Interface *******/
+        // Default Constructor
+        AddressablePriorityQueue(const Compare& compare = Compare());
+
+        // Range Constructor
+        // Description: Builds the Priority Queue from the elements in [first, last)
+        //              with a bottom-up heap construction.
+        // Time Efficiency: O(n)
+        template <class InputIterator>
+        AddressablePriorityQueue(InputIterator first, InputIterator last, const Compare& compare = Compare());
+
+        // Description: Returns "true" if this Priority Queue is empty, otherwise "false".
+        // Postcondition: This Priority Queue is unchanged by this operation.
+        // Time Efficiency: O(1)
+        bool isEmpty() const;
+
+        // Description: Returns the number of elements in this Priority Queue.
+        // Postcondition: This Priority Queue is unchanged by this operation.
+        // Time Efficiency: O(1)
+        unsigned int getElementCount() const;
+
+        // Description: Inserts newElement in this Priority Queue and 
+        //              returns its handle.
+        Handle enqueue(const ElementType& newElement);
+
+        // Description: Moves newElement into this Priority Queue and 
+        //              returns its handle.
+        Handle enqueue(ElementType&& newElement);
+
+        // Description: Constructs a new element in place from args, inserts it
+        //              in this Priority Queue and returns its handle.
+        template <class... Args>
+        Handle emplace(Args&&... args);
+
+        // Description: Inserts the elements in [first, last) in this Priority Queue.
+        // Time Efficiency: O(n + k) when k >= n, otherwise O(k log2 n)
+        template <class InputIterator>
+        void enqueueRange(InputIterator first, InputIterator last);
+
+        // Description: Removes (but does not return) the element with the next
+        //              "highest" priority value from the Priority Queue.
+        // Precondition: This Priority Queue is not empty.
+        // Exception: Throws EmptyDataCollectionException if Priority Queue is empty.
+        void dequeue();
+
+        // Description: Removes and returns the element with the next
+        //              "highest" priority value from the Priority Queue.
+        //              The element is moved out, not copied.
+        // Precondition: This Priority Queue is not empty.
+        // Exception: Throws EmptyDataCollectionException if Priority Queue is empty.
+        ElementType pop();
+        
+        // Description: Returns (but does not remove) the element with the next 
+        //              "highest" priority from the Priority Queue.
+        // Precondition: This Priority Queue is not empty.
+        // Postcondition: This Priority Queue is unchanged by this operation.
+        // Exception: Throws EmptyDataCollectionException if this Priority Queue is empty.
+        const ElementType& peek() const;
+
+        // Description: Removes the element with the next "highest" priority and
+        //              inserts newElement with a single sift. Same result as
+        //              dequeue() followed by enqueue(newElement): the removed
+        //              element's handle is released, and the new handle of
+        //              newElement, which is returned, is never that one.
+        // Precondition: This Priority Queue is not empty.
+        // Exception: Throws EmptyDataCollectionException if this Priority Queue is empty.
+        // Time Efficiency: O(log2 n)
+        Handle replaceTop(const ElementType& newElement);
+
+        // Description: Inserts newElement, then removes and returns the element
+        //              with the next "highest" priority. If that is newElement
+        //              itself, it is returned without touching the Priority Queue.
+        //              Otherwise the removed element's handle is released and
+        //              newElement gets a handle of its own. If newHandle is not
+        //              NULL, it is set to that handle, or to 0 when newElement
+        //              was returned.
+        // Time Efficiency: O(1) when newElement is returned, otherwise O(log2 n)
+        ElementType pushPop(const ElementType& newElement, Handle* newHandle = NULL);
+
+        // Description: Removes up to k elements in priority order, moving each one
+        //              to out, and returns the output iterator past the last one.
+        //              Uses Floyd's bottom-up deletion.
+        // Time Efficiency: O(k log2 n)
+        template <class OutputIterator>
+        OutputIterator popN(unsigned int k, OutputIterator out);
+        
+        // Description: Returns "true" if handle refers to an element still in
+        //              this Priority Queue, otherwise "false", also when handle's
+        //              slot has since been given to another element.
+        // Time Efficiency: O(1)
+        bool isQueued(Handle handle) const;
+
+        // Description: Replaces the element referred to by handle with newElement,
+        //              whose priority may be higher or lower: this is both
+        //              decreaseKey and increaseKey. The handle stays the same.
+        // Exception: Throws ElementDoesNotExistException if handle is not queued.
+        // Time Efficiency: O(log2 n)
+        void changeKey(Handle handle, const ElementType& newElement);
+
+        // Description: Removes the element referred to by handle.
+        // Exception: Throws ElementDoesNotExistException if handle is not queued.
+        // Time Efficiency: O(log2 n)
+        void erase(Handle handle);
+
+        // Description: Returns the Stats policy of the underlying Binary Heap,
+        //              e.g. getStats().snapshot() with HeapStats.
+        // Time Efficiency: O(1)
+        const Stats& getStats() const;
+        void resetStats();
+
+        /*******  End of Priority Queue Public Interface *******/
+};
+
+#include "AddressablePriorityQueue.cpp"
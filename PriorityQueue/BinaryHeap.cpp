@@ -3,6 +3,12 @@
  *
  * Description: Minimum Binary Heap data collection ADT class. 
  *              Binary implementation. Modified from Lab 8.
+ *              The number of children per node (Arity) is a template
+ *              parameter; Arity = 2 is the classic binary heap.
+ *              Tracker is told every time an element lands in a new slot.
+ *              Elements are ordered by Compare (std::less by default); the
+ *              "minimum" is the element Compare ranks first, so std::greater
+ *              turns this into a Maximum Binary Heap.
  *
  * Class Invariant:  Always a Minimum Binary Heap
  * 
@@ -17,71 +23,360 @@
 using namespace std;
 
 // Default Constructor
+// Description: Storage is only allocated by the first element.
 template <class ElementType>
-BinaryHeap<ElementType>::BinaryHeap() {
+HeapStorage<ElementType>::HeapStorage() {
    elementCount = 0;
-   capacity = INITIAL_CAPACITY;
-   elements = new ElementType[INITIAL_CAPACITY];
+   capacity = 0;
+   elements = NULL;
+}
+
+// Copy Constructor
+// Description: If an element cannot be copied, the elements copied so far
+//              are destroyed and the storage is released before rethrowing.
+template <class ElementType>
+HeapStorage<ElementType>::HeapStorage(const HeapStorage<ElementType>& aStorage) {
+   elementCount = 0;
+   capacity = 0;
+   elements = NULL;
+   reallocate(aStorage.elementCount);
+   try {
+      for (unsigned int i = 0; i < aStorage.elementCount; i++) {
+         new (&elements[i]) ElementType(aStorage.elements[i]);
+         elementCount++;
+      }
+   }
+   catch (...) {
+      // The destructor does not run for a constructor that throws
+      for (unsigned int i = 0; i < elementCount; i++)
+         elements[i].~ElementType();
+      if (elements != NULL)
+         allocator<ElementType>().deallocate(elements, capacity);
+      throw;
+   }
+}
+
+// Move Constructor
+// Description: Takes over the storage of aStorage, which is left empty.
+template <class ElementType>
+HeapStorage<ElementType>::HeapStorage(HeapStorage<ElementType>&& aStorage) noexcept {
+   elementCount = aStorage.elementCount;
+   capacity = aStorage.capacity;
+   elements = aStorage.elements;
+   aStorage.elementCount = 0;
+   aStorage.capacity = 0;
+   aStorage.elements = NULL;
+}
+
+// Destructor
+template <class ElementType>
+HeapStorage<ElementType>::~HeapStorage() {
+    for (unsigned int i = 0; i < elementCount; i++)
+        elements[i].~ElementType();
+    if (elements != NULL)
+        allocator<ElementType>().deallocate(elements, capacity);
+}
+
+// Description: Exchanges the storage of this and other.
+template <class ElementType>
+void HeapStorage<ElementType>::swapStorage(HeapStorage<ElementType>& other) noexcept {
+	swap(elementCount, other.elementCount);
+	swap(capacity, other.capacity);
+	swap(elements, other.elements);
+}
+
+// Description: Moves the constructed elements into new raw storage able to
+//              hold newCapacity elements. The old elements are only destroyed
+//              once all of them are in the new storage, so if one cannot be
+//              copied (elements whose move may throw are copied), the storage
+//              is left as it was.
+template <class ElementType>
+void HeapStorage<ElementType>::reallocate(unsigned int newCapacity) {
+	ElementType* newElements = NULL;
+	if (newCapacity > 0)
+		newElements = allocator<ElementType>().allocate(newCapacity);
+	unsigned int moved = 0;
+	try {
+		for (; moved < elementCount; moved++)
+			new (&newElements[moved]) ElementType(move_if_noexcept(elements[moved]));
+	}
+	catch (...) {
+		for (unsigned int i = 0; i < moved; i++)
+			newElements[i].~ElementType();
+		allocator<ElementType>().deallocate(newElements, newCapacity);
+		throw;
+	}
+	for (unsigned int i = 0; i < elementCount; i++)
+		elements[i].~ElementType();
+	if (elements != NULL)
+		allocator<ElementType>().deallocate(elements, capacity);
+	elements = newElements;
+	capacity = newCapacity;
+}
+
+// Description: Returns the capacity to grow full storage to: double the
+//              current one, without overflowing unsigned int.
+// Exceptions: Throws length_error if the storage cannot grow any further.
+template <class ElementType>
+unsigned int HeapStorage<ElementType>::grownCapacity() const {
+	const unsigned int maxCapacity = numeric_limits<unsigned int>::max();
+	if (capacity == 0)
+		return INITIAL_CAPACITY;
+	if (capacity == maxCapacity)
+		throw length_error("Heap storage cannot hold more elements.");
+	return capacity > maxCapacity/2 ? maxCapacity : 2*capacity;
+}
+
+// Description: Constructs a new element from args at elements[elementCount],
+//              growing the storage first if it is full, and counts it.
+// Time Efficiency: O(1) amortized
+template <class ElementType>
+template <class... Args>
+void HeapStorage<ElementType>::emplaceBack(Args&&... args) {
+	if (elementCount == capacity) {
+		// args may refer to an element of this storage, so build the new
+		// element before the old storage is released.
+		ElementType newElement(forward<Args>(args)...);
+		reallocate(grownCapacity());
+		new (&elements[elementCount]) ElementType(move(newElement));
+	}
+	else {
+		new (&elements[elementCount]) ElementType(forward<Args>(args)...);
+	}
+	elementCount++;
+}
+
+// Default Constructor
+// Description: Storage is only allocated by the first insertion.
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::BinaryHeap(const Compare& compare) : compare(compare) {
    
 } // end of default constructor
 
+// Range Constructor
+// Description: Builds the Binary Heap from the elements in [first, last)
+//              using Floyd's bottom-up construction.
+// Time Efficiency: O(n)
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+template <class InputIterator>
+BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::BinaryHeap(InputIterator first, InputIterator last, const Compare& compare)
+   : compare(compare) {
+   insertRange(first, last);
+
+} // end of range constructor
+
+// Copy Constructor
+// Description: HeapStorage cleans up if an element cannot be copied.
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::BinaryHeap(const BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>& aHeap)
+   : HeapStorage<ElementType>(aHeap), compare(aHeap.compare) {
+   tracker = aHeap.tracker;
+   stats = aHeap.stats;
+
+} // end of copy constructor
+
+// Move Constructor
+// Description: Takes over the storage of aHeap, which is left empty.
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::BinaryHeap(BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>&& aHeap) noexcept
+   : HeapStorage<ElementType>(move(aHeap)), compare(move(aHeap.compare)) {
+   tracker = move(aHeap.tracker);
+   stats = move(aHeap.stats);
+
+} // end of move constructor
+
 // Destructor
-template <class ElementType>
-BinaryHeap<ElementType>::~BinaryHeap(){
-    delete[] elements;
+// Description: HeapStorage destroys the elements.
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::~BinaryHeap(){
+}
+
+// Assignment operator
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>& BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::operator=(const BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>& rhs) {
+	if (this != &rhs) {
+		BinaryHeap<ElementType, Arity, Compare, Tracker, Stats> copy(rhs);
+		this->swapStorage(copy);
+		swap(tracker, copy.tracker);
+		swap(stats, copy.stats);
+		swap(compare, copy.compare);
+	}
+	return *this;
+}
+
+// Move assignment operator
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>& BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::operator=(BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>&& rhs) noexcept {
+	this->swapStorage(rhs);
+	swap(tracker, rhs.tracker);
+	swap(stats, rhs.stats);
+	swap(compare, rhs.compare);
+	return *this;
+}
+
+// Utility method - Moves the constructed elements into new raw storage
+//                  able to hold newCapacity elements, and counts it.
+//                  The Binary Heap is left as it was if an element cannot be moved.
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+void BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::reallocate(unsigned int newCapacity) {
+	HeapStorage<ElementType>::reallocate(newCapacity);
+	stats.reallocated();
 }
 	
 // Description: Returns the number of elements in the Binary Heap.
 // Postcondition:  The Binary Heap is unchanged by this operation.
 // Time Efficiency: O(1)
-template <class ElementType>
-unsigned int BinaryHeap<ElementType>::getElementCount() const {
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+unsigned int BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::getElementCount() const {
    return elementCount;
 }  // end getElementCount
 
 
+// Description: Returns the number of elements the Binary Heap can hold
+//              before its storage has to grow.
+// Postcondition:  The Binary Heap is unchanged by this operation.
+// Time Efficiency: O(1)
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+unsigned int BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::getCapacity() const {
+   return capacity;
+}  // end getCapacity
+
+
+// Description: Grows the storage so it holds at least newCapacity elements
+//              without reallocating. Never shrinks the storage.
+// Postcondition: The elements of the Binary Heap are unchanged.
+// Time Efficiency: O(n)
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+void BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::reserve(unsigned int newCapacity) {
+	if (newCapacity > capacity)
+		reallocate(newCapacity);
+}  // end reserve
+
+
+// Description: Releases unused storage so the capacity matches the element count.
+// Postcondition: The elements of the Binary Heap are unchanged.
+// Time Efficiency: O(n)
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+void BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::shrink_to_fit() {
+	if (capacity > elementCount)
+		reallocate(elementCount);
+}  // end shrink_to_fit
+
+
 // Description: Inserts newElement into the Binary Heap.
 //              It returns "true" if successful, otherwise "false".        
+//              The storage doubles in size whenever it is full.
 // Postcondition: Remains a Minimum Binary Heap after the insertion.
-// Time Efficiency: O(log2 n)
-template <class ElementType>
-bool BinaryHeap<ElementType>::insert(ElementType& newElement) {
-	unsigned int indexOfRoot = 0;
+// Time Efficiency: O(logd n) amortized, where d is Arity
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+bool BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::insert(const ElementType& newElement) {
+	return emplace(newElement);
+
+} // end insert
+
+// Description: Moves newElement into the Binary Heap.
+// Postcondition: Remains a Minimum Binary Heap after the insertion.
+// Time Efficiency: O(logd n) amortized, where d is Arity
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+bool BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::insert(ElementType&& newElement) {
+	return emplace(move(newElement));
+
+} // end insert
+
+// Description: Constructs a new element in place from args and inserts it
+//              into the Binary Heap. Returns "true" if successful.
+// Postcondition: Remains a Minimum Binary Heap after the insertion.
+// Time Efficiency: O(logd n) amortized, where d is Arity
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+template <class... Args>
+bool BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::emplace(Args&&... args) {
 	unsigned int indexOfBack = elementCount;
-    bool ableToInsert = false;
-	if(elementCount == 0){
-		elements[0] = newElement;
-		elementCount++;
-		return true;
-	}
-	elementCount++;
-	elements[indexOfBack] = newElement;
+	unsigned int oldCapacity = capacity;
+	this->emplaceBack(forward<Args>(args)...);
+	if (capacity != oldCapacity)
+		stats.reallocated();
+	placed(indexOfBack);
+	stats.inserted(elementCount);
     reHeapUp(indexOfBack);
-	if(elements[indexOfRoot] <= elements[indexOfBack]){
-    	ableToInsert = true;
-	}
 	
-    return ableToInsert;
+    return true;
 
-} // end insert
+} // end emplace
 
 
-// Utility method - Recursively put the array back into a Minimum Binary Heap.
-template <class ElementType>
-void BinaryHeap<ElementType>::reHeapUp(unsigned int indexOfBottom) {
-	unsigned int indexOfRoot = 0;
-    if(indexOfBottom != indexOfRoot){
+// Description: Inserts the elements in [first, last) into the Binary Heap.
+//              A batch at least as large as the heap is appended and the
+//              whole array is rebuilt bottom-up; a smaller batch is sifted
+//              up one element at a time.
+// Postcondition: Remains a Minimum Binary Heap after the insertion.
+// Time Efficiency: O(n + k) when k >= n, otherwise O(k logd n)
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+template <class InputIterator>
+void BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::insertRange(InputIterator first, InputIterator last) {
+	unsigned int oldCount = elementCount;
+	try {
+		for (; first != last; ++first) {
+			unsigned int oldCapacity = capacity;
+			this->emplaceBack(*first);
+			if (capacity != oldCapacity)
+				stats.reallocated();
+			placed(elementCount - 1);
+			stats.inserted(elementCount);
+		}
+	}
+	catch (...) {
+		// Keep the elements appended so far, but in heap order
+		for (unsigned int i = oldCount; i < elementCount; i++)
+			reHeapUp(i);
+		throw;
+	}
+
+	if (elementCount - oldCount >= oldCount) {
+		heapify();
+	}
+	else {
+		for (unsigned int i = oldCount; i < elementCount; i++)
+			reHeapUp(i);
+	}
+
+} // end insertRange
 
-        int indexOfParent = floor((indexOfBottom - 1)/2);
 
-        if(elements[indexOfBottom] <= elements[indexOfParent]){
-            ElementType temp = elements[indexOfParent];
-	        elements[indexOfParent] = elements[indexOfBottom];
-	        elements[indexOfBottom] = temp;
-            reHeapUp(indexOfParent);
-        }
+// Utility method - Floyd's bottom-up construction: sifts down every
+//                  internal node, from the last one back to the root.
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+void BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::heapify() {
+	if (elementCount < 2) return;
+	for (unsigned int i = parentOf(elementCount - 1) + 1; i > 0; i--)
+		reHeapDown(i - 1);
+
+} // end heapify
+
+
+// Utility method - Put the array back into a Minimum Binary Heap by moving
+//                  the bottom element up. Parents are moved down into the
+//                  hole instead of being swapped, and the bottom element is
+//                  moved once into its final slot.
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+void BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::reHeapUp(unsigned int indexOfBottom) {
+	unsigned int indexOfRoot = 0;
+    if(indexOfBottom == indexOfRoot || !above(elements[indexOfBottom], elements[parentOf(indexOfBottom)])){
+        stats.sifted(0);
+        return;
     }
-	return;
+
+    ElementType bottom = move(elements[indexOfBottom]);
+    unsigned int levels = 0;
+    do {
+        unsigned int indexOfParent = parentOf(indexOfBottom);
+        elements[indexOfBottom] = move(elements[indexOfParent]);
+        placed(indexOfBottom);
+        indexOfBottom = indexOfParent;
+        levels++;
+    } while(indexOfBottom != indexOfRoot && above(bottom, elements[parentOf(indexOfBottom)]));
+    elements[indexOfBottom] = move(bottom);
+    placed(indexOfBottom);
+    stats.sifted(levels);
 	
 } // end reHeapUp
 
@@ -90,70 +385,336 @@ void BinaryHeap<ElementType>::reHeapUp(unsigned int indexOfBottom) {
 // Precondition: This Binary Heap is not empty.
 // Postcondition: Remains a Minimum Binary Heap after the removal.	
 // Exceptions: Throws EmptyDataCollectionException if this Binary Heap is empty.
-// Time Efficiency: O(log2 n)
-template <class ElementType>
-void BinaryHeap<ElementType>::remove() {
-	unsigned int indexOfRoot = 0;
+// Time Efficiency: O(d logd n), where d is Arity
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+void BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::remove() {
 	if(elementCount == 0){
 		throw(EmptyDataCollectionException("remove() called with an empty BinaryHeap."));
 	}
-	elements[indexOfRoot] = elements[elementCount-1];
-    reHeapDown(indexOfRoot);
-    elementCount--;
+	removeRoot();
 
 	return;
 	
 }  // end remove
 
 
-// Utility method - Recursively put the array back into a Minimum Binary Heap.
-template <class ElementType>
-void BinaryHeap<ElementType>::reHeapDown(unsigned int indexOfRoot) {
+// Description: Removes and returns the element located at the root.
+//              The element is moved out, not copied.
+// Precondition: This Binary Heap is not empty.
+// Postcondition: Remains a Minimum Binary Heap after the removal.	
+// Exceptions: Throws EmptyDataCollectionException if this Binary Heap is empty.
+// Time Efficiency: O(d logd n), where d is Arity
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+ElementType BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::pop() {
+	if(elementCount == 0){
+		throw(EmptyDataCollectionException("pop() called with an empty BinaryHeap."));
+	}
+	ElementType top = move(elements[0]);
+	removeRoot();
 
-	unsigned int indexOfMinChild = indexOfRoot;
+	return top;
 	
-	// Find indices of children.
-	unsigned int indexOfLeftChild = 2*indexOfRoot+1;
-	unsigned int indexOfRightChild = 2*indexOfRoot+2;
-
-    // Base case: elements[indexOfRoot] is a leaf as it has no children
-	if (indexOfLeftChild > elementCount-1) return;
-
-	// If we need to swap, select the smallest child
-    // if (elements[indexOfRoot] > elements[indexOfLeftChild])
-	if ( ! (elements[indexOfRoot] <= elements[indexOfLeftChild]) )
-    	indexOfMinChild = indexOfLeftChild;
-
-    // Check if there is a right child, is it the smallest?
-    if (indexOfRightChild < elementCount) {
-		// if (elements[indexOfMinChild] > elements[indexOfRightChild])
-		if ( ! (elements[indexOfMinChild] <= elements[indexOfRightChild]) )
-		    indexOfMinChild = indexOfRightChild;
-	}
-
-	// Swap parent with smallest of children.
-	if (indexOfMinChild != indexOfRoot) {
-		
-	   ElementType temp = elements[indexOfRoot];
-	   elements[indexOfRoot] = elements[indexOfMinChild];
-	   elements[indexOfMinChild] = temp;
-	   
-	   // Recursively put the array back into a heap
-	   reHeapDown(indexOfMinChild);
+}  // end pop
+
+
+// Description: Removes and returns the element located at the root, and
+//              inserts newElement in its place with a single reHeapDown.
+//              Same result as pop() followed by insert(newElement).
+// Precondition: This Binary Heap is not empty.
+// Exceptions: Throws EmptyDataCollectionException if this Binary Heap is empty.
+// Time Efficiency: O(d logd n), where d is Arity
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+ElementType BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::replaceTop(const ElementType& newElement) {
+	if(elementCount == 0){
+		throw(EmptyDataCollectionException("replaceTop() called with an empty BinaryHeap."));
+	}
+	// newElement may be the root itself, so it is copied before the root moves out
+	return replaceTop(ElementType(newElement));
+
+}  // end replaceTop
+
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+ElementType BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::replaceTop(ElementType&& newElement) {
+	if(elementCount == 0){
+		throw(EmptyDataCollectionException("replaceTop() called with an empty BinaryHeap."));
+	}
+	ElementType top = move(elements[0]);
+	elements[0] = move(newElement);
+	placed(0);
+	stats.replaced();
+	reHeapDown(0);
+
+	return top;
+
+}  // end replaceTop
+
+
+// Description: Inserts newElement, then removes and returns the element located
+//              at the root. If newElement would be the new root, it is returned
+//              straight away and the Binary Heap is not touched.
+// Time Efficiency: O(1) when newElement is returned, otherwise O(d logd n)
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+ElementType BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::pushPop(const ElementType& newElement) {
+	if(elementCount == 0 || !above(elements[0], newElement)){
+		return newElement;
+	}
+	return replaceTop(newElement);
+
+}  // end pushPop
+
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+ElementType BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::pushPop(ElementType&& newElement) {
+	if(elementCount == 0 || !above(elements[0], newElement)){
+		return move(newElement);
+	}
+	return replaceTop(move(newElement));
+
+}  // end pushPop
+
+
+// Description: Removes up to k elements from the root, in order, moving each
+//              one to out. Uses Floyd's bottom-up deletion. Returns the output
+//              iterator one past the last element written.
+// Postcondition: Remains a Minimum Binary Heap after the removals.
+// Time Efficiency: O(k d logd n), where d is Arity
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+template <class OutputIterator>
+OutputIterator BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::popN(unsigned int k, OutputIterator out) {
+	for(; k > 0 && elementCount > 0; k--){
+		*out = move(elements[0]);
+		++out;
+		removeRootBottomUp();
+	}
+
+	return out;
+
+}  // end popN
+
+
+// Description: Sorts the elements in place, root first, and calls
+//              write(sorted, count). The Binary Heap is emptied only once
+//              write returns; if it throws, every element is kept.
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+template <class Function>
+void BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::drainSorted(Function write) {
+	unsigned int count = elementCount;
+
+	// Heap sort: the root goes to the end of the shrinking heap, leaving the
+	// array in reverse order, and is then reversed into heap order again.
+	try {
+		for (unsigned int indexOfBack = count; indexOfBack > 1; indexOfBack--) {
+			swap(elements[0], elements[indexOfBack - 1]);
+			elementCount = indexOfBack - 1;
+			reHeapDown(0);
+		}
+	}
+	catch (...) {
+		elementCount = count;
+		heapify();
+		for (unsigned int i = 0; i < count; i++)
+			placed(i);
+		throw;
+	}
+	elementCount = count;
+	reverse(elements, elements + count);
+	for (unsigned int i = 0; i < count; i++)
+		placed(i);
+
+	write(static_cast<const ElementType*>(elements), count);
+
+	for (unsigned int i = 0; i < count; i++) {
+		elements[i].~ElementType();
+		stats.removed();
+	}
+	elementCount = 0;
+
+}  // end drainSorted
+
+
+// Description: Calls update(element) on every element, in array order. update
+//              must not change how the elements compare with one another.
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+template <class Function>
+void BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::updateEach(Function update) {
+	for (unsigned int i = 0; i < elementCount; i++)
+		update(elements[i]);
+
+}  // end updateEach
+
+
+// Utility method - Replaces the root with the last element and sifts it down.
+// Precondition: This Binary Heap is not empty.
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+void BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::removeRoot() {
+	unsigned int indexOfRoot = 0;
+	unsigned int indexOfBack = elementCount - 1;
+	if(indexOfBack != indexOfRoot){
+		elements[indexOfRoot] = move(elements[indexOfBack]);
+		placed(indexOfRoot);
+	}
+	elements[indexOfBack].~ElementType();
+    elementCount--;
+    stats.removed();
+    if(elementCount > 1){
+        reHeapDown(indexOfRoot);
     }
 
-	return;
-	
+}  // end removeRoot
+
+
+// Utility method - Floyd's bottom-up deletion of the root, whose element has
+//                  already been moved out: the hole walks down to a leaf along
+//                  the smallest children, then the last element fills it and
+//                  moves up. Saves about one comparison per level over removeRoot().
+// Precondition: This Binary Heap is not empty.
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+void BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::removeRootBottomUp() {
+	unsigned int indexOfBack = elementCount - 1;
+	stats.removed();
+	if(indexOfBack == 0){
+		elements[0].~ElementType();
+		elementCount--;
+		return;
+	}
+	ElementType back = move(elements[indexOfBack]);
+	elements[indexOfBack].~ElementType();
+	elementCount--;
+
+	unsigned int indexOfHole = 0;
+	unsigned int levels = 0;
+	unsigned int indexOfMinChild = indexOfSmallestChild(indexOfHole);
+	while(indexOfMinChild != elementCount){
+		elements[indexOfHole] = move(elements[indexOfMinChild]);
+		placed(indexOfHole);
+		indexOfHole = indexOfMinChild;
+		indexOfMinChild = indexOfSmallestChild(indexOfHole);
+		levels++;
+	}
+	elements[indexOfHole] = move(back);
+	placed(indexOfHole);
+	stats.sifted(levels);
+	reHeapUp(indexOfHole);
+
+}  // end removeRootBottomUp
+
+
+// Description: Removes the element at elements[index].
+// Precondition: index < getElementCount().
+// Postcondition: Remains a Minimum Binary Heap after the removal.
+// Time Efficiency: O(d logd n), where d is Arity
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+void BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::removeAt(unsigned int index) {
+	unsigned int indexOfBack = elementCount - 1;
+	stats.removed();
+	if(index == indexOfBack){
+		elements[indexOfBack].~ElementType();
+		elementCount--;
+		return;
+	}
+	elements[index] = move(elements[indexOfBack]);
+	elements[indexOfBack].~ElementType();
+	elementCount--;
+	placed(index);
+	reHeapAt(index);
+
+}  // end removeAt
+
+
+// Description: Replaces the element at elements[index] with newElement, which
+//              may be smaller or larger than the element it replaces.
+// Precondition: index < getElementCount().
+// Postcondition: Remains a Minimum Binary Heap after the replacement.
+// Time Efficiency: O(d logd n), where d is Arity
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+void BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::replaceAt(unsigned int index, ElementType&& newElement) {
+	elements[index] = move(newElement);
+	placed(index);
+	stats.replaced();
+	reHeapAt(index);
+
+}  // end replaceAt
+
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+void BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::replaceAt(unsigned int index, const ElementType& newElement) {
+	elements[index] = newElement;
+	placed(index);
+	stats.replaced();
+	reHeapAt(index);
+
+}  // end replaceAt
+
+
+// Utility method - Moves elements[index] up or down, whichever way it is out of place.
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+void BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::reHeapAt(unsigned int index) {
+	if(index != 0 && above(elements[index], elements[parentOf(index)])){
+		reHeapUp(index);
+	}
+	else{
+		reHeapDown(index);
+	}
+
+}  // end reHeapAt
+
+
+// Utility method - Put the array back into a Minimum Binary Heap by moving
+//                  the root element down. The smallest child is moved up into
+//                  the hole at each level, and the root element is moved once
+//                  into its final slot.
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+void BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::reHeapDown(unsigned int indexOfRoot) {
+
+	unsigned int indexOfMinChild = indexOfSmallestChild(indexOfRoot);
+
+    // Base case: elements[indexOfRoot] is a leaf, or no child is smaller
+	if (indexOfMinChild == elementCount || !above(elements[indexOfMinChild], elements[indexOfRoot])) {
+		stats.sifted(0);
+		return;
+	}
+
+	ElementType root = move(elements[indexOfRoot]);
+	unsigned int levels = 0;
+	do {
+		elements[indexOfRoot] = move(elements[indexOfMinChild]);
+		placed(indexOfRoot);
+		indexOfRoot = indexOfMinChild;
+		indexOfMinChild = indexOfSmallestChild(indexOfRoot);
+		levels++;
+	} while (indexOfMinChild != elementCount && above(elements[indexOfMinChild], root));
+	elements[indexOfRoot] = move(root);
+	placed(indexOfRoot);
+	stats.sifted(levels);
+
 } // end reHeapDown
 
 
+// Utility method - Returns the index of the smallest child of elements[indexOfParent],
+//                  or elementCount if it is a leaf.
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+unsigned int BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::indexOfSmallestChild(unsigned int indexOfParent) const {
+
+	// Find indices of children. They are stored next to each other.
+	size_t indexOfFirstChild = firstChildOf(indexOfParent);
+	if (indexOfFirstChild >= elementCount) return elementCount;
+	unsigned int indexOfLastChild = indexOfFirstChild + Arity < elementCount ? indexOfFirstChild + Arity : elementCount;
+
+	unsigned int indexOfMinChild = indexOfFirstChild;
+	for (unsigned int indexOfChild = indexOfMinChild + 1; indexOfChild < indexOfLastChild; indexOfChild++) {
+		if (above(elements[indexOfChild], elements[indexOfMinChild]))
+			indexOfMinChild = indexOfChild;
+	}
+	return indexOfMinChild;
+
+} // end indexOfSmallestChild
+
+
 // Description: Retrieves (but does not remove) the element located at the root.
 // Precondition: This Binary Heap is not empty.
 // Postcondition: This Binary Heap is unchanged.
 // Exceptions: Throws EmptyDataCollectionException if this Binary Heap is empty.
 // Time Efficiency: O(1) 
-template <class ElementType>
-ElementType BinaryHeap<ElementType>::retrieve() const {
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+const ElementType& BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::retrieve() const {
    
    // Enforce precondition
    if ( elementCount > 0 )
@@ -164,4 +725,29 @@ ElementType BinaryHeap<ElementType>::retrieve() const {
 }  // end retrieve
 
 
+// Description: Returns the Tracker told about every element move.
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+Tracker& BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::getTracker() {
+   return tracker;
+}  // end getTracker
+
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+const Tracker& BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::getTracker() const {
+   return tracker;
+}  // end getTracker
+
+
+// Description: Returns the Stats policy, which has counted every comparison,
+//              placement, sift, insertion, removal and reallocation.
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+Stats& BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::getStats() {
+   return stats;
+}  // end getStats
+
+template <class ElementType, unsigned int Arity, class Compare, class Tracker, class Stats>
+const Stats& BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>::getStats() const {
+   return stats;
+}  // end getStats
+
+
 //  End of implementation file.
\ No newline at end of file
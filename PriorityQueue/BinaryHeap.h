@@ -3,6 +3,14 @@
  *
  * Description: Minimum Binary Heap data collection ADT class. 
  *              Binary implementation. Modified from Lab 8.
+ *              The number of children per node (Arity) is a template
+ *              parameter; Arity = 2 is the classic binary heap.
+ *              Tracker is told every time an element lands in a new slot.
+ *              Elements are ordered by Compare (std::less by default); the
+ *              "minimum" is the element Compare ranks first, so std::greater
+ *              turns this into a Maximum Binary Heap.
+ *              Stats counts what the heap does; the default NoHeapStats
+ *              counts nothing and costs nothing.
  *
  * Class Invariant:  Always a Minimum Binary Heap
  * 
@@ -16,57 +24,341 @@
 #pragma once
 
 #include <iostream>
+#include <algorithm>
 #include <cmath>
+#include <memory>
+#include <utility>
+#include <functional>
+#include <limits>
+#include <stdexcept>
 #include "EmptyDataCollectionException.h"   // To do: Feel free to recycle an exception class from Assignment 3.
 
 using namespace std;
 
+// Default Tracker: the Binary Heap does not report element positions.
+// A Tracker provides moved(element, index), called whenever "element" is
+// placed at elements[index]. This lets a container built on the Binary
+// Heap find its elements again, e.g. for decreaseKey().
+struct NoPositionTracking {
+	template <class ElementType>
+	void moved(const ElementType&, unsigned int) {}
+};
+
+// Counts collected by HeapStats.
+struct HeapStatsSnapshot {
+	static const unsigned int SIFT_DEPTHS = 33;     // Enough levels for 2^32 elements
+	unsigned long long comparisons;
+	unsigned long long moves;                       // Elements placed in a slot
+	unsigned long long insertions;
+	unsigned long long removals;
+	unsigned long long replacements;
+	unsigned long long reallocations;
+	unsigned int peakSize;
+	unsigned long long siftDepths[SIFT_DEPTHS];     // siftDepths[d]: sifts that moved an element d levels
+};
+
+// Default Stats: nothing is counted, and every call compiles away.
+// A Stats policy is told about every comparison, placement, sift,
+// insertion, removal, replacement and reallocation.
+struct NoHeapStats {
+	void compared() {}
+	void moved() {}
+	void sifted(unsigned int) {}
+	void inserted(unsigned int) {}
+	void removed() {}
+	void replaced() {}
+	void reallocated() {}
+	HeapStatsSnapshot snapshot() const { return HeapStatsSnapshot(); }
+	void reset() {}
+};
+
+// Stats that count: pass as the Stats parameter to see how a heap behaves.
+class HeapStats {
+	HeapStatsSnapshot counts;
+public:
+	HeapStats() : counts() {}
+	void compared() { counts.comparisons++; }
+	void moved() { counts.moves++; }
+	void sifted(unsigned int levels) {
+		counts.siftDepths[levels < HeapStatsSnapshot::SIFT_DEPTHS ? levels : HeapStatsSnapshot::SIFT_DEPTHS - 1]++;
+	}
+	void inserted(unsigned int size) {
+		counts.insertions++;
+		if (size > counts.peakSize) counts.peakSize = size;
+	}
+	void removed() { counts.removals++; }
+	void replaced() { counts.replacements++; }
+	void reallocated() { counts.reallocations++; }
+
+	// Description: Returns a copy of the counts so far.
+	HeapStatsSnapshot snapshot() const { return counts; }
+
+	// Description: Sets every count back to 0.
+	void reset() { counts = HeapStatsSnapshot(); }
+};
+
+// Growable raw storage for the heaps kept in an implicit array (BinaryHeap,
+// MinMaxHeap), which inherit it. Only elements[0 .. elementCount-1] are
+// constructed; the storage doubles in size whenever it is full.
 template <class ElementType>
-class BinaryHeap {
+class HeapStorage {
 
-private:
-    // To do: Add the data members here!
-	unsigned int INITIAL_CAPACITY = 50;
+protected:
+	static const unsigned int INITIAL_CAPACITY = 50;
 	unsigned int elementCount;
 	unsigned int capacity;
-	ElementType *elements;
+	ElementType *elements;    // Raw storage: only elements[0 .. elementCount-1] are constructed
+
+	// Default Constructor
+	// Description: Storage is only allocated by the first element.
+	HeapStorage();
+
+	// Copy Constructor
+	// Description: If an element cannot be copied, the elements copied so far
+	//              are destroyed and the storage is released before rethrowing.
+	HeapStorage(const HeapStorage<ElementType>& aStorage);
+
+	// Move Constructor
+	// Description: Takes over the storage of aStorage, which is left empty.
+	HeapStorage(HeapStorage<ElementType>&& aStorage) noexcept;
+
+	// Destructor
+	~HeapStorage();
+
+	// Description: Exchanges the storage of this and other.
+	void swapStorage(HeapStorage<ElementType>& other) noexcept;
+
+	// Description: Moves the constructed elements into new raw storage able to
+	//              hold newCapacity elements. If an element cannot be moved, the
+	//              storage is left as it was.
+	void reallocate(unsigned int newCapacity);
+
+	// Description: Returns the capacity to grow full storage to.
+	// Exceptions: Throws length_error if the storage cannot grow any further.
+	unsigned int grownCapacity() const;
+
+	// Description: Constructs a new element from args at elements[elementCount],
+	//              growing the storage first if it is full, and counts it.
+	//              args may refer to an element of the storage.
+	// Time Efficiency: O(1) amortized
+	template <class... Args>
+	void emplaceBack(Args&&... args);
+
+}; // end HeapStorage
+
+template <class ElementType, unsigned int Arity = 2, class Compare = less<ElementType>, class Tracker = NoPositionTracking, class Stats = NoHeapStats>
+class BinaryHeap : private HeapStorage<ElementType> {
+
+	static_assert(Arity >= 2, "BinaryHeap needs at least two children per node.");
+
+private:
+	using HeapStorage<ElementType>::elementCount;
+	using HeapStorage<ElementType>::capacity;
+	using HeapStorage<ElementType>::elements;
+	using HeapStorage<ElementType>::grownCapacity;
+	Tracker tracker;
+	mutable Stats stats;      // Counts comparisons too, which const methods make
+	Compare compare;          // compare(a, b) is "true" when a must be above b
 	
+	// Index arithmetic for a heap with Arity children per node.
+	// Arity is a compile-time constant, so these fold into shifts for powers of two.
+	static unsigned int parentOf(unsigned int index) { return (index - 1)/Arity; }
+	// In size_t: Arity*index + 1 passes UINT_MAX long before the storage is full
+	static size_t firstChildOf(unsigned int index) { return Arity*(size_t)index + 1; }
+
+	// Utility methods - Every comparison and every placement of an element in a slot
+	//                   goes through these, so Tracker and Stats hear about them.
+	bool above(const ElementType& a, const ElementType& b) const { stats.compared(); return compare(a, b); }
+	void placed(unsigned int index) { tracker.moved(elements[index], index); stats.moved(); }
+
 	void reHeapUp(unsigned int indexOfBottom);
 
 	void reHeapDown(unsigned int indexOfRoot);  
+
+	// Utility method - Returns the index of the smallest child of elements[indexOfParent],
+	//                  or elementCount if it is a leaf.
+	unsigned int indexOfSmallestChild(unsigned int indexOfParent) const;
+
+	// Utility method - Moves elements[index] up or down, whichever way it is out of place.
+	void reHeapAt(unsigned int index);
+
+	// Utility method - Replaces the root with the last element and sifts it down.
+	// Precondition: This Binary Heap is not empty.
+	void removeRoot();
+
+	// Utility method - Floyd's bottom-up deletion of the root, whose element has
+	//                  already been moved out: the hole walks down to a leaf along
+	//                  the smallest children, then the last element fills it and
+	//                  moves up. Saves about one comparison per level over removeRoot().
+	// Precondition: This Binary Heap is not empty.
+	void removeRootBottomUp();
+
+	// Utility method - Floyd's bottom-up construction: sifts down every
+	//                  internal node, from the last one back to the root.
+	void heapify();
+
+	// Utility method - Moves the constructed elements into new raw storage
+	//                  able to hold newCapacity elements, and counts it.
+	void reallocate(unsigned int newCapacity);
    
 public:
 	// Default Constructor
-	BinaryHeap(); 
+	BinaryHeap(const Compare& compare = Compare()); 
 	
-	// To do: If it needs a copy constructor, add it!
-	// To do: If it needs a destructor, add it!
+	// Range Constructor
+	// Description: Builds the Binary Heap from the elements in [first, last)
+	//              using Floyd's bottom-up construction.
+	// Time Efficiency: O(n)
+	template <class InputIterator>
+	BinaryHeap(InputIterator first, InputIterator last, const Compare& compare = Compare());
+
+	// Copy Constructor
+	BinaryHeap(const BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>& aHeap);
+
+	// Move Constructor
+	// Description: Takes over the storage of aHeap, which is left empty.
+	BinaryHeap(BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>&& aHeap) noexcept;
+
+	// Destructor
 	~BinaryHeap();
+
+	// Assignment operators
+	BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>& operator=(const BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>& rhs);
+	BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>& operator=(BinaryHeap<ElementType, Arity, Compare, Tracker, Stats>&& rhs) noexcept;
 	
     // Description: Returns the number of elements in the Binary Heap.
     // Postcondition:  The Binary Heap is unchanged by this operation.
 	// Time Efficiency: O(1)
     unsigned int getElementCount() const;
 
+	// Description: Returns the number of elements the Binary Heap can hold
+	//              before its storage has to grow.
+	// Postcondition:  The Binary Heap is unchanged by this operation.
+	// Time Efficiency: O(1)
+	unsigned int getCapacity() const;
+
+	// Description: Grows the storage so it holds at least newCapacity elements
+	//              without reallocating. Never shrinks the storage.
+	// Postcondition: The elements of the Binary Heap are unchanged.
+	// Time Efficiency: O(n)
+	void reserve(unsigned int newCapacity);
+
+	// Description: Releases unused storage so the capacity matches the element count.
+	// Postcondition: The elements of the Binary Heap are unchanged.
+	// Time Efficiency: O(n)
+	void shrink_to_fit();
+
 	// Description: Inserts newElement into the Binary Heap.
 	//              It returns "true" if successful, otherwise "false".        
-	// Postcondition: Remains a __________ Binary Heap after the insertion.
-	// Time Efficiency: O(log2 n)
-	bool insert(ElementType& newElement);
+	//              The storage doubles in size whenever it is full.
+	// Postcondition: Remains a Minimum Binary Heap after the insertion.
+	// Time Efficiency: O(logd n) amortized, where d is Arity
+	bool insert(const ElementType& newElement);
+
+	// Description: Moves newElement into the Binary Heap.
+	// Postcondition: Remains a Minimum Binary Heap after the insertion.
+	// Time Efficiency: O(logd n) amortized, where d is Arity
+	bool insert(ElementType&& newElement);
+
+	// Description: Constructs a new element in place from args and inserts it
+	//              into the Binary Heap. Returns "true" if successful.
+	// Postcondition: Remains a Minimum Binary Heap after the insertion.
+	// Time Efficiency: O(logd n) amortized, where d is Arity
+	template <class... Args>
+	bool emplace(Args&&... args);
+
+	// Description: Inserts the elements in [first, last) into the Binary Heap.
+	//              A batch at least as large as the heap is appended and the
+	//              whole array is rebuilt bottom-up; a smaller batch is sifted
+	//              up one element at a time.
+	// Postcondition: Remains a Minimum Binary Heap after the insertion.
+	// Time Efficiency: O(n + k) when k >= n, otherwise O(k logd n)
+	template <class InputIterator>
+	void insertRange(InputIterator first, InputIterator last);
 	   
 	// Description: Removes (but does not return) the element located at the root.
 	// Precondition: This Binary Heap is not empty.
-	// Postcondition: Remains a __________ Binary Heap after the removal.	
+	// Postcondition: Remains a Minimum Binary Heap after the removal.	
 	// Exceptions: Throws EmptyDataCollectionException if this Binary Heap is empty.
-	// Time Efficiency: O(log2 n)
+	// Time Efficiency: O(d logd n), where d is Arity
 	void remove();
 
+	// Description: Removes and returns the element located at the root.
+	//              The element is moved out, not copied.
+	// Precondition: This Binary Heap is not empty.
+	// Postcondition: Remains a Minimum Binary Heap after the removal.	
+	// Exceptions: Throws EmptyDataCollectionException if this Binary Heap is empty.
+	// Time Efficiency: O(d logd n), where d is Arity
+	ElementType pop();
+
+	// Description: Removes and returns the element located at the root, and
+	//              inserts newElement in its place with a single reHeapDown.
+	//              Same result as pop() followed by insert(newElement).
+	// Precondition: This Binary Heap is not empty.
+	// Exceptions: Throws EmptyDataCollectionException if this Binary Heap is empty.
+	// Time Efficiency: O(d logd n), where d is Arity
+	ElementType replaceTop(const ElementType& newElement);
+	ElementType replaceTop(ElementType&& newElement);
+
+	// Description: Inserts newElement, then removes and returns the element located
+	//              at the root. If newElement would be the new root, it is returned
+	//              straight away and the Binary Heap is not touched.
+	// Time Efficiency: O(1) when newElement is returned, otherwise O(d logd n)
+	ElementType pushPop(const ElementType& newElement);
+	ElementType pushPop(ElementType&& newElement);
+
+	// Description: Removes up to k elements from the root, in order, moving each
+	//              one to out. Uses Floyd's bottom-up deletion. Returns the output
+	//              iterator one past the last element written.
+	// Postcondition: Remains a Minimum Binary Heap after the removals.
+	// Time Efficiency: O(k d logd n), where d is Arity
+	template <class OutputIterator>
+	OutputIterator popN(unsigned int k, OutputIterator out);
+
+	// Description: Sorts the elements in place, root first, and calls
+	//              write(sorted, count) on the sorted array. The Binary Heap is
+	//              emptied only once write returns: a sorted array is already in
+	//              heap order, so if write throws, every element is kept.
+	// Time Efficiency: O(n d logd n), plus the time of write
+	template <class Function>
+	void drainSorted(Function write);
+
+	// Description: Calls update(element) on every element, in array order. update
+	//              must not change how the elements compare with one another, so
+	//              that no element has to move.
+	// Postcondition: Remains a Minimum Binary Heap, with every element in place.
+	// Time Efficiency: O(n)
+	template <class Function>
+	void updateEach(Function update);
+
 	// Description: Retrieves (but does not remove) the element located at the root.
 	// Precondition: This Binary Heap is not empty.
 	// Postcondition: This Binary Heap is unchanged.
 	// Exceptions: Throws EmptyDataCollectionException if this Binary Heap is empty.
 	// Time Efficiency: O(1) 
-	ElementType retrieve() const;
+	const ElementType& retrieve() const;
+
+	// Description: Removes the element at elements[index].
+	// Precondition: index < getElementCount().
+	// Postcondition: Remains a Minimum Binary Heap after the removal.
+	// Time Efficiency: O(d logd n), where d is Arity
+	void removeAt(unsigned int index);
+
+	// Description: Replaces the element at elements[index] with newElement, which
+	//              may be smaller or larger than the element it replaces.
+	// Precondition: index < getElementCount().
+	// Postcondition: Remains a Minimum Binary Heap after the replacement.
+	// Time Efficiency: O(d logd n), where d is Arity
+	void replaceAt(unsigned int index, ElementType&& newElement);
+	void replaceAt(unsigned int index, const ElementType& newElement);
+
+	// Description: Returns the Tracker told about every element move.
+	Tracker& getTracker();
+	const Tracker& getTracker() const;
+
+	// Description: Returns the Stats policy, e.g. getStats().snapshot() with HeapStats.
+	Stats& getStats();
+	const Stats& getStats() const;
    
 }; // end BinaryHeap
 
@@ -0,0 +1,352 @@
+/* 
+ * ExternalPriorityQueue.cpp
+ *
+ * Description: External-memory Priority Queue data collection ADT class,
+ *              for element types that can be copied byte for byte.
+ *              New elements go into an in-memory BinaryHeap. When that heap
+ *              reaches its share of the memory budget, its contents are
+ *              written out, in order, as a sorted run file. Runs are read
+ *              back a block at a time, and a small BinaryHeap of run
+ *              cursors merges them lazily as elements are dequeued. Runs
+ *              of one level are merged when there are too many runs.
+ *
+ * Class Invariant:  The next element is the better of the in-memory heap's top
+ *                   and the top of the run cursor heap.
+ * 
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */  
+
+#include "ExternalPriorityQueue.h"
+#include <random>
+#include <climits>
+#include <iterator>
+#include <algorithm>
+
+    // Constructor
+    // Description: Run files are created in directory, which must exist.
+    //              About half of memoryBudget (in bytes) goes to the in-memory
+    //              heap and half to the blocks of the runs being merged.
+    template <class ElementType, class Compare>
+    ExternalPriorityQueue<ElementType, Compare>::ExternalPriorityQueue(const string& directory, size_t memoryBudget, const Compare& compare)
+        : inMemory(compare), runs(RunCompare(compare)), compare(compare), elementCount(0), nextRunNumber(0) {
+        size_t heapElements = memoryBudget / 2 / sizeof(ElementType);
+        heapCapacity = heapElements == 0 ? 1 : (heapElements > UINT_MAX ? UINT_MAX : heapElements);
+
+        size_t blockBytes = memoryBudget / 8 < MAX_BLOCK_BYTES ? memoryBudget / 8 : MAX_BLOCK_BYTES;
+        blockElements = blockBytes < sizeof(ElementType) ? 1 : blockBytes / sizeof(ElementType);
+
+        // One block is kept back for writing while runs are merged.
+        size_t blocks = memoryBudget / 2 / (blockElements * sizeof(ElementType));
+        maxRuns = blocks < 3 ? 2 : blocks - 1;
+
+        random_device seed;
+        pathPrefix = directory + "/epq-" + to_string(seed()) + "-";
+    }
+
+    // Destructor
+    // Description: Deletes every run file still in use.
+    template <class ElementType, class Compare>
+    ExternalPriorityQueue<ElementType, Compare>::~ExternalPriorityQueue(){
+        while(runs.getElementCount() > 0){
+            destroyRun(runs.pop());
+        }
+    }
+
+    // Utility method - Creates an empty run file, open for writing.
+    template <class ElementType, class Compare>
+    typename ExternalPriorityQueue<ElementType, Compare>::Run* ExternalPriorityQueue<ElementType, Compare>::createRun(){
+        string path = pathPrefix + to_string(nextRunNumber++) + ".run";
+        FILE* file = fopen(path.c_str(), "w+b");
+        if(file == NULL){
+            throw ExternalStorageException("could not create run file " + path + ".");
+        }
+        Run* run = new Run;
+        run->file = file;
+        run->path = path;
+        run->position = 0;
+        run->unread = 0;
+        run->length = 0;
+        return run;
+    }
+
+    // Utility method - Writes the count elements of block at the end of run.
+    template <class ElementType, class Compare>
+    void ExternalPriorityQueue<ElementType, Compare>::appendToRun(Run* run, const ElementType* block, size_t count){
+        if(fwrite(block, sizeof(ElementType), count, run->file) != count){
+            throw ExternalStorageException("could not write run file " + run->path + ".");
+        }
+        run->unread += count;
+        run->length += count;
+    }
+
+    // Utility method - Rewinds a fully written run and loads its first block.
+    template <class ElementType, class Compare>
+    void ExternalPriorityQueue<ElementType, Compare>::finishRun(Run* run){
+        if(fflush(run->file) != 0 || fseek(run->file, 0, SEEK_SET) != 0){
+            throw ExternalStorageException("could not rewind run file " + run->path + ".");
+        }
+        loadNextBlock(run);
+    }
+
+    // Utility method - Loads the next block of run. Returns "false" if it has none left.
+    template <class ElementType, class Compare>
+    bool ExternalPriorityQueue<ElementType, Compare>::loadNextBlock(Run* run){
+        size_t count = run->unread < blockElements ? run->unread : blockElements;
+        if(count == 0){
+            return false;
+        }
+        run->block.resize(count);
+        if(fread(run->block.data(), sizeof(ElementType), count, run->file) != count){
+            throw ExternalStorageException("could not read run file " + run->path + ".");
+        }
+        run->unread -= count;
+        run->position = 0;
+        return true;
+    }
+
+    // Utility method - Moves run back to its state after "consumed" elements had
+    //                  been read from it, and reloads that block.
+    template <class ElementType, class Compare>
+    void ExternalPriorityQueue<ElementType, Compare>::rewindRun(Run* run, unsigned long long consumed){
+        unsigned long long blockStart = consumed / blockElements * blockElements;
+        if(fseek(run->file, blockStart * sizeof(ElementType), SEEK_SET) != 0){
+            throw ExternalStorageException("could not rewind run file " + run->path + ".");
+        }
+        run->unread = run->length - blockStart;
+        loadNextBlock(run);
+        run->position = consumed - blockStart;
+    }
+
+    // Utility method - Returns the elements already read from run.
+    template <class ElementType, class Compare>
+    unsigned long long ExternalPriorityQueue<ElementType, Compare>::consumedFrom(const Run* run){
+        return run->length - run->unread - (run->block.size() - run->position);
+    }
+
+    // Utility method - Returns floor(log2(length / heapCapacity)), 0 for a run
+    //                  written by one spill.
+    template <class ElementType, class Compare>
+    unsigned int ExternalPriorityQueue<ElementType, Compare>::levelOf(const Run* run) const{
+        unsigned long long spills = run->length / heapCapacity;
+        unsigned int level = 0;
+        while(spills > 1){
+            spills >>= 1;
+            level++;
+        }
+        return level;
+    }
+
+    // Utility method - Closes and deletes the file of run.
+    template <class ElementType, class Compare>
+    void ExternalPriorityQueue<ElementType, Compare>::destroyRun(Run* run){
+        fclose(run->file);
+        remove(run->path.c_str());
+        delete run;
+    }
+
+    // Utility method - Writes all of inMemory out as one sorted run. The heap is
+    //                  sorted in place and written before it is emptied, so a
+    //                  failed write leaves every element in it.
+    //                  Too many runs to merge within the budget are then merged.
+    template <class ElementType, class Compare>
+    void ExternalPriorityQueue<ElementType, Compare>::spill(){
+        runs.reserve(runs.getElementCount() + 1);
+        Run* run = createRun();
+        try{
+            inMemory.drainSorted([this, run](const ElementType* sorted, unsigned int count){
+                appendToRun(run, sorted, count);
+                finishRun(run);
+            });
+        }
+        catch(...){
+            destroyRun(run);
+            throw;
+        }
+        runs.insert(run);
+        if(runs.getElementCount() > maxRuns){
+            mergeRuns();
+        }
+    }
+
+    // Utility method - Merges the runs of the lowest level that has more than one,
+    //                  up to maxRuns of them, into a single run. Runs of the same
+    //                  level are within a factor of 2 in length, so each element
+    //                  goes up at least one level when it is rewritten. If every
+    //                  level has a single run, the two shortest runs are merged.
+    template <class ElementType, class Compare>
+    void ExternalPriorityQueue<ElementType, Compare>::mergeRuns(){
+        // Take the runs out, shortest first, and move the ones to merge to the front.
+        vector<Run*> all;
+        all.reserve(runs.getElementCount());
+        vector<unsigned long long> consumed(runs.getElementCount());
+        runs.popN(runs.getElementCount(), back_inserter(all));
+        sort(all.begin(), all.end(), [](const Run* lhs, const Run* rhs){ return lhs->length < rhs->length; });
+
+        unsigned int first = 0;
+        unsigned int count = 2;
+        for(unsigned int i = 0; i + 1 < all.size(); ){
+            unsigned int level = levelOf(all[i]);
+            unsigned int j = i + 1;
+            while(j < all.size() && levelOf(all[j]) == level){
+                j++;
+            }
+            if(j - i >= 2){
+                first = i;
+                count = j - i < maxRuns ? j - i : maxRuns;
+                break;
+            }
+            i = j;
+        }
+        rotate(all.begin(), all.begin() + first, all.begin() + first + count);
+        runs.insertRange(all.begin() + count, all.end());
+
+        for(unsigned int i = 0; i < count; i++){
+            consumed[i] = consumedFrom(all[i]);
+        }
+        Run* merged = NULL;
+        try{
+            BinaryHeap<Run*, 2, RunCompare> cursors(all.begin(), all.begin() + count, RunCompare(compare));
+            merged = createRun();
+            vector<ElementType> block;
+            block.reserve(blockElements);
+            while(cursors.getElementCount() > 0){
+                block.clear();
+                while(block.size() < blockElements && cursors.getElementCount() > 0){
+                    block.push_back(popFromRuns(cursors, false));
+                }
+                appendToRun(merged, block.data(), block.size());
+            }
+            finishRun(merged);
+        }
+        catch(...){
+            if(merged != NULL){
+                destroyRun(merged);
+            }
+            // Put the runs back where the merge found them. A run that cannot
+            // be read again is lost, and its elements are no longer counted.
+            for(unsigned int i = 0; i < count; i++){
+                try{
+                    rewindRun(all[i], consumed[i]);
+                    runs.insert(all[i]);
+                }
+                catch(ExternalStorageException&){
+                    elementCount -= all[i]->length - consumed[i];
+                    destroyRun(all[i]);
+                }
+            }
+            throw;
+        }
+        for(unsigned int i = 0; i < count; i++){
+            destroyRun(all[i]);
+        }
+        runs.insert(merged);
+    }
+
+    // Utility method - "true" if the next element is at the top of inMemory.
+    //                  On a tie the in-memory element goes first.
+    template <class ElementType, class Compare>
+    bool ExternalPriorityQueue<ElementType, Compare>::nextIsInMemory() const{
+        if(runs.getElementCount() == 0){
+            return true;
+        }
+        if(inMemory.getElementCount() == 0){
+            return false;
+        }
+        const Run* run = runs.retrieve();
+        return !compare(run->block[run->position], inMemory.retrieve());
+    }
+
+    // Utility method - Removes and returns the next element of the best run in
+    //                  cursors, then moves that run to its new place among the others.
+    template <class ElementType, class Compare>
+    ElementType ExternalPriorityQueue<ElementType, Compare>::popFromRuns(BinaryHeap<Run*, 2, RunCompare>& cursors, bool destroyEmpty){
+        Run* run = cursors.retrieve();
+        ElementType next = run->block[run->position++];
+        if(run->position < run->block.size() || loadNextBlock(run)){
+            cursors.replaceAt(0, run);
+        }
+        else{
+            cursors.remove();
+            if(destroyEmpty){
+                destroyRun(run);
+            }
+        }
+        return next;
+    }
+
+    // Description: Returns "true" if this External Priority Queue is empty, otherwise "false".
+    // Time Efficiency: O(1)
+    template <class ElementType, class Compare>
+    bool ExternalPriorityQueue<ElementType, Compare>::isEmpty() const{
+        return elementCount == 0;
+    }
+
+    // Description: Returns the number of elements, in memory and on disk.
+    // Time Efficiency: O(1)
+    template <class ElementType, class Compare>
+    unsigned long long ExternalPriorityQueue<ElementType, Compare>::getElementCount() const{
+        return elementCount;
+    }
+
+    // Description: Inserts newElement in this External Priority Queue and
+    //              returns "true" if successful, otherwise "false".
+    //              The heap grows by doubling, so once doubling would take it
+    //              past heapCapacity it is grown to exactly heapCapacity.
+    template <class ElementType, class Compare>
+    bool ExternalPriorityQueue<ElementType, Compare>::enqueue(const ElementType& newElement){
+        unsigned int count = inMemory.getElementCount();
+        if(count == heapCapacity){
+            spill();
+        }
+        else if(count == inMemory.getCapacity() && heapCapacity - count <= count){
+            inMemory.reserve(heapCapacity);
+        }
+        inMemory.insert(newElement);
+        elementCount++;
+        return true;
+    }
+
+    // Description: Removes (but does not return) the element with the next
+    //              "highest" priority value from the External Priority Queue.
+    // Precondition: This External Priority Queue is not empty.
+    // Exception: Throws EmptyDataCollectionException if this External Priority Queue is empty.
+    template <class ElementType, class Compare>
+    void ExternalPriorityQueue<ElementType, Compare>::dequeue(){
+        if(elementCount == 0){
+            throw EmptyDataCollectionException("dequeue() called with an empty ExternalPriorityQueue.");
+        }
+        pop();
+    }
+
+    // Description: Removes and returns the element with the next
+    //              "highest" priority value from the External Priority Queue.
+    // Precondition: This External Priority Queue is not empty.
+    // Exception: Throws EmptyDataCollectionException if this External Priority Queue is empty.
+    template <class ElementType, class Compare>
+    ElementType ExternalPriorityQueue<ElementType, Compare>::pop(){
+        if(elementCount == 0){
+            throw EmptyDataCollectionException("pop() called with an empty ExternalPriorityQueue.");
+        }
+        ElementType next = nextIsInMemory() ? inMemory.pop() : popFromRuns(runs, true);
+        elementCount--;
+        return next;
+    }
+
+    // Description: Returns (but does not remove) the element with the next 
+    //              "highest" priority from the External Priority Queue.
+    // Precondition: This External Priority Queue is not empty.
+    // Exception: Throws EmptyDataCollectionException if this External Priority Queue is empty.
+    template <class ElementType, class Compare>
+    const ElementType& ExternalPriorityQueue<ElementType, Compare>::peek() const{
+        if(elementCount == 0){
+            throw EmptyDataCollectionException("peek() called with an empty ExternalPriorityQueue.");
+        }
+        if(nextIsInMemory()){
+            return inMemory.retrieve();
+        }
+        const Run* run = runs.retrieve();
+        return run->block[run->position];
+    }
@@ -0,0 +1,182 @@
+/* 
+ * ExternalPriorityQueue.h
+ *
+ * Description: External-memory Priority Queue data collection ADT class,
+ *              for element types that can be copied byte for byte.
+ *              New elements go into an in-memory BinaryHeap. When that heap
+ *              reaches its share of the memory budget, its contents are
+ *              written out, in order, as a sorted run file. Runs are read
+ *              back a block at a time, and a small BinaryHeap of run
+ *              cursors merges them lazily as elements are dequeued. When
+ *              there are more runs than the budget has read buffers for,
+ *              the shortest runs of about the same length (one level) are
+ *              merged, up to maxRuns at a time, so that an element is
+ *              rewritten once per level rather than at every spill.
+ *              Priority is decided by Compare (std::less by default, so the
+ *              smallest element comes out first; std::greater reverses it).
+ *
+ * Class Invariant:  The next element is the better of the in-memory heap's top
+ *                   and the top of the run cursor heap.
+ * 
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */  
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <type_traits>
+#include "BinaryHeap.h"
+#include "ExternalStorageException.h"
+
+template <class ElementType, class Compare = less<ElementType> >
+class ExternalPriorityQueue {
+
+    static_assert(is_trivially_copyable<ElementType>::value, "ExternalPriorityQueue writes elements to disk byte for byte.");
+
+    private:
+        static const size_t MAX_BLOCK_BYTES = 64 * 1024;    // Largest read or write block
+
+        // A sorted run on disk, and the block of it currently in memory.
+        struct Run {
+            FILE* file;
+            string path;
+            vector<ElementType> block;
+            unsigned int position;          // Next element of block
+            unsigned long long unread;      // Elements still on disk after block
+            unsigned long long length;      // Elements written to the run
+        };
+
+        // Orders runs by the next element each one will hand out.
+        struct RunCompare {
+            Compare compare;
+
+            RunCompare(const Compare& compare = Compare()) : compare(compare) {}
+            bool operator()(const Run* lhs, const Run* rhs) const {
+                return compare(lhs->block[lhs->position], rhs->block[rhs->position]);
+            }
+        };
+
+        BinaryHeap<ElementType, 2, Compare> inMemory;
+        BinaryHeap<Run*, 2, RunCompare> runs;
+        Compare compare;
+        unsigned long long elementCount;
+
+        string pathPrefix;              // Directory and a name prefix unique to this queue
+        unsigned int nextRunNumber;
+        unsigned int heapCapacity;      // Most elements inMemory may hold
+        unsigned int blockElements;     // Elements per read or write block
+        unsigned int maxRuns;           // Most runs whose blocks fit in the budget
+
+        // Utility methods - Create a run file, add a block to it, and rewind it for reading.
+        // Exception: Throw ExternalStorageException if the file cannot be created or written.
+        Run* createRun();
+        void appendToRun(Run* run, const ElementType* block, size_t count);
+        void finishRun(Run* run);
+
+        // Utility method - Loads the next block of run. Returns "false" if it has none left.
+        // Exception: Throws ExternalStorageException if the file cannot be read.
+        bool loadNextBlock(Run* run);
+
+        // Utility method - Moves run back to its state after "consumed" elements
+        //                  had been read from it, and reloads that block.
+        // Exception: Throws ExternalStorageException if the file cannot be read.
+        void rewindRun(Run* run, unsigned long long consumed);
+
+        // Utility method - Returns the elements already read from run.
+        static unsigned long long consumedFrom(const Run* run);
+
+        // Utility method - Returns the level of run: floor(log2(length / heapCapacity)),
+        //                  0 for a run written by one spill.
+        unsigned int levelOf(const Run* run) const;
+
+        // Utility method - Closes and deletes the file of run.
+        void destroyRun(Run* run);
+
+        // Utility method - Writes all of inMemory out as one sorted run. inMemory
+        //                  is emptied only once the run is written.
+        // Exception: Throws ExternalStorageException if the run cannot be written,
+        //            and then keeps every element.
+        void spill();
+
+        // Utility method - Merges the runs of the lowest level that has more than
+        //                  one, up to maxRuns of them, into a single run.
+        // Exception: Throws ExternalStorageException if the merged run cannot be
+        //            written, and then puts the runs back as they were.
+        void mergeRuns();
+
+        // Utility method - "true" if the next element is at the top of inMemory.
+        // Precondition: This External Priority Queue is not empty.
+        bool nextIsInMemory() const;
+
+        // Utility method - Removes and returns the next element of the best run in
+        //                  cursors. A run with nothing left is taken out of cursors,
+        //                  and deleted if destroyEmpty is "true".
+        // Precondition: cursors is not empty.
+        ElementType popFromRuns(BinaryHeap<Run*, 2, RunCompare>& cursors, bool destroyEmpty);
+
+        ExternalPriorityQueue(const ExternalPriorityQueue<ElementType, Compare>&);
+        ExternalPriorityQueue<ElementType, Compare>& operator=(const ExternalPriorityQueue<ElementType, Compare>&);
+
+    public:
+        /******* Start of External Priority Queue Public Interface *******/
+        // Constructor
+        // Description: Run files are created in directory, which must exist.
+        //              About half of memoryBudget (in bytes) goes to the in-memory
+        //              heap and half to the blocks of the runs being merged.
+        ExternalPriorityQueue(const string& directory, size_t memoryBudget, const Compare& compare = Compare());
+
+        // Destructor
+        // Description: Deletes every run file still in use.
+        ~ExternalPriorityQueue();
+
+        // Description: Returns "true" if this External Priority Queue is empty, otherwise "false".
+        // Postcondition: This External Priority Queue is unchanged by this operation.
+        // Time Efficiency: O(1)
+        bool isEmpty() const;
+
+        // Description: Returns the number of elements, in memory and on disk.
+        // Postcondition: This External Priority Queue is unchanged by this operation.
+        // Time Efficiency: O(1)
+        unsigned long long getElementCount() const;
+
+        // Description: Inserts newElement in this External Priority Queue and
+        //              returns "true" if successful, otherwise "false".
+        //              May first write the in-memory heap out as a new run.
+        // Exception: Throws ExternalStorageException if a run file cannot be written;
+        //            newElement is then not inserted, and no element is lost.
+        // Time Efficiency: O(log2 m) amortized, plus O(log2 (n/m)) amortized element
+        //                  writes, where m is the in-memory heap capacity
+        bool enqueue(const ElementType& newElement);
+
+        // Description: Removes (but does not return) the element with the next
+        //              "highest" priority value from the External Priority Queue.
+        // Precondition: This External Priority Queue is not empty.
+        // Exception: Throws EmptyDataCollectionException if this External Priority Queue is empty.
+        // Exception: Throws ExternalStorageException if a run file cannot be read.
+        void dequeue();
+
+        // Description: Removes and returns the element with the next
+        //              "highest" priority value from the External Priority Queue.
+        // Precondition: This External Priority Queue is not empty.
+        // Exception: Throws EmptyDataCollectionException if this External Priority Queue is empty.
+        // Exception: Throws ExternalStorageException if a run file cannot be read.
+        // Time Efficiency: O(log2 m + log2 r), where r is the number of runs
+        ElementType pop();
+
+        // Description: Returns (but does not remove) the element with the next 
+        //              "highest" priority from the External Priority Queue.
+        // Precondition: This External Priority Queue is not empty.
+        // Postcondition: This External Priority Queue is unchanged by this operation.
+        // Exception: Throws EmptyDataCollectionException if this External Priority Queue is empty.
+        // Time Efficiency: O(1)
+        const ElementType& peek() const;
+
+        /*******  End of External Priority Queue Public Interface *******/
+};
+
+#include "ExternalPriorityQueue.cpp"
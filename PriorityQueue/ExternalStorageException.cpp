@@ -0,0 +1,21 @@
+/*
+ * ExternalStorageException.cpp
+ *
+ * Class Description: Defines the exception that is thrown when 
+ *                    a data collection ADT class fails to create,
+ *                    write or read back the files it keeps its
+ *                    elements in.
+ *
+ * Author: Inspired from our textbook's authors Frank M. Carrano and Tim Henry.
+ *         Copyright (c) 2013 __Pearson Education__. All rights reserved.
+ */
+ 
+
+#include "ExternalStorageException.h"  
+
+ExternalStorageException::ExternalStorageException(const string& message): 
+runtime_error("ExternalStorageException: " + message)
+{
+}  // end constructor
+
+// End of implementation file.
\ No newline at end of file
@@ -0,0 +1,25 @@
+/*
+ * ExternalStorageException.h
+ *
+ * Class Description: Defines the exception that is thrown when 
+ *                    a data collection ADT class fails to create,
+ *                    write or read back the files it keeps its
+ *                    elements in.
+ *
+ * Author: Inspired from our textbook's authors Frank M. Carrano and Tim Henry.
+ *         Copyright (c) 2013 __Pearson Education__. All rights reserved.
+ */
+ 
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+class ExternalStorageException : public runtime_error
+{
+public:
+   ExternalStorageException(const string& message = "");
+   
+}; // end ExternalStorageException 
\ No newline at end of file
@@ -0,0 +1,265 @@
+/*
+ * MinMaxHeap.cpp
+ *
+ * Description: Double-ended Priority Queue data collection ADT class.
+ *              Min-Max Heap implementation: same implicit array layout as
+ *              BinaryHeap, but even levels (the root's) are ordered as a
+ *              minimum heap and odd levels as a maximum heap, so both the
+ *              smallest and the largest element can be reached in O(1).
+ *              Elements are ordered by Compare (std::less by default).
+ *
+ * Class Invariant:  Every element on an even level is <= all of its descendants,
+ *                   every element on an odd level is >= all of its descendants.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#include "MinMaxHeap.h"  // Header file
+
+using namespace std;
+
+// Default Constructor
+template <class ElementType, class Compare>
+MinMaxHeap<ElementType, Compare>::MinMaxHeap(const Compare& compare) : compare(compare) {}
+
+// Copy Constructor
+// Description: HeapStorage cleans up if an element cannot be copied.
+template <class ElementType, class Compare>
+MinMaxHeap<ElementType, Compare>::MinMaxHeap(const MinMaxHeap<ElementType, Compare>& aHeap)
+	: HeapStorage<ElementType>(aHeap), compare(aHeap.compare) {}
+
+// Destructor
+// Description: HeapStorage destroys the elements.
+template <class ElementType, class Compare>
+MinMaxHeap<ElementType, Compare>::~MinMaxHeap() {}
+
+// Assignment operator
+template <class ElementType, class Compare>
+MinMaxHeap<ElementType, Compare>& MinMaxHeap<ElementType, Compare>::operator=(MinMaxHeap<ElementType, Compare> rhs) {
+	this->swapStorage(rhs);
+	swap(compare, rhs.compare);
+	return *this;
+}
+
+// Description: Returns "true" if this Min-Max Heap is empty, otherwise "false".
+// Time Efficiency: O(1)
+template <class ElementType, class Compare>
+bool MinMaxHeap<ElementType, Compare>::isEmpty() const {
+	return elementCount == 0;
+}
+
+// Description: Returns the number of elements in the Min-Max Heap.
+// Time Efficiency: O(1)
+template <class ElementType, class Compare>
+unsigned int MinMaxHeap<ElementType, Compare>::getElementCount() const {
+	return elementCount;
+}
+
+// Description: Inserts newElement in this Min-Max Heap and
+//              returns "true" if successful, otherwise "false".
+// Time Efficiency: O(log2 n) amortized
+template <class ElementType, class Compare>
+bool MinMaxHeap<ElementType, Compare>::enqueue(const ElementType& newElement) {
+	return emplace(newElement);
+}
+
+template <class ElementType, class Compare>
+bool MinMaxHeap<ElementType, Compare>::enqueue(ElementType&& newElement) {
+	return emplace(move(newElement));
+}
+
+// Description: Constructs a new element in place from args and inserts it.
+// Time Efficiency: O(log2 n) amortized
+template <class ElementType, class Compare>
+template <class... Args>
+bool MinMaxHeap<ElementType, Compare>::emplace(Args&&... args) {
+	unsigned int indexOfBack = elementCount;
+	this->emplaceBack(forward<Args>(args)...);
+	reHeapUp(indexOfBack);
+	return true;
+}
+
+// Description: Returns (but does not remove) the smallest element.
+// Precondition: This Min-Max Heap is not empty.
+// Exception: Throws EmptyDataCollectionException if this Min-Max Heap is empty.
+// Time Efficiency: O(1)
+template <class ElementType, class Compare>
+const ElementType& MinMaxHeap<ElementType, Compare>::peekMin() const {
+	if (elementCount == 0)
+		throw EmptyDataCollectionException("peekMin() called with an empty MinMaxHeap.");
+	return elements[0];
+}
+
+// Description: Returns (but does not remove) the largest element.
+// Precondition: This Min-Max Heap is not empty.
+// Exception: Throws EmptyDataCollectionException if this Min-Max Heap is empty.
+// Time Efficiency: O(1)
+template <class ElementType, class Compare>
+const ElementType& MinMaxHeap<ElementType, Compare>::peekMax() const {
+	if (elementCount == 0)
+		throw EmptyDataCollectionException("peekMax() called with an empty MinMaxHeap.");
+	return elements[indexOfMax()];
+}
+
+// Description: Removes and returns the smallest element.
+// Precondition: This Min-Max Heap is not empty.
+// Exception: Throws EmptyDataCollectionException if this Min-Max Heap is empty.
+// Time Efficiency: O(log2 n)
+template <class ElementType, class Compare>
+ElementType MinMaxHeap<ElementType, Compare>::popMin() {
+	if (elementCount == 0)
+		throw EmptyDataCollectionException("popMin() called with an empty MinMaxHeap.");
+	return removeAt(0);
+}
+
+// Description: Removes and returns the largest element.
+// Precondition: This Min-Max Heap is not empty.
+// Exception: Throws EmptyDataCollectionException if this Min-Max Heap is empty.
+// Time Efficiency: O(log2 n)
+template <class ElementType, class Compare>
+ElementType MinMaxHeap<ElementType, Compare>::popMax() {
+	if (elementCount == 0)
+		throw EmptyDataCollectionException("popMax() called with an empty MinMaxHeap.");
+	return removeAt(indexOfMax());
+}
+
+// Utility method - Returns the index of the largest element: the root if it is
+//                  alone, otherwise the larger of its (at most two) children.
+template <class ElementType, class Compare>
+unsigned int MinMaxHeap<ElementType, Compare>::indexOfMax() const {
+	if (elementCount == 1) return 0;
+	if (elementCount == 2) return 1;
+	return compare(elements[1], elements[2]) ? 2 : 1;
+}
+
+// Utility method - Moves out the element at index and refills the slot with the last element.
+template <class ElementType, class Compare>
+ElementType MinMaxHeap<ElementType, Compare>::removeAt(unsigned int index) {
+	ElementType removed = move(elements[index]);
+	unsigned int indexOfBack = elementCount - 1;
+	if (index == indexOfBack) {
+		elements[indexOfBack].~ElementType();
+		elementCount--;
+		return removed;
+	}
+	ElementType moving = move(elements[indexOfBack]);
+	elements[indexOfBack].~ElementType();
+	elementCount--;
+	reHeapDown(index, moving);
+	return removed;
+}
+
+// Utility method - "true" when index is on an even level: 0, 3-6, 15-30, ...
+template <class ElementType, class Compare>
+bool MinMaxHeap<ElementType, Compare>::isMinLevel(unsigned int index) {
+	unsigned int level = 0;
+	for (unsigned int n = index + 1; n > 1; n >>= 1)
+		level++;
+	return level % 2 == 0;
+}
+
+// Utility method - "true" if a must be above b on a min (MinLevel) or max level.
+template <class ElementType, class Compare>
+template <bool MinLevel>
+bool MinMaxHeap<ElementType, Compare>::above(const ElementType& a, const ElementType& b) const {
+	return MinLevel ? compare(a, b) : compare(b, a);
+}
+
+// Utility method - A new element first settles which kind of level it belongs to
+//                  by comparing with its parent, then climbs grandparent by grandparent.
+//                  It is moved out once, the elements it passes are moved down into
+//                  the hole it leaves, and it is moved once into its final slot.
+template <class ElementType, class Compare>
+void MinMaxHeap<ElementType, Compare>::reHeapUp(unsigned int index) {
+	if (index == 0) return;
+	unsigned int indexOfParent = parentOf(index);
+	bool minLevel = isMinLevel(index);
+	bool otherKind = minLevel ? compare(elements[indexOfParent], elements[index])
+	                          : compare(elements[index], elements[indexOfParent]);
+	if (!otherKind) {
+		// Most new elements stay where they are: check before moving anything out
+		if (index <= 2) return;
+		unsigned int indexOfGrandparent = parentOf(indexOfParent);
+		if (minLevel ? !above<true>(elements[index], elements[indexOfGrandparent])
+		             : !above<false>(elements[index], elements[indexOfGrandparent]))
+			return;
+	}
+
+	ElementType moving = move(elements[index]);
+	unsigned int hole = index;
+	if (otherKind) {
+		elements[hole] = move(elements[indexOfParent]);
+		hole = indexOfParent;
+		minLevel = !minLevel;
+	}
+	hole = minLevel ? reHeapUpLevel<true>(hole, moving) : reHeapUpLevel<false>(hole, moving);
+	elements[hole] = move(moving);
+}
+
+// Utility method - Moves the hole up grandparent by grandparent while "moving"
+//                  must be above the grandparent, and returns where it stops.
+template <class ElementType, class Compare>
+template <bool MinLevel>
+unsigned int MinMaxHeap<ElementType, Compare>::reHeapUpLevel(unsigned int hole, const ElementType& moving) {
+	while (hole > 2) {
+		unsigned int indexOfGrandparent = parentOf(parentOf(hole));
+		if (!above<MinLevel>(moving, elements[indexOfGrandparent]))
+			break;
+		elements[hole] = move(elements[indexOfGrandparent]);
+		hole = indexOfGrandparent;
+	}
+	return hole;
+}
+
+// Utility method - Fills the hole at elements[hole] with "moving", moving the
+//                  most extreme of its children and grandchildren up into the
+//                  hole for as long as one must be above "moving".
+template <class ElementType, class Compare>
+void MinMaxHeap<ElementType, Compare>::reHeapDown(unsigned int hole, ElementType& moving) {
+	if (isMinLevel(hole))
+		reHeapDownLevel<true>(hole, moving);
+	else
+		reHeapDownLevel<false>(hole, moving);
+}
+
+template <class ElementType, class Compare>
+template <bool MinLevel>
+void MinMaxHeap<ElementType, Compare>::reHeapDownLevel(unsigned int hole, ElementType& moving) {
+	for (;;) {
+		unsigned int indexOfFirstChild = 2*hole + 1;
+		if (indexOfFirstChild >= elementCount) break;
+
+		// The children and the grandchildren are each stored next to each other.
+		unsigned int indexOfBest = indexOfFirstChild;
+		if (indexOfFirstChild + 1 < elementCount && above<MinLevel>(elements[indexOfFirstChild + 1], elements[indexOfBest]))
+			indexOfBest = indexOfFirstChild + 1;
+		unsigned int indexOfFirstGrandchild = 2*indexOfFirstChild + 1;
+		unsigned int indexOfLastGrandchild = indexOfFirstGrandchild + 4;
+		if (indexOfLastGrandchild > elementCount) indexOfLastGrandchild = elementCount;
+		for (unsigned int i = indexOfFirstGrandchild; i < indexOfLastGrandchild; i++) {
+			if (above<MinLevel>(elements[i], elements[indexOfBest]))
+				indexOfBest = i;
+		}
+
+		if (!above<MinLevel>(elements[indexOfBest], moving))
+			break;
+		elements[hole] = move(elements[indexOfBest]);
+		hole = indexOfBest;
+
+		// A child is on the other kind of level and has no grandchildren to check.
+		if (indexOfBest < indexOfFirstGrandchild)
+			break;
+
+		// "moving" may be out of place with the hole's parent, on the other kind of
+		// level: the parent's element then goes on down in its place.
+		unsigned int indexOfParent = parentOf(hole);
+		if (above<MinLevel>(elements[indexOfParent], moving))
+			swap(elements[indexOfParent], moving);
+	}
+	elements[hole] = move(moving);
+}
+
+//  End of implementation file.
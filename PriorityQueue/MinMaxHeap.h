@@ -0,0 +1,123 @@
+/*
+ * MinMaxHeap.h
+ *
+ * Description: Double-ended Priority Queue data collection ADT class.
+ *              Min-Max Heap implementation: same implicit array layout as
+ *              BinaryHeap, but even levels (the root's) are ordered as a
+ *              minimum heap and odd levels as a maximum heap, so both the
+ *              smallest and the largest element can be reached in O(1).
+ *              Elements are ordered by Compare (std::less by default).
+ *              The storage and its growth are BinaryHeap's (HeapStorage), and
+ *              the sifts move a hole instead of swapping, as BinaryHeap does.
+ *
+ * Class Invariant:  Every element on an even level is <= all of its descendants,
+ *                   every element on an odd level is >= all of its descendants.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <functional>
+#include "BinaryHeap.h"
+#include "EmptyDataCollectionException.h"
+
+using namespace std;
+
+template <class ElementType, class Compare = less<ElementType> >
+class MinMaxHeap : private HeapStorage<ElementType> {
+
+private:
+	using HeapStorage<ElementType>::elementCount;
+	using HeapStorage<ElementType>::elements;
+	Compare compare;
+
+	static unsigned int parentOf(unsigned int index) { return (index - 1)/2; }
+	static bool isMinLevel(unsigned int index);
+
+	// Utility methods - Move the element at index up through the levels of its kind.
+	void reHeapUp(unsigned int index);
+	template <bool MinLevel>
+	unsigned int reHeapUpLevel(unsigned int hole, const ElementType& moving);
+
+	// Utility methods - Fill the hole at elements[hole] with "moving", moving it
+	//                   down through the levels of the hole's kind.
+	void reHeapDown(unsigned int hole, ElementType& moving);
+	template <bool MinLevel>
+	void reHeapDownLevel(unsigned int hole, ElementType& moving);
+
+	// Utility method - "true" if a must be above b on a min (MinLevel) or max level.
+	template <bool MinLevel>
+	bool above(const ElementType& a, const ElementType& b) const;
+
+	// Utility method - Returns the index of the largest element.
+	// Precondition: This Min-Max Heap is not empty.
+	unsigned int indexOfMax() const;
+
+	// Utility method - Moves out the element at index and refills the slot with the last element.
+	ElementType removeAt(unsigned int index);
+
+public:
+	// Default Constructor
+	MinMaxHeap(const Compare& compare = Compare());
+
+	// Copy Constructor
+	MinMaxHeap(const MinMaxHeap<ElementType, Compare>& aHeap);
+
+	// Destructor
+	~MinMaxHeap();
+
+	// Assignment operator
+	MinMaxHeap<ElementType, Compare>& operator=(MinMaxHeap<ElementType, Compare> rhs);
+
+	// Description: Returns "true" if this Min-Max Heap is empty, otherwise "false".
+	// Time Efficiency: O(1)
+	bool isEmpty() const;
+
+	// Description: Returns the number of elements in the Min-Max Heap.
+	// Time Efficiency: O(1)
+	unsigned int getElementCount() const;
+
+	// Description: Inserts newElement in this Min-Max Heap and
+	//              returns "true" if successful, otherwise "false".
+	// Time Efficiency: O(log2 n) amortized
+	bool enqueue(const ElementType& newElement);
+	bool enqueue(ElementType&& newElement);
+
+	// Description: Constructs a new element in place from args and inserts it.
+	// Time Efficiency: O(log2 n) amortized
+	template <class... Args>
+	bool emplace(Args&&... args);
+
+	// Description: Returns (but does not remove) the smallest element.
+	// Precondition: This Min-Max Heap is not empty.
+	// Exception: Throws EmptyDataCollectionException if this Min-Max Heap is empty.
+	// Time Efficiency: O(1)
+	const ElementType& peekMin() const;
+
+	// Description: Returns (but does not remove) the largest element.
+	// Precondition: This Min-Max Heap is not empty.
+	// Exception: Throws EmptyDataCollectionException if this Min-Max Heap is empty.
+	// Time Efficiency: O(1)
+	const ElementType& peekMax() const;
+
+	// Description: Removes and returns the smallest element.
+	// Precondition: This Min-Max Heap is not empty.
+	// Exception: Throws EmptyDataCollectionException if this Min-Max Heap is empty.
+	// Time Efficiency: O(log2 n)
+	ElementType popMin();
+
+	// Description: Removes and returns the largest element.
+	// Precondition: This Min-Max Heap is not empty.
+	// Exception: Throws EmptyDataCollectionException if this Min-Max Heap is empty.
+	// Time Efficiency: O(log2 n)
+	ElementType popMax();
+
+}; // end MinMaxHeap
+
+#include "MinMaxHeap.cpp"
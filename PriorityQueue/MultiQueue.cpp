@@ -0,0 +1,151 @@
+/* 
+ * MultiQueue.cpp
+ *
+ * Description: Relaxed concurrent Priority Queue data collection ADT class.
+ *              MultiQueue implementation: c * P BinaryHeap shards, each behind
+ *              its own lock, for P threads. enqueue() adds to a random shard;
+ *              dequeue samples two random shards and removes the better of
+ *              their tops. The element removed is therefore not always the
+ *              global "highest" priority, but close to it: a larger c spreads
+ *              threads out more at the cost of a worse expected rank.
+ *
+ * Class Invariant:  Every shard is a Binary Heap ordered by Compare.
+ * 
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */  
+
+#include "MultiQueue.h"
+
+    // Constructor
+    // Description: Creates shardsPerThread * threadCount empty shards.
+    //              shardsPerThread (c) is the relaxation: 2 is the usual choice.
+    template <class ElementType, class Compare>
+    MultiQueue<ElementType, Compare>::MultiQueue(unsigned int threadCount, unsigned int shardsPerThread, const Compare& compare)
+        : compare(compare), elementCount(0) {
+        shardCount = threadCount * shardsPerThread;
+        if(shardCount < 2){
+            shardCount = 2;
+        }
+        shards = new Shard[shardCount];
+        for(unsigned int i = 0; i < shardCount; i++){
+            shards[i].heap = BinaryHeap<ElementType, 2, Compare>(compare);
+        }
+    }
+
+    // Destructor
+    template <class ElementType, class Compare>
+    MultiQueue<ElementType, Compare>::~MultiQueue(){
+        delete[] shards;
+    }
+
+    // Description: Returns the number of elements in this MultiQueue. Exact only
+    //              while no other thread is enqueueing or dequeueing.
+    // Time Efficiency: O(1)
+    template <class ElementType, class Compare>
+    unsigned int MultiQueue<ElementType, Compare>::getElementCount() const{
+        return elementCount.load(memory_order_relaxed);
+    }
+
+    // Description: Returns "true" if this MultiQueue is empty, otherwise "false".
+    //              Exact only while no other thread is enqueueing or dequeueing.
+    // Time Efficiency: O(1)
+    template <class ElementType, class Compare>
+    bool MultiQueue<ElementType, Compare>::isEmpty() const{
+        return getElementCount() == 0;
+    }
+
+    // Description: Inserts newElement in a random shard. Safe to call from any thread.
+    // Time Efficiency: O(log2 (n / shards))
+    //              The count goes up before the shard is unlocked, so a thread that
+    //              dequeues the new element cannot bring the count below zero.
+    template <class ElementType, class Compare>
+    void MultiQueue<ElementType, Compare>::enqueue(const ElementType& newElement){
+        Shard& shard = lockRandomShard();
+        lock_guard<mutex> guard(shard.lock, adopt_lock);
+        shard.heap.insert(newElement);
+        elementCount.fetch_add(1, memory_order_relaxed);
+    }
+
+    template <class ElementType, class Compare>
+    void MultiQueue<ElementType, Compare>::enqueue(ElementType&& newElement){
+        Shard& shard = lockRandomShard();
+        lock_guard<mutex> guard(shard.lock, adopt_lock);
+        shard.heap.insert(move(newElement));
+        elementCount.fetch_add(1, memory_order_relaxed);
+    }
+
+    // Description: Moves a high priority element into "element" and returns "true",
+    //              or returns "false" if every shard is empty. Safe to call from
+    //              any thread. The element is the better of two random shard tops.
+    // Time Efficiency: O(log2 (n / shards)), O(shards) when the queue runs dry
+    template <class ElementType, class Compare>
+    bool MultiQueue<ElementType, Compare>::tryDequeue(ElementType& element){
+        for(unsigned int attempt = 0; attempt < shardCount; attempt++){
+            unsigned int first = randomShard();
+            unsigned int second = randomShard();
+            if(first == second){
+                second = (second + 1) % shardCount;
+            }
+
+            // std::lock backs off instead of deadlocking against a thread
+            // that locks the same two shards in the other order.
+            lock(shards[first].lock, shards[second].lock);
+            lock_guard<mutex> firstGuard(shards[first].lock, adopt_lock);
+            lock_guard<mutex> secondGuard(shards[second].lock, adopt_lock);
+            BinaryHeap<ElementType, 2, Compare>& a = shards[first].heap;
+            BinaryHeap<ElementType, 2, Compare>& b = shards[second].heap;
+            BinaryHeap<ElementType, 2, Compare>* better = NULL;
+            if(a.getElementCount() > 0 && (b.getElementCount() == 0 || !compare(b.retrieve(), a.retrieve()))){
+                better = &a;
+            }
+            else if(b.getElementCount() > 0){
+                better = &b;
+            }
+            if(better != NULL){
+                element = better->pop();
+                elementCount.fetch_sub(1, memory_order_relaxed);
+                return true;
+            }
+        }
+        return dequeueFromAnyShard(element);
+    }
+
+    // Utility method - Returns a shard index picked uniformly at random,
+    //                  from a generator private to the calling thread.
+    template <class ElementType, class Compare>
+    unsigned int MultiQueue<ElementType, Compare>::randomShard() const{
+        static thread_local minstd_rand generator(random_device{}());
+        return generator() % shardCount;
+    }
+
+    // Utility method - Locks a random shard, preferring ones nobody else holds.
+    template <class ElementType, class Compare>
+    typename MultiQueue<ElementType, Compare>::Shard& MultiQueue<ElementType, Compare>::lockRandomShard(){
+        for(unsigned int attempt = 0; attempt < shardCount; attempt++){
+            Shard& shard = shards[randomShard()];
+            if(shard.lock.try_lock()){
+                return shard;
+            }
+        }
+        Shard& shard = shards[randomShard()];
+        shard.lock.lock();
+        return shard;
+    }
+
+    // Utility method - Locks every shard in turn and removes the top of the first
+    //                  non-empty one. Used when sampling keeps finding empty shards.
+    template <class ElementType, class Compare>
+    bool MultiQueue<ElementType, Compare>::dequeueFromAnyShard(ElementType& element){
+        for(unsigned int i = 0; i < shardCount; i++){
+            lock_guard<mutex> guard(shards[i].lock);
+            if(shards[i].heap.getElementCount() > 0){
+                element = shards[i].heap.pop();
+                elementCount.fetch_sub(1, memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
@@ -0,0 +1,92 @@
+/* 
+ * MultiQueue.h
+ *
+ * Description: Relaxed concurrent Priority Queue data collection ADT class.
+ *              MultiQueue implementation: c * P BinaryHeap shards, each behind
+ *              its own lock, for P threads. enqueue() adds to a random shard;
+ *              dequeue samples two random shards and removes the better of
+ *              their tops. The element removed is therefore not always the
+ *              global "highest" priority, but close to it: a larger c spreads
+ *              threads out more at the cost of a worse expected rank.
+ *
+ * Class Invariant:  Every shard is a Binary Heap ordered by Compare.
+ * 
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */  
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <random>
+#include "BinaryHeap.h"
+
+template <class ElementType, class Compare = less<ElementType> >
+class MultiQueue {
+
+    private:
+        // One shard: a heap and its lock, padded so neighbouring shards
+        // do not share a cache line.
+        struct Shard {
+            mutex lock;
+            BinaryHeap<ElementType, 2, Compare> heap;
+            char padding[64];
+        };
+
+        unsigned int shardCount;
+        Shard* shards;
+        Compare compare;
+        atomic<unsigned int> elementCount;
+
+        // Utility method - Returns a shard index picked uniformly at random,
+        //                  from a generator private to the calling thread.
+        unsigned int randomShard() const;
+
+        // Utility method - Locks a random shard, preferring ones nobody else holds.
+        Shard& lockRandomShard();
+
+        // Utility method - Locks every shard in turn and removes the top of the first
+        //                  non-empty one. Used when sampling keeps finding empty shards.
+        bool dequeueFromAnyShard(ElementType& element);
+
+        MultiQueue(const MultiQueue<ElementType, Compare>&);
+        MultiQueue<ElementType, Compare>& operator=(const MultiQueue<ElementType, Compare>&);
+
+    public:
+        /******* Start of MultiQueue Public Interface *******/
+        // Constructor
+        // Description: Creates shardsPerThread * threadCount empty shards.
+        //              shardsPerThread (c) is the relaxation: 2 is the usual choice.
+        MultiQueue(unsigned int threadCount, unsigned int shardsPerThread = 2, const Compare& compare = Compare());
+
+        // Destructor
+        ~MultiQueue();
+
+        // Description: Returns the number of elements in this MultiQueue. Exact only
+        //              while no other thread is enqueueing or dequeueing.
+        // Time Efficiency: O(1)
+        unsigned int getElementCount() const;
+
+        // Description: Returns "true" if this MultiQueue is empty, otherwise "false".
+        //              Exact only while no other thread is enqueueing or dequeueing.
+        // Time Efficiency: O(1)
+        bool isEmpty() const;
+
+        // Description: Inserts newElement in a random shard. Safe to call from any thread.
+        // Time Efficiency: O(log2 (n / shards))
+        void enqueue(const ElementType& newElement);
+        void enqueue(ElementType&& newElement);
+
+        // Description: Moves a high priority element into "element" and returns "true",
+        //              or returns "false" if every shard is empty. Safe to call from
+        //              any thread. The element is the better of two random shard tops.
+        // Time Efficiency: O(log2 (n / shards)), O(shards) when the queue runs dry
+        bool tryDequeue(ElementType& element);
+
+        /*******  End of MultiQueue Public Interface *******/
+};
+
+#include "MultiQueue.cpp"
@@ -1,5 +1,5 @@
 /* 
- * PriorityQueue.h
+ * PriorityQueue.cpp
  *
  * Description: Priority Queue data collection ADT class. 
  *
@@ -12,43 +12,144 @@
  */  
 
 #include "PriorityQueue.h"
+
     // Default Constructor
-    template <class ElementType>
-    PriorityQueue<ElementType>::PriorityQueue(){}
+    template <class ElementType, class Compare, class Stats>
+    PriorityQueue<ElementType, Compare, Stats>::PriorityQueue(const Compare& compare) : Queue(compare) {}
+
+    // Range Constructor
+    // Description: Builds the Priority Queue from the elements in [first, last)
+    //              with a bottom-up heap construction.
+    // Time Efficiency: O(n)
+    template <class ElementType, class Compare, class Stats>
+    template <class InputIterator>
+    PriorityQueue<ElementType, Compare, Stats>::PriorityQueue(InputIterator first, InputIterator last, const Compare& compare)
+        : Queue(first, last, compare) {}
     
     // Description: Returns "true" if this Priority Queue is empty, otherwise "false".
     // Postcondition: This Priority Queue is unchanged by this operation.
     // Time Efficiency: O(1)
-    template <class ElementType>
-    bool PriorityQueue<ElementType>::isEmpty() const{
+    template <class ElementType, class Compare, class Stats>
+    bool PriorityQueue<ElementType, Compare, Stats>::isEmpty() const{
         if(Queue.getElementCount() == 0){
             return true;
         }
         return false;
     }
 
+    // Description: Returns the number of elements in this Priority Queue.
+    // Time Efficiency: O(1)
+    template <class ElementType, class Compare, class Stats>
+    unsigned int PriorityQueue<ElementType, Compare, Stats>::getElementCount() const{
+        return Queue.getElementCount();
+    }
+
     // Description: Inserts newElement in this Priority Queue and 
     //              returns "true" if successful, otherwise "false".
-    template <class ElementType>
-    bool PriorityQueue<ElementType>::enqueue(ElementType& newElement){
+    template <class ElementType, class Compare, class Stats>
+    bool PriorityQueue<ElementType, Compare, Stats>::enqueue(const ElementType& newElement){
         return Queue.insert(newElement);
     }
 
+    // Description: Moves newElement into this Priority Queue and 
+    //              returns "true" if successful, otherwise "false".
+    template <class ElementType, class Compare, class Stats>
+    bool PriorityQueue<ElementType, Compare, Stats>::enqueue(ElementType&& newElement){
+        return Queue.insert(move(newElement));
+    }
+
+    // Description: Constructs a new element in place from args and inserts it
+    //              in this Priority Queue. Returns "true" if successful.
+    template <class ElementType, class Compare, class Stats>
+    template <class... Args>
+    bool PriorityQueue<ElementType, Compare, Stats>::emplace(Args&&... args){
+        return Queue.emplace(forward<Args>(args)...);
+    }
+
+    // Description: Inserts the elements in [first, last) in this Priority Queue.
+    // Time Efficiency: O(n + k) when k >= n, otherwise O(k log2 n)
+    template <class ElementType, class Compare, class Stats>
+    template <class InputIterator>
+    void PriorityQueue<ElementType, Compare, Stats>::enqueueRange(InputIterator first, InputIterator last){
+        Queue.insertRange(first, last);
+    }
+
     // Description: Removes (but does not return) the element with the next
     //              "highest" priority value from the Priority Queue.
     // Precondition: This Priority Queue is not empty.
     // Exception: Throws EmptyDataCollectionException if Priority Queue is empty.
-    template <class ElementType>
-    void PriorityQueue<ElementType>::dequeue(){
+    template <class ElementType, class Compare, class Stats>
+    void PriorityQueue<ElementType, Compare, Stats>::dequeue(){
         Queue.remove();
     }
+
+    // Description: Removes and returns the element with the next
+    //              "highest" priority value from the Priority Queue.
+    //              The element is moved out, not copied.
+    // Precondition: This Priority Queue is not empty.
+    // Exception: Throws EmptyDataCollectionException if Priority Queue is empty.
+    template <class ElementType, class Compare, class Stats>
+    ElementType PriorityQueue<ElementType, Compare, Stats>::pop(){
+        return Queue.pop();
+    }
     
     // Description: Returns (but does not remove) the element with the next 
     //              "highest" priority from the Priority Queue.
     // Precondition: This Priority Queue is not empty.
     // Postcondition: This Priority Queue is unchanged by this operation.
     // Exception: Throws EmptyDataCollectionException if this Priority Queue is empty.
-    template <class ElementType>
-    ElementType PriorityQueue<ElementType>::peek() const{
+    template <class ElementType, class Compare, class Stats>
+    const ElementType& PriorityQueue<ElementType, Compare, Stats>::peek() const{
         return Queue.retrieve();
     }
+
+    // Description: Removes and returns the element with the next "highest"
+    //              priority and inserts newElement with a single sift.
+    // Precondition: This Priority Queue is not empty.
+    // Exception: Throws EmptyDataCollectionException if this Priority Queue is empty.
+    // Time Efficiency: O(log2 n)
+    template <class ElementType, class Compare, class Stats>
+    ElementType PriorityQueue<ElementType, Compare, Stats>::replaceTop(const ElementType& newElement){
+        return Queue.replaceTop(newElement);
+    }
+
+    template <class ElementType, class Compare, class Stats>
+    ElementType PriorityQueue<ElementType, Compare, Stats>::replaceTop(ElementType&& newElement){
+        return Queue.replaceTop(move(newElement));
+    }
+
+    // Description: Inserts newElement, then removes and returns the element
+    //              with the next "highest" priority. If that is newElement
+    //              itself, it is returned without touching the Priority Queue.
+    // Time Efficiency: O(1) when newElement is returned, otherwise O(log2 n)
+    template <class ElementType, class Compare, class Stats>
+    ElementType PriorityQueue<ElementType, Compare, Stats>::pushPop(const ElementType& newElement){
+        return Queue.pushPop(newElement);
+    }
+
+    template <class ElementType, class Compare, class Stats>
+    ElementType PriorityQueue<ElementType, Compare, Stats>::pushPop(ElementType&& newElement){
+        return Queue.pushPop(move(newElement));
+    }
+
+    // Description: Removes up to k elements in priority order, moving each one
+    //              to out, and returns the output iterator past the last one.
+    //              Uses Floyd's bottom-up deletion.
+    // Time Efficiency: O(k log2 n)
+    template <class ElementType, class Compare, class Stats>
+    template <class OutputIterator>
+    OutputIterator PriorityQueue<ElementType, Compare, Stats>::popN(unsigned int k, OutputIterator out){
+        return Queue.popN(k, out);
+    }
+
+    // Description: Returns the Stats policy of the underlying Binary Heap.
+    // Time Efficiency: O(1)
+    template <class ElementType, class Compare, class Stats>
+    const Stats& PriorityQueue<ElementType, Compare, Stats>::getStats() const{
+        return Queue.getStats();
+    }
+
+    template <class ElementType, class Compare, class Stats>
+    void PriorityQueue<ElementType, Compare, Stats>::resetStats(){
+        Queue.getStats().reset();
+    }
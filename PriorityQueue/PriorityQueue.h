@@ -2,6 +2,12 @@
  * PriorityQueue.h
  *
  * Description: Priority Queue data collection ADT class. 
+ *              Priority is decided by Compare (std::less by default, so the
+ *              smallest element comes out first; std::greater reverses it).
+ *              Stats is passed on to the Binary Heap (see HeapStats).
+ *              Elements cannot be found again once enqueued; use
+ *              AddressablePriorityQueue to change the priority of an element
+ *              or erase it.
  *
  * Class Invariant:  Always a Minimum Binary Heap
  * 
@@ -11,80 +17,106 @@
  *
  */  
 
+#pragma once
+
 #include "BinaryHeap.h"
 
-template <class ElementType>
+template <class ElementType, class Compare = less<ElementType>, class Stats = NoHeapStats>
 class PriorityQueue {
 
     private:
-        BinaryHeap<ElementType> Queue; 
+        BinaryHeap<ElementType, 2, Compare, NoPositionTracking, Stats> Queue;
+
     public:
         /******* Start of Priority Queue Public Interface *******/
         // Default Constructor
-        PriorityQueue();
+        PriorityQueue(const Compare& compare = Compare());
+
+        // Range Constructor
+        // Description: Builds the Priority Queue from the elements in [first, last)
+        //              with a bottom-up heap construction.
+        // Time Efficiency: O(n)
+        template <class InputIterator>
+        PriorityQueue(InputIterator first, InputIterator last, const Compare& compare = Compare());
 
         // Description: Returns "true" if this Priority Queue is empty, otherwise "false".
         // Postcondition: This Priority Queue is unchanged by this operation.
         // Time Efficiency: O(1)
         bool isEmpty() const;
 
+        // Description: Returns the number of elements in this Priority Queue.
+        // Postcondition: This Priority Queue is unchanged by this operation.
+        // Time Efficiency: O(1)
+        unsigned int getElementCount() const;
+
         // Description: Inserts newElement in this Priority Queue and 
         //              returns "true" if successful, otherwise "false".
-        bool enqueue(ElementType& newElement);
+        bool enqueue(const ElementType& newElement);
+
+        // Description: Moves newElement into this Priority Queue and 
+        //              returns "true" if successful, otherwise "false".
+        bool enqueue(ElementType&& newElement);
+
+        // Description: Constructs a new element in place from args and inserts it
+        //              in this Priority Queue. Returns "true" if successful.
+        template <class... Args>
+        bool emplace(Args&&... args);
+
+        // Description: Inserts the elements in [first, last) in this Priority Queue.
+        // Time Efficiency: O(n + k) when k >= n, otherwise O(k log2 n)
+        template <class InputIterator>
+        void enqueueRange(InputIterator first, InputIterator last);
 
         // Description: Removes (but does not return) the element with the next
         //              "highest" priority value from the Priority Queue.
         // Precondition: This Priority Queue is not empty.
         // Exception: Throws EmptyDataCollectionException if Priority Queue is empty.
         void dequeue();
+
+        // Description: Removes and returns the element with the next
+        //              "highest" priority value from the Priority Queue.
+        //              The element is moved out, not copied.
+        // Precondition: This Priority Queue is not empty.
+        // Exception: Throws EmptyDataCollectionException if Priority Queue is empty.
+        ElementType pop();
         
         // Description: Returns (but does not remove) the element with the next 
         //              "highest" priority from the Priority Queue.
         // Precondition: This Priority Queue is not empty.
         // Postcondition: This Priority Queue is unchanged by this operation.
         // Exception: Throws EmptyDataCollectionException if this Priority Queue is empty.
-        ElementType peek() const;
-        
+        const ElementType& peek() const;
+
+        // Description: Removes and returns the element with the next "highest"
+        //              priority and inserts newElement with a single sift. Same
+        //              result as pop() followed by enqueue(newElement).
+        // Precondition: This Priority Queue is not empty.
+        // Exception: Throws EmptyDataCollectionException if this Priority Queue is empty.
+        // Time Efficiency: O(log2 n)
+        ElementType replaceTop(const ElementType& newElement);
+        ElementType replaceTop(ElementType&& newElement);
+
+        // Description: Inserts newElement, then removes and returns the element
+        //              with the next "highest" priority. If that is newElement
+        //              itself, it is returned without touching the Priority Queue.
+        // Time Efficiency: O(1) when newElement is returned, otherwise O(log2 n)
+        ElementType pushPop(const ElementType& newElement);
+        ElementType pushPop(ElementType&& newElement);
+
+        // Description: Removes up to k elements in priority order, moving each one
+        //              to out, and returns the output iterator past the last one.
+        //              Uses Floyd's bottom-up deletion.
+        // Time Efficiency: O(k log2 n)
+        template <class OutputIterator>
+        OutputIterator popN(unsigned int k, OutputIterator out);
+
+        // Description: Returns the Stats policy of the underlying Binary Heap,
+        //              e.g. getStats().snapshot() with HeapStats.
+        // Time Efficiency: O(1)
+        const Stats& getStats() const;
+        void resetStats();
+
         /*******  End of Priority Queue Public Interface *******/
 };
 
-    // Default constructor
-    template <class ElementType>
-        PriorityQueue<ElementType>::PriorityQueue(){}
-
-    // Description: Returns "true" if this Priority Queue is empty, otherwise "false".
-    // Postcondition: This Priority Queue is unchanged by this operation.
-    // Time Efficiency: O(1)
-    template <class ElementType>
-        bool PriorityQueue<ElementType>::isEmpty() const{
-            if(Queue.getElementCount() == 0){
-                return true;
-            }
-            return false;
-        }
-
-    // Description: Inserts newElement in this Priority Queue and 
-    //              returns "true" if successful, otherwise "false".
-    template <class ElementType>
-    bool PriorityQueue<ElementType>::enqueue(ElementType& newElement){
-        return Queue.insert(newElement);
-    }
-
-    // Description: Removes (but does not return) the element with the next
-    //              "highest" priority value from the Priority Queue.
-    // Precondition: This Priority Queue is not empty.
-    // Exception: Throws EmptyDataCollectionException if Priority Queue is empty.
-    template <class ElementType>
-    void PriorityQueue<ElementType>::dequeue(){
-        Queue.remove();
-    }
-    
-    // Description: Returns (but does not remove) the element with the next 
-    //              "highest" priority from the Priority Queue.
-    // Precondition: This Priority Queue is not empty.
-    // Postcondition: This Priority Queue is unchanged by this operation.
-    // Exception: Throws EmptyDataCollectionException if this Priority Queue is empty.
-    template <class ElementType>
-    ElementType PriorityQueue<ElementType>::peek() const{
-        return Queue.retrieve();
-    }
\ No newline at end of file
+#include "PriorityQueue.cpp"
@@ -0,0 +1,452 @@
+/*
+ * QueueBenchmark.cpp
+ *
+ * Description: Benchmark driver for the priority queues in this directory.
+ *              Usage: ./queuebench [section] [n]
+ *              section is one of the names below, or "all" (the default);
+ *              n is the number of elements (1000000 by default).
+ *              "make bench" builds it with optimizations and runs it.
+ *
+ *              overhead   What the handles cost: n random ints pushed then
+ *                         popped, and n random pushes or pops on n/2 ints, on
+ *                         BinaryHeap, PriorityQueue and AddressablePriorityQueue.
+ *              dijkstra   Shortest paths on a random graph of n/8 vertices
+ *                         and n edges, with changeKey() on an
+ *                         AddressablePriorityQueue against a PriorityQueue
+ *                         holding stale duplicates that are skipped when popped.
+ *              multiqueue Throughput of MultiQueue (c = 2) for 1 to 64 threads,
+ *                         each doing its share of n operations (half enqueues,
+ *                         half dequeues, on n/2 elements), against one
+ *                         BinaryHeap behind one mutex. Threads beyond the
+ *                         hardware threads, which the driver prints, only
+ *                         measure lock hand-offs. Then the rank error of
+ *                         tryDequeue() for c = 1, 2 and 4 with 1 to 64 threads'
+ *                         worth of shards: how many smaller elements were in
+ *                         the queue when an element came out, measured from
+ *                         one thread over n dequeues from n elements.
+ *              external   ExternalPriorityQueue with memory budgets of 64 KB,
+ *                         1 MB and 16 MB: n random ints enqueued, then popped.
+ *                         Run files go to a fresh directory under /tmp.
+              topk       The best k of n random ints, for k = 10 to 10000:
+                         TopK offered one at a time and by range, against a
+                         PriorityQueue holding all n followed by k pops.
+              stable     What first in, first out among ties costs: the
+                         overhead workloads on StablePriorityQueue and
+                         PriorityQueue, with keys drawn from 16 values (many
+                         ties) and from all ints (few ties).
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <unistd.h>
+#include "PriorityQueue.h"
+#include "AddressablePriorityQueue.h"
+#include "MultiQueue.h"
+#include "ExternalPriorityQueue.h"
+#include "StablePriorityQueue.h"
+#include "TopK.h"
+
+using namespace std;
+
+// Utility function - Milliseconds since "start".
+static double millisecondsSince(chrono::steady_clock::time_point start) {
+	return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Utility function - Returns n random keys.
+static vector<int> randomKeys(unsigned int n, unsigned int seed) {
+	mt19937 random(seed);
+	vector<int> keys(n);
+	for (unsigned int i = 0; i < n; i++)
+		keys[i] = random();
+	return keys;
+}
+
+// Keeps the compiler from dropping work whose result is never used.
+static unsigned long long checksum = 0;
+
+// Utility functions - Push and pop under the names each queue uses.
+static void push(BinaryHeap<int>& heap, int key) { heap.insert(key); }
+static void push(PriorityQueue<int>& queue, int key) { queue.enqueue(key); }
+static void push(AddressablePriorityQueue<int>& queue, int key) { queue.enqueue(key); }
+static void push(StablePriorityQueue<int>& queue, int key) { queue.enqueue(key); }
+
+// Utility function - Times both workloads on a Queue and prints one row.
+template <class Queue>
+static void benchOverheadRow(const char* name, const vector<int>& keys) {
+	unsigned int n = keys.size();
+	double pushPop, mixed;
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	{
+		Queue queue;
+		for (unsigned int i = 0; i < n; i++)
+			push(queue, keys[i]);
+		for (unsigned int i = 0; i < n; i++)
+			checksum += queue.pop();
+	}
+	pushPop = millisecondsSince(start);
+
+	{
+		Queue queue;
+		for (unsigned int i = 0; i < n/2; i++)
+			push(queue, keys[i]);
+		start = chrono::steady_clock::now();
+		for (unsigned int i = 0; i < n; i++) {
+			if ((keys[n - 1 - i] & 1) != 0 || queue.getElementCount() == 0)
+				push(queue, keys[i]);
+			else
+				checksum += queue.pop();
+		}
+		mixed = millisecondsSince(start);
+	}
+	printf("  %-26s %9.1f ms %9.1f ms\n", name, pushPop, mixed);
+}
+
+static void benchOverhead(unsigned int n) {
+	vector<int> keys = randomKeys(n, 1);
+	printf("overhead: n = %u ints\n                             push + pop      mixed\n", n);
+	benchOverheadRow<BinaryHeap<int> >("BinaryHeap", keys);
+	benchOverheadRow<PriorityQueue<int> >("PriorityQueue", keys);
+	benchOverheadRow<AddressablePriorityQueue<int> >("AddressablePriorityQueue", keys);
+}
+
+static void benchStable(unsigned int n) {
+	const char* ties[] = { "many ties", "few ties" };
+	for (unsigned int t = 0; t < 2; t++) {
+		vector<int> keys = randomKeys(n, 6);
+		if (t == 0)
+			for (unsigned int i = 0; i < n; i++)
+				keys[i] &= 15;
+		printf("stable: n = %u ints, %s\n                             push + pop      mixed\n", n, ties[t]);
+		benchOverheadRow<PriorityQueue<int> >("PriorityQueue", keys);
+		benchOverheadRow<StablePriorityQueue<int> >("StablePriorityQueue", keys);
+	}
+}
+
+// Graph in compressed adjacency form: the edges leaving v are
+// targets[first[v] .. first[v+1]-1], with the same weights.
+struct Graph {
+	vector<unsigned int> first;
+	vector<unsigned int> targets;
+	vector<unsigned int> weights;
+};
+
+// Utility function - Random graph with "vertices" vertices and "edges" edges. A
+// cycle through every vertex keeps them all reachable from vertex 0.
+static Graph randomGraph(unsigned int vertices, unsigned int edges) {
+	mt19937 random(3);
+	vector<vector<pair<unsigned int, unsigned int> > > lists(vertices);
+	for (unsigned int v = 0; v < vertices; v++)
+		lists[v].push_back(make_pair((v + 1) % vertices, 1 + random() % 1000000));
+	for (unsigned int i = vertices; i < edges; i++)
+		lists[random() % vertices].push_back(make_pair(random() % vertices, 1 + random() % 1000));
+	Graph graph;
+	for (unsigned int v = 0; v < vertices; v++) {
+		graph.first.push_back(graph.targets.size());
+		for (unsigned int i = 0; i < lists[v].size(); i++) {
+			graph.targets.push_back(lists[v][i].first);
+			graph.weights.push_back(lists[v][i].second);
+		}
+	}
+	graph.first.push_back(graph.targets.size());
+	return graph;
+}
+
+typedef pair<unsigned long long, unsigned int> Label;    // Distance, vertex
+static const unsigned long long UNREACHED = ~0ull;
+
+// Dijkstra's algorithm with one queue entry per vertex, lowered with changeKey().
+static vector<unsigned long long> dijkstraChangeKey(const Graph& graph, unsigned int& peak) {
+	typedef AddressablePriorityQueue<Label>::Handle Handle;
+	unsigned int vertices = graph.first.size() - 1;
+	vector<unsigned long long> distance(vertices, UNREACHED);
+	vector<Handle> handles(vertices, 0);
+	AddressablePriorityQueue<Label> queue;
+	distance[0] = 0;
+	handles[0] = queue.enqueue(Label(0, 0));
+	peak = 1;
+	while (!queue.isEmpty()) {
+		unsigned int v = queue.pop().second;
+		for (unsigned int i = graph.first[v]; i < graph.first[v + 1]; i++) {
+			unsigned int w = graph.targets[i];
+			unsigned long long through = distance[v] + graph.weights[i];
+			if (through < distance[w]) {
+				if (distance[w] == UNREACHED)
+					handles[w] = queue.enqueue(Label(through, w));
+				else
+					queue.changeKey(handles[w], Label(through, w));
+				distance[w] = through;
+			}
+		}
+		if (queue.getElementCount() > peak)
+			peak = queue.getElementCount();
+	}
+	return distance;
+}
+
+// Dijkstra's algorithm that enqueues a vertex again whenever its distance drops,
+// and skips the entries that are out of date when they come out.
+static vector<unsigned long long> dijkstraLazy(const Graph& graph, unsigned int& peak) {
+	unsigned int vertices = graph.first.size() - 1;
+	vector<unsigned long long> distance(vertices, UNREACHED);
+	PriorityQueue<Label> queue;
+	distance[0] = 0;
+	queue.enqueue(Label(0, 0));
+	peak = 1;
+	while (!queue.isEmpty()) {
+		Label label = queue.pop();
+		unsigned int v = label.second;
+		if (label.first != distance[v])
+			continue;
+		for (unsigned int i = graph.first[v]; i < graph.first[v + 1]; i++) {
+			unsigned int w = graph.targets[i];
+			unsigned long long through = distance[v] + graph.weights[i];
+			if (through < distance[w]) {
+				queue.enqueue(Label(through, w));
+				distance[w] = through;
+			}
+		}
+		if (queue.getElementCount() > peak)
+			peak = queue.getElementCount();
+	}
+	return distance;
+}
+
+static void benchDijkstra(unsigned int n) {
+	unsigned int vertices = n/8 > 1 ? n/8 : 2;
+	Graph graph = randomGraph(vertices, n > vertices ? n : vertices);
+	printf("dijkstra: %u vertices, %u edges\n", vertices, (unsigned int)graph.targets.size());
+
+	unsigned int peak;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	vector<unsigned long long> exact = dijkstraChangeKey(graph, peak);
+	printf("  %-26s %9.1f ms   peak size %u\n", "changeKey", millisecondsSince(start), peak);
+
+	start = chrono::steady_clock::now();
+	vector<unsigned long long> lazy = dijkstraLazy(graph, peak);
+	printf("  %-26s %9.1f ms   peak size %u\n", "lazy duplicates", millisecondsSince(start), peak);
+
+	if (exact != lazy)
+		printf("  the two runs found different distances!\n");
+	for (unsigned int v = 0; v < vertices; v++)
+		checksum += exact[v];
+}
+
+// One BinaryHeap behind one mutex, for comparison with MultiQueue.
+struct LockedHeap {
+	mutex lock;
+	BinaryHeap<int> heap;
+
+	LockedHeap(unsigned int) {}
+	void enqueue(int key) { lock_guard<mutex> guard(lock); heap.insert(key); }
+	bool tryDequeue(int& key) {
+		lock_guard<mutex> guard(lock);
+		if (heap.getElementCount() == 0) return false;
+		key = heap.pop();
+		return true;
+	}
+};
+
+// Utility function - Runs "threadCount" threads that share n operations on queue,
+//                    after loading n/2 elements, and returns millions of operations
+//                    per second.
+template <class Queue>
+static double runThreads(Queue& queue, const vector<int>& keys, unsigned int threadCount) {
+	unsigned int n = keys.size();
+	for (unsigned int i = 0; i < n/2; i++)
+		queue.enqueue(keys[i]);
+	vector<unsigned long long> sums(threadCount, 0);
+	vector<thread> threads;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (unsigned int t = 0; t < threadCount; t++) {
+		threads.push_back(thread([&queue, &keys, &sums, t, threadCount, n]() {
+			int key;
+			for (unsigned int i = t; i < n; i += threadCount) {
+				if (i % 2 == 0)
+					queue.enqueue(keys[i]);
+				else if (queue.tryDequeue(key))
+					sums[t] += key;
+			}
+		}));
+	}
+	for (unsigned int t = 0; t < threadCount; t++)
+		threads[t].join();
+	double milliseconds = millisecondsSince(start);
+	for (unsigned int t = 0; t < threadCount; t++)
+		checksum += sums[t];
+	return n/milliseconds/1000;
+}
+
+// Utility function - Fenwick tree over [0, n): how many of the keys are present.
+struct PresentKeys {
+	vector<unsigned int> tree;
+
+	PresentKeys(unsigned int n) : tree(n + 1, 0) {}
+	void add(unsigned int key, int change) {
+		for (unsigned int i = key + 1; i < tree.size(); i += i & (0 - i))
+			tree[i] += change;
+	}
+	// Keys present that are smaller than "key".
+	unsigned int countBelow(unsigned int key) const {
+		unsigned int count = 0;
+		for (unsigned int i = key; i > 0; i -= i & (0 - i))
+			count += tree[i];
+		return count;
+	}
+};
+
+static void benchMultiQueue(unsigned int n) {
+	vector<int> keys = randomKeys(n, 4);
+	printf("multiqueue: n = %u operations, %u hardware threads\n"
+	       "  threads   MultiQueue   locked BinaryHeap (million operations/s)\n",
+	       n, thread::hardware_concurrency());
+	for (unsigned int threadCount = 1; threadCount <= 64; threadCount *= 2) {
+		MultiQueue<int> multiQueue(threadCount);
+		LockedHeap locked(threadCount);
+		double multi = runThreads(multiQueue, keys, threadCount);
+		double single = runThreads(locked, keys, threadCount);
+		printf("  %7u %12.2f %19.2f\n", threadCount, multi, single);
+	}
+
+	// Distinct keys 0 .. n-1 in random order, so ranks are well defined
+	vector<int> order(n);
+	for (unsigned int i = 0; i < n; i++)
+		order[i] = i;
+	shuffle(order.begin(), order.end(), mt19937(5));
+	printf("multiqueue rank error: n = %u dequeues\n  shards/thread  threads   mean rank    max rank\n", n);
+	for (unsigned int shardsPerThread = 1; shardsPerThread <= 4; shardsPerThread *= 2) {
+		for (unsigned int threadCount = 1; threadCount <= 64; threadCount *= 4) {
+			MultiQueue<int> queue(threadCount, shardsPerThread);
+			PresentKeys present(n);
+			for (unsigned int i = 0; i < n; i++) {
+				queue.enqueue(order[i]);
+				present.add(order[i], 1);
+			}
+			unsigned long long total = 0;
+			unsigned int worst = 0;
+			int key;
+			while (queue.tryDequeue(key)) {
+				unsigned int rank = present.countBelow(key);
+				present.add(key, -1);
+				total += rank;
+				if (rank > worst) worst = rank;
+			}
+			printf("  %13u %8u %11.2f %11u\n", shardsPerThread, threadCount, (double)total/n, worst);
+		}
+	}
+}
+
+// Utility function - Times n enqueues, then n pops, on an ExternalPriorityQueue
+//                    for a few memory budgets.
+static void benchExternal(unsigned int n) {
+	char pattern[] = "/tmp/queuebench-XXXXXX";
+	if (mkdtemp(pattern) == NULL) {
+		printf("external: could not create a directory under /tmp\n");
+		return;
+	}
+	vector<int> keys = randomKeys(n, 4);
+	printf("external: n = %u ints\n           budget    enqueue        pop\n", n);
+	size_t budgets[] = { 64 << 10, 1 << 20, 16 << 20 };
+	for (unsigned int b = 0; b < 3; b++) {
+		ExternalPriorityQueue<int> queue(pattern, budgets[b]);
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		for (unsigned int i = 0; i < n; i++)
+			queue.enqueue(keys[i]);
+		double enqueue = millisecondsSince(start);
+		start = chrono::steady_clock::now();
+		while (!queue.isEmpty())
+			checksum += queue.pop();
+		printf("  %12zu B %7.1f ms %7.1f ms\n", budgets[b], enqueue, millisecondsSince(start));
+	}
+	rmdir(pattern);
+}
+
+// Utility function - Times selecting the best k of n keys with TopK, and with
+//                    a PriorityQueue that takes every key and gives k back.
+static void benchTopK(unsigned int n) {
+	vector<int> keys = randomKeys(n, 5);
+	printf("topk: n = %u ints\n           k   TopK offer   TopK range   PriorityQueue\n", n);
+	unsigned int ks[] = { 10, 100, 1000, 10000 };
+	for (unsigned int i = 0; i < 4; i++) {
+		unsigned int k = min(ks[i], n);
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		{
+			TopK<int> selector(k);
+			for (unsigned int j = 0; j < n; j++)
+				selector.offer(keys[j]);
+			checksum += selector.extract().size();
+		}
+		double offer = millisecondsSince(start);
+
+		start = chrono::steady_clock::now();
+		{
+			TopK<int> selector(k);
+			selector.offer(keys.begin(), keys.end());
+			checksum += selector.extract().size();
+		}
+		double range = millisecondsSince(start);
+
+		start = chrono::steady_clock::now();
+		{
+			PriorityQueue<int> queue;
+			for (unsigned int j = 0; j < n; j++)
+				queue.enqueue(keys[j]);
+			for (unsigned int j = 0; j < k; j++)
+				checksum += queue.pop();
+		}
+		printf("  %10u %9.1f ms %9.1f ms %12.1f ms\n", k, offer, range, millisecondsSince(start));
+	}
+}
+
+int main(int argc, char** argv) {
+	const char* section = argc > 1 ? argv[1] : "all";
+	unsigned int n = argc > 2 ? strtoul(argv[2], NULL, 10) : 1000000;
+	bool all = strcmp(section, "all") == 0;
+	bool ran = false;
+
+	if (all || strcmp(section, "overhead") == 0) {
+		benchOverhead(n);
+		ran = true;
+	}
+	if (all || strcmp(section, "dijkstra") == 0) {
+		benchDijkstra(n);
+		ran = true;
+	}
+	if (all || strcmp(section, "multiqueue") == 0) {
+		benchMultiQueue(n);
+		ran = true;
+	}
+	if (all || strcmp(section, "external") == 0) {
+		benchExternal(n);
+		ran = true;
+	}
+	if (all || strcmp(section, "topk") == 0) {
+		benchTopK(n);
+		ran = true;
+	}
+	if (all || strcmp(section, "stable") == 0) {
+		benchStable(n);
+		ran = true;
+	}
+	if (!ran) {
+		printf("Unknown section \"%s\".\n", section);
+		return 1;
+	}
+	printf("(checksum %llu)\n", checksum);
+	return 0;
+}
@@ -0,0 +1,715 @@
+/*
+ * QueueCheck.cpp
+ *
+ * Description: Randomized checks of the priority queues in this directory.
+ *              Every queue is driven by random operations (with many equal
+ *              keys) next to a simple reference model, and must agree with
+ *              it after each step. Built with AddressSanitizer and
+ *              UndefinedBehaviorSanitizer by "make check", which also runs it.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include "PriorityQueue.h"
+#include "AddressablePriorityQueue.h"
+#include "MinMaxHeap.h"
+#include "MultiQueue.h"
+#include "ExternalPriorityQueue.h"
+#include "StablePriorityQueue.h"
+#include "TopK.h"
+
+using namespace std;
+
+// Stops the run with the failed condition and its line.
+#define CHECK(condition) \
+	do { if (!(condition)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); exit(1); } } while (0)
+
+// Random enqueues, pops, replaceTop and pushPop on a PriorityQueue, against a multiset.
+static void checkPriorityQueue(mt19937& random) {
+	for (unsigned int round = 0; round < 40; round++) {
+		PriorityQueue<int, greater<int> > queue;
+		multiset<int, greater<int> > reference;
+		unsigned int range = 1 + random() % 1000;
+		for (unsigned int step = 0; step < 3000; step++) {
+			int key = random() % range;
+			unsigned int operation = random() % 5;
+			if (operation <= 1 || reference.empty()) {
+				CHECK(queue.enqueue(key));
+				reference.insert(key);
+			}
+			else if (operation == 2) {
+				CHECK(queue.pop() == *reference.begin());
+				reference.erase(reference.begin());
+			}
+			else if (operation == 3) {
+				CHECK(queue.replaceTop(key) == *reference.begin());
+				reference.erase(reference.begin());
+				reference.insert(key);
+			}
+			else {
+				reference.insert(key);
+				CHECK(queue.pushPop(key) == *reference.begin());
+				reference.erase(reference.begin());
+			}
+			CHECK(queue.getElementCount() == reference.size());
+			if (!reference.empty())
+				CHECK(queue.peek() == *reference.begin());
+		}
+		vector<int> rest;
+		queue.popN(reference.size(), back_inserter(rest));
+		CHECK(rest == vector<int>(reference.begin(), reference.end()));
+		CHECK(queue.isEmpty());
+	}
+}
+
+// Orders unique_ptr<int> by the ints they own.
+struct PointeeLess {
+	bool operator()(const unique_ptr<int>& lhs, const unique_ptr<int>& rhs) const { return *lhs < *rhs; }
+};
+
+// Move-only elements through enqueue(), replaceTop(), pushPop() and pop(),
+// against a multiset of the ints they own.
+static void checkMoveOnly(mt19937& random) {
+	PriorityQueue<unique_ptr<int>, PointeeLess> queue;
+	multiset<int> reference;
+	for (unsigned int step = 0; step < 3000; step++) {
+		int key = random() % 100;
+		unsigned int operation = random() % 4;
+		if (operation == 0 || reference.empty()) {
+			CHECK(queue.enqueue(unique_ptr<int>(new int(key))));
+			reference.insert(key);
+		}
+		else if (operation == 1) {
+			CHECK(*queue.pop() == *reference.begin());
+			reference.erase(reference.begin());
+		}
+		else if (operation == 2) {
+			CHECK(*queue.replaceTop(unique_ptr<int>(new int(key))) == *reference.begin());
+			reference.erase(reference.begin());
+			reference.insert(key);
+		}
+		else {
+			reference.insert(key);
+			CHECK(*queue.pushPop(unique_ptr<int>(new int(key))) == *reference.begin());
+			reference.erase(reference.begin());
+		}
+		CHECK(queue.getElementCount() == reference.size());
+		if (!reference.empty())
+			CHECK(*queue.peek() == *reference.begin());
+	}
+}
+
+typedef AddressablePriorityQueue<int>::Handle Handle;
+
+// Utility function - After the top element (whose key is "top") left queue,
+// finds its handle, which must be the one handle of that key no longer queued,
+// drops it from the model and returns it.
+static Handle dropTop(const AddressablePriorityQueue<int>& queue, map<Handle, int>& reference,
+                      set<pair<int, Handle> >& order, int top) {
+	// Equal keys may leave in any order
+	set<pair<int, Handle> >::iterator it = order.begin();
+	Handle gone = 0;
+	while (it != order.end() && it->first == top) {
+		if (!queue.isQueued(it->second)) {
+			CHECK(gone == 0);
+			gone = it->second;
+			reference.erase(it->second);
+			order.erase(it++);
+		}
+		else
+			++it;
+	}
+	CHECK(gone != 0);
+	return gone;
+}
+
+// Random enqueues, pops, replaceTop, pushPop, changeKey and erase on an
+// AddressablePriorityQueue, against a map from handle to element. Every handle
+// the model holds must be queued, a handle must stop being queued when its
+// element leaves, and a new element never gets the handle just released.
+static void checkAddressable(mt19937& random) {
+	for (unsigned int round = 0; round < 40; round++) {
+		AddressablePriorityQueue<int> queue;
+		map<Handle, int> reference;
+		set<pair<int, Handle> > order;
+		unsigned int range = 1 + random() % 1000;
+		for (unsigned int step = 0; step < 3000; step++) {
+			int key = random() % range;
+			unsigned int operation = random() % 8;
+			if (operation <= 1 || reference.empty()) {
+				Handle handle = queue.enqueue(key);
+				CHECK(handle != 0 && reference.count(handle) == 0);
+				reference[handle] = key;
+				order.insert(make_pair(key, handle));
+			}
+			else if (operation == 2) {
+				int top = order.begin()->first;
+				CHECK(queue.pop() == top);
+				dropTop(queue, reference, order, top);
+			}
+			else if (operation == 3) {
+				int top = order.begin()->first;
+				Handle handle = queue.replaceTop(key);
+				CHECK(handle != 0 && reference.count(handle) == 0);
+				CHECK(handle != dropTop(queue, reference, order, top));
+				reference[handle] = key;
+				order.insert(make_pair(key, handle));
+			}
+			else if (operation == 4) {
+				int top = order.begin()->first;
+				Handle handle = 1;
+				if (key <= top) {
+					// newElement comes straight back and the queue is untouched
+					CHECK(queue.pushPop(key, &handle) == key);
+					CHECK(handle == 0);
+				}
+				else {
+					CHECK(queue.pushPop(key, &handle) == top);
+					CHECK(handle != 0 && reference.count(handle) == 0);
+					CHECK(handle != dropTop(queue, reference, order, top));
+					reference[handle] = key;
+					order.insert(make_pair(key, handle));
+				}
+			}
+			else {
+				map<Handle, int>::iterator it = reference.begin();
+				advance(it, random() % reference.size());
+				Handle handle = it->first;
+				order.erase(make_pair(it->second, handle));
+				if (operation == 7) {
+					queue.erase(handle);
+					reference.erase(it);
+					CHECK(!queue.isQueued(handle));
+				}
+				else {
+					queue.changeKey(handle, key);
+					it->second = key;
+					order.insert(make_pair(key, handle));
+				}
+			}
+			CHECK(queue.getElementCount() == reference.size());
+			if (!reference.empty())
+				CHECK(queue.peek() == order.begin()->first);
+		}
+		for (map<Handle, int>::iterator it = reference.begin(); it != reference.end(); ++it)
+			CHECK(queue.isQueued(it->first));
+		bool threw = false;
+		try { queue.changeKey(0, 1); } catch (ElementDoesNotExistException&) { threw = true; }
+		CHECK(threw);
+		while (!queue.isEmpty()) {
+			CHECK(queue.pop() == order.begin()->first);
+			order.erase(order.begin());
+		}
+		for (map<Handle, int>::iterator it = reference.begin(); it != reference.end(); ++it)
+			CHECK(!queue.isQueued(it->first));
+	}
+}
+
+// A handle kept after its element left stays invalid once its slot is reused:
+// isQueued() says so, and changeKey() and erase() throw without touching the
+// element that now has the slot.
+static void checkStaleHandles() {
+	AddressablePriorityQueue<int> queue;
+	Handle first = queue.enqueue(5);
+	CHECK(queue.pop() == 5);
+	Handle second = queue.enqueue(7);
+	CHECK((unsigned int)second == (unsigned int)first && second != first);
+	CHECK(!queue.isQueued(first) && queue.isQueued(second));
+	bool threw = false;
+	try { queue.changeKey(first, 1); } catch (ElementDoesNotExistException&) { threw = true; }
+	CHECK(threw);
+	threw = false;
+	try { queue.erase(first); } catch (ElementDoesNotExistException&) { threw = true; }
+	CHECK(threw);
+	CHECK(queue.getElementCount() == 1 && queue.peek() == 7);
+
+	// Through erase(), replaceTop() and popN() too
+	queue.erase(second);
+	Handle third = queue.enqueue(3);
+	CHECK(!queue.isQueued(second) && queue.isQueued(third));
+	Handle fourth = queue.replaceTop(4);
+	CHECK(!queue.isQueued(third) && queue.isQueued(fourth));
+	vector<int> out;
+	queue.popN(1, back_inserter(out));
+	Handle fifth = queue.enqueue(9);
+	CHECK(!queue.isQueued(fourth) && queue.isQueued(fifth));
+	CHECK(out.size() == 1 && out[0] == 4 && queue.peek() == 9);
+}
+
+// Utility function - Checks every count of a HeapStats snapshot. depths lists
+//                    siftDepths[0], siftDepths[1], ...; deeper ones must be 0.
+static void checkCounts(const HeapStatsSnapshot& counts, unsigned long long comparisons, unsigned long long moves,
+                        unsigned long long insertions, unsigned long long removals, unsigned long long replacements,
+                        unsigned long long reallocations, unsigned int peakSize, vector<unsigned long long> depths) {
+	CHECK(counts.comparisons == comparisons);
+	CHECK(counts.moves == moves);
+	CHECK(counts.insertions == insertions);
+	CHECK(counts.removals == removals);
+	CHECK(counts.replacements == replacements);
+	CHECK(counts.reallocations == reallocations);
+	CHECK(counts.peakSize == peakSize);
+	depths.resize(HeapStatsSnapshot::SIFT_DEPTHS, 0);
+	for (unsigned int d = 0; d < HeapStatsSnapshot::SIFT_DEPTHS; d++)
+		CHECK(counts.siftDepths[d] == depths[d]);
+}
+
+// HeapStats seen through PriorityQueue and AddressablePriorityQueue: the
+// sequence of HeapCheck's checkStats gives the same counts, which the handles
+// do not change, and changeKey() and erase() add theirs.
+static void checkStats() {
+	PriorityQueue<int, less<int>, HeapStats> queue;
+	queue.enqueue(5);
+	queue.enqueue(3);
+	queue.enqueue(8);
+	queue.enqueue(1);
+	checkCounts(queue.getStats().snapshot(), 4, 9, 4, 0, 0, 1, 4, { 2, 1, 1 });
+	CHECK(queue.pop() == 1);
+	CHECK(queue.pop() == 3);
+	CHECK(queue.replaceTop(9) == 5);
+	CHECK(queue.pushPop(20) == 8);
+	CHECK(queue.pushPop(4) == 4);
+	checkCounts(queue.getStats().snapshot(), 11, 21, 4, 2, 2, 1, 4, { 2, 5, 1 });
+	queue.resetStats();
+	checkCounts(queue.getStats().snapshot(), 0, 0, 0, 0, 0, 0, 0, {});
+
+	AddressablePriorityQueue<int, less<int>, HeapStats> addressable;
+	addressable.enqueue(5);
+	addressable.enqueue(3);
+	addressable.enqueue(8);
+	addressable.enqueue(1);
+	checkCounts(addressable.getStats().snapshot(), 4, 9, 4, 0, 0, 1, 4, { 2, 1, 1 });
+	CHECK(addressable.pop() == 1);
+	CHECK(addressable.pop() == 3);
+	Handle nine = addressable.replaceTop(9);
+	Handle twenty = 0;
+	CHECK(addressable.pushPop(20, &twenty) == 8);
+	CHECK(addressable.pushPop(4) == 4);
+	checkCounts(addressable.getStats().snapshot(), 11, 21, 4, 2, 2, 1, 4, { 2, 5, 1 });
+	// [9 20] -> [2 9]: 2 comparisons, up 1 level: 3 moves
+	addressable.changeKey(twenty, 2);
+	checkCounts(addressable.getStats().snapshot(), 13, 24, 4, 2, 3, 1, 4, { 2, 6, 1 });
+	// The last element goes without moving anything
+	addressable.erase(nine);
+	checkCounts(addressable.getStats().snapshot(), 13, 24, 4, 3, 3, 1, 4, { 2, 6, 1 });
+	CHECK(addressable.getElementCount() == 1 && addressable.peek() == 2);
+	addressable.resetStats();
+	checkCounts(addressable.getStats().snapshot(), 0, 0, 0, 0, 0, 0, 0, {});
+}
+
+// Element of a Stable Priority Queue: ordered by key only, and tagged with the
+// order in which it was enqueued.
+struct Tagged {
+	int key;
+	unsigned int order;
+
+	Tagged(int key, unsigned int order) : key(key), order(order) {}
+};
+
+struct TaggedCompare {
+	bool operator()(const Tagged& lhs, const Tagged& rhs) const { return lhs.key < rhs.key; }
+};
+
+// Random enqueues and pops on a StablePriorityQueue renumbering every
+// RenumberInterval enqueues, against a map from each key to the orders of its
+// elements: equal keys must come out first in, first out.
+template <uint32_t RenumberInterval>
+static void checkStable(mt19937& random) {
+	for (unsigned int round = 0; round < 20; round++) {
+		unsigned int order = 0;
+		unsigned int range = 1 + random() % 50;
+		vector<Tagged> initial;
+		for (unsigned int i = random() % 100; i > 0; i--)
+			initial.push_back(Tagged(random() % range, order++));
+		StablePriorityQueue<Tagged, TaggedCompare, RenumberInterval> queue(initial.begin(), initial.end());
+		map<int, vector<unsigned int> > reference;      // Orders still queued, oldest first, by key
+		for (unsigned int i = 0; i < initial.size(); i++)
+			reference[initial[i].key].push_back(initial[i].order);
+
+		for (unsigned int step = 0; step < 5000; step++) {
+			if (random() % 5 < 3 || reference.empty()) {
+				Tagged element(random() % range, order++);
+				if (random() % 2)
+					queue.enqueue(element);
+				else
+					queue.emplace(element.key, element.order);
+				reference[element.key].push_back(element.order);
+			}
+			else {
+				map<int, vector<unsigned int> >::iterator smallest = reference.begin();
+				CHECK(queue.peek().key == smallest->first && queue.peek().order == smallest->second.front());
+				Tagged next = queue.pop();
+				CHECK(next.key == smallest->first && next.order == smallest->second.front());
+				smallest->second.erase(smallest->second.begin());
+				if (smallest->second.empty())
+					reference.erase(smallest);
+			}
+		}
+
+		unsigned int left = 0;
+		for (map<int, vector<unsigned int> >::iterator key = reference.begin(); key != reference.end(); ++key)
+			left += key->second.size();
+		CHECK(queue.getElementCount() == left);
+		for (map<int, vector<unsigned int> >::iterator key = reference.begin(); key != reference.end(); ++key) {
+			for (unsigned int i = 0; i < key->second.size(); i++) {
+				Tagged next = queue.pop();
+				CHECK(next.key == key->first && next.order == key->second[i]);
+			}
+		}
+		CHECK(queue.isEmpty());
+	}
+}
+
+// Random enqueues, popMin and popMax on a MinMaxHeap, against a multiset.
+// Copies must be independent of the heap they came from.
+static void checkMinMaxHeap(mt19937& random) {
+	for (unsigned int round = 0; round < 40; round++) {
+		MinMaxHeap<int> heap;
+		multiset<int> reference;
+		unsigned int range = 1 + random() % 1000;
+		for (unsigned int step = 0; step < 3000; step++) {
+			unsigned int operation = random() % 5;
+			if (operation <= 2 || reference.empty()) {
+				int key = random() % range;
+				CHECK(heap.enqueue(key));
+				reference.insert(key);
+			}
+			else if (operation == 3) {
+				CHECK(heap.popMin() == *reference.begin());
+				reference.erase(reference.begin());
+			}
+			else {
+				CHECK(heap.popMax() == *reference.rbegin());
+				reference.erase(prev(reference.end()));
+			}
+			CHECK(heap.getElementCount() == reference.size());
+			if (!reference.empty()) {
+				CHECK(heap.peekMin() == *reference.begin());
+				CHECK(heap.peekMax() == *reference.rbegin());
+			}
+		}
+		MinMaxHeap<int> copy(heap);
+		heap.enqueue(-1);
+		vector<int> drained;
+		while (!copy.isEmpty())
+			drained.push_back(copy.popMax());
+		CHECK(drained == vector<int>(reference.rbegin(), reference.rend()));
+		CHECK(heap.popMin() == -1);
+	}
+
+	vector<string> words;
+	MinMaxHeap<string> strings;
+	for (unsigned int i = 0; i < 500; i++) {
+		words.push_back(to_string(random() % 100) + string(i % 40, '.'));
+		strings.enqueue(words.back());
+	}
+	sort(words.begin(), words.end());
+	for (unsigned int i = 0; i < words.size()/2; i++) {
+		CHECK(strings.popMin() == words[i]);
+		CHECK(strings.popMax() == words[words.size() - 1 - i]);
+	}
+	CHECK(strings.isEmpty());
+}
+
+// Threads enqueueing and dequeueing on a MultiQueue at the same time: every
+// element comes out exactly once and the count ends at 0. Alone, a thread
+// gets its elements back in order when there is a single pair of shards to
+// sample, since tryDequeue() then compares both tops.
+static void checkMultiQueue() {
+	const unsigned int threadCount = 4;
+	const unsigned int perThread = 20000;
+	MultiQueue<int> queue(threadCount);
+	vector<vector<int> > taken(threadCount);
+	vector<thread> threads;
+	for (unsigned int t = 0; t < threadCount; t++) {
+		threads.push_back(thread([&queue, &taken, t]() {
+			for (unsigned int i = 0; i < perThread; i++) {
+				queue.enqueue(t*perThread + i);
+				int element;
+				if (i % 2 == 1 && queue.tryDequeue(element))
+					taken[t].push_back(element);
+			}
+		}));
+	}
+	for (unsigned int t = 0; t < threadCount; t++)
+		threads[t].join();
+	vector<int> all;
+	for (unsigned int t = 0; t < threadCount; t++)
+		all.insert(all.end(), taken[t].begin(), taken[t].end());
+	CHECK(queue.getElementCount() == threadCount*perThread - all.size());
+	int element;
+	while (queue.tryDequeue(element))
+		all.push_back(element);
+	CHECK(queue.isEmpty());
+	sort(all.begin(), all.end());
+	for (unsigned int i = 0; i < threadCount*perThread; i++)
+		CHECK(all[i] == (int)i);
+
+	MultiQueue<int, greater<int> > pair(1, 2);
+	for (int i = 0; i < 1000; i++)
+		pair.enqueue(i);
+	for (int i = 999; i >= 0; i--) {
+		CHECK(pair.tryDequeue(element));
+		CHECK(element == i);
+	}
+	CHECK(!pair.tryDequeue(element));
+}
+
+// Element whose copies throw once the shared budget runs out. Moves never
+// throw: the Binary Heap sifts by moving and needs them not to.
+struct Fragile {
+	static int budget;
+	static int alive;
+	int key;
+	string payload;
+
+	Fragile(int key) : key(key), payload(40, '*') { alive++; }
+	Fragile(const Fragile& other) : key(other.key), payload(other.payload) { spend(); alive++; }
+	Fragile(Fragile&& other) noexcept : key(other.key), payload(move(other.payload)) { alive++; }
+	Fragile& operator=(const Fragile& other) { key = other.key; payload = other.payload; return *this; }
+	Fragile& operator=(Fragile&& other) noexcept { key = other.key; payload = move(other.payload); return *this; }
+	~Fragile() { alive--; }
+	bool operator<(const Fragile& other) const { return key < other.key; }
+	static void spend() { if (--budget < 0) throw budget; }
+};
+int Fragile::budget = 1 << 30;
+int Fragile::alive = 0;
+
+// emplace and enqueueRange interrupted by a throwing element give back the
+// handle slots of the elements that did not make it in. A slot that leaked
+// would never be queued again, so after enough further enqueues there would be
+// a gap among the slots 1 .. largest handed out (the low 32 bits of a handle).
+static void checkHandleExceptionSafety(mt19937& random) {
+	typedef AddressablePriorityQueue<Fragile>::Handle Handle;
+	{
+		AddressablePriorityQueue<Fragile> queue;
+		vector<Fragile> input;
+		for (unsigned int i = 0; i < 200; i++)
+			input.push_back(Fragile(random() % 1000));
+
+		for (int budget = 0; budget < 400; budget += 13) {
+			Fragile::budget = budget;
+			try { queue.enqueueRange(input.begin(), input.end()); } catch (int) {}
+			Fragile::budget = budget % 3;
+			try { queue.emplace(Fragile(7)); } catch (int) {}
+		}
+		Fragile::budget = 1 << 30;
+
+		// More enqueues than there can be free slots, so new ones get made.
+		// The queued slots are distinct, so if there are as many as the largest
+		// one, every slot from 1 up is queued.
+		unsigned int largest = 0;
+		for (unsigned int i = 0; i < 2*input.size() + 2; i++) {
+			Handle handle = queue.enqueue(Fragile(i));
+			CHECK(queue.isQueued(handle));
+			largest = max(largest, (unsigned int)handle);
+		}
+		CHECK(queue.getElementCount() == largest);
+
+		int previous = -1;
+		while (!queue.isEmpty()) {
+			int key = queue.pop().key;
+			CHECK(key >= previous);
+			previous = key;
+		}
+	}
+	CHECK(Fragile::alive == 0);
+}
+
+// Utility function - Returns the number of files in directory.
+static unsigned int filesIn(const string& directory) {
+	unsigned int count = 0;
+	DIR* listing = opendir(directory.c_str());
+	CHECK(listing != NULL);
+	while (dirent* entry = readdir(listing))
+		if (entry->d_name[0] != '.')
+			count++;
+	closedir(listing);
+	return count;
+}
+
+// Utility function - Limits the size of any file this process writes, or lifts
+//                    the limit when "bytes" is RLIM_INFINITY.
+static void limitFileSize(rlim_t bytes) {
+	rlimit limit;
+	CHECK(getrlimit(RLIMIT_FSIZE, &limit) == 0);
+	limit.rlim_cur = bytes == RLIM_INFINITY ? limit.rlim_max : bytes;
+	CHECK(setrlimit(RLIMIT_FSIZE, &limit) == 0);
+}
+
+// Utility function - One random step on an External Priority Queue and on its
+//                    reference model. Returns "false" if the queue threw
+//                    ExternalStorageException, which must leave it unchanged.
+static bool externalStep(mt19937& random, ExternalPriorityQueue<int>& queue, multiset<int>& reference, unsigned int range) {
+	try {
+		if (random() % 4 != 0 || reference.empty()) {
+			int key = random() % range;
+			queue.enqueue(key);
+			reference.insert(key);
+		}
+		else {
+			CHECK(queue.peek() == *reference.begin());
+			CHECK(queue.pop() == *reference.begin());
+			reference.erase(reference.begin());
+		}
+	}
+	catch (ExternalStorageException&) {
+		CHECK(queue.getElementCount() == reference.size());
+		return false;
+	}
+	CHECK(queue.getElementCount() == reference.size());
+	return true;
+}
+
+// Utility function - Pops every element and checks it against reference.
+static void checkExternalDrains(ExternalPriorityQueue<int>& queue, multiset<int>& reference) {
+	while (!reference.empty()) {
+		CHECK(queue.pop() == *reference.begin());
+		reference.erase(reference.begin());
+	}
+	CHECK(queue.isEmpty());
+}
+
+// Random enqueues and pops on an ExternalPriorityQueue with a tiny memory budget,
+// so that it spills and merges runs all the time, against a multiset. Then run
+// files that cannot grow past one spill, or cannot be written at all: the
+// queue must throw and keep every element.
+static void checkExternal(mt19937& random) {
+	char pattern[] = "/tmp/queuecheck-XXXXXX";
+	CHECK(mkdtemp(pattern) != NULL);
+	string directory = pattern;
+	signal(SIGXFSZ, SIG_IGN);
+
+	for (unsigned int round = 0; round < 6; round++) {
+		size_t budget = 256 << round;
+		unsigned int range = 1 + random() % 5000;
+		{
+			ExternalPriorityQueue<int> queue(directory, budget);
+			multiset<int> reference;
+			for (unsigned int step = 0; step < 30000; step++)
+				CHECK(externalStep(random, queue, reference, range));
+			checkExternalDrains(queue, reference);
+		}
+		CHECK(filesIn(directory) == 0);
+	}
+
+	{
+		// 2048 bytes: 256 ints in memory, so a spill writes 1024 bytes
+		ExternalPriorityQueue<int> queue(directory, 2048);
+		multiset<int> reference;
+		for (unsigned int step = 0; step < 3000; step++)
+			CHECK(externalStep(random, queue, reference, 1000));
+
+		limitFileSize(1024);
+		unsigned int failures = 0;
+		for (unsigned int step = 0; step < 20000; step++)
+			failures += !externalStep(random, queue, reference, 1000);
+		CHECK(failures > 0);
+
+		limitFileSize(512);
+		failures = 0;
+		for (unsigned int step = 0; step < 2000; step++)
+			failures += !externalStep(random, queue, reference, 1000);
+		CHECK(failures > 0);
+
+		limitFileSize(RLIM_INFINITY);
+		for (unsigned int step = 0; step < 3000; step++)
+			CHECK(externalStep(random, queue, reference, 1000));
+		checkExternalDrains(queue, reference);
+	}
+	CHECK(filesIn(directory) == 0);
+	CHECK(rmdir(directory.c_str()) == 0);
+}
+
+// Utility function - The best k of offered under Compare: sort and truncate.
+template <class Compare>
+static vector<int> bestOf(vector<int> offered, unsigned int k) {
+	stable_sort(offered.begin(), offered.end(), Compare());
+	if (offered.size() > k)
+		offered.resize(k);
+	return offered;
+}
+
+// Random offers, one at a time and by range, to a TopK with k = 0, small k and
+// k larger than the number of offers, with few distinct keys so that most
+// offers tie with the worst kept one. Each offer must report whether it got
+// in, and extract() must return the sort-and-truncate reference, best first.
+template <class Compare>
+static void checkTopK(mt19937& random) {
+	const unsigned int ks[] = { 0, 1, 2, 7, 100, 5000 };
+	for (unsigned int k : ks) {
+		for (unsigned int round = 0; round < 10; round++) {
+			TopK<int, Compare> selector(k);
+			multiset<int, Compare> kept;
+			vector<int> offered;
+			unsigned int range = 1 + random() % (round % 2 == 0 ? 10 : 100000);
+			unsigned int count = random() % 3000;
+			for (unsigned int i = 0; i < count; i++) {
+				int key = random() % range;
+				offered.push_back(key);
+				// Ties with the worst kept element stay out
+				bool expected = kept.size() < k || (k > 0 && Compare()(key, *kept.rbegin()));
+				bool gotIn = i % 2 == 0 ? selector.offer(key) : selector.offer(int(key));
+				CHECK(gotIn == expected);
+				if (expected) {
+					kept.insert(key);
+					if (kept.size() > k)
+						kept.erase(prev(kept.end()));
+				}
+				CHECK(selector.getElementCount() == kept.size());
+			}
+			CHECK(selector.extract() == bestOf<Compare>(offered, k));
+			CHECK(selector.getElementCount() == 0);
+			CHECK(selector.extract().empty());
+
+			// The same offers by range: whole, and after a partial prefill
+			selector.offer(offered.begin(), offered.end());
+			CHECK(selector.getElementCount() == min<size_t>(k, offered.size()));
+			CHECK(selector.extract() == bestOf<Compare>(offered, k));
+			size_t split = offered.empty() ? 0 : random() % offered.size();
+			for (size_t i = 0; i < split; i++)
+				selector.offer(offered[i]);
+			selector.offer(offered.begin() + split, offered.end());
+			CHECK(selector.extract() == bestOf<Compare>(offered, k));
+		}
+	}
+}
+
+int main() {
+	mt19937 random(2022);
+	checkPriorityQueue(random);
+	checkMoveOnly(random);
+	checkAddressable(random);
+	checkStaleHandles();
+	checkStats();
+	checkHandleExceptionSafety(random);
+	checkMinMaxHeap(random);
+	checkStable<1>(random);
+	checkStable<7>(random);
+	checkStable<1000>(random);
+	checkStable<(1u << 30)>(random);
+	checkTopK<less<int> >(random);
+	checkTopK<greater<int> >(random);
+	checkMultiQueue();
+	checkExternal(random);
+	printf("All priority queue checks passed.\n");
+	return 0;
+}
@@ -0,0 +1,167 @@
+/* 
+ * StablePriorityQueue.cpp
+ *
+ * Description: Stable Priority Queue data collection ADT class. 
+ *              Elements with the same priority come out in the order they were
+ *              enqueued, using 32-bit sequence numbers that may wrap around.
+ *
+ * Class Invariant:  Always a Minimum Binary Heap on (priority, sequence number)
+ * 
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */  
+
+#include "StablePriorityQueue.h"
+#include <algorithm>
+#include <iterator>
+
+    // Default Constructor
+    template <class ElementType, class Compare, uint32_t RenumberInterval>
+    StablePriorityQueue<ElementType, Compare, RenumberInterval>::StablePriorityQueue(const Compare& compare)
+        : Queue(EntryCompare(compare)), nextSequence(0), sinceRenumber(0) {}
+
+    // Range Constructor
+    // Description: Builds the Stable Priority Queue from the elements in [first, last),
+    //              which count as enqueued in that order, with a bottom-up heap construction.
+    // Time Efficiency: O(n)
+    template <class ElementType, class Compare, uint32_t RenumberInterval>
+    template <class InputIterator>
+    StablePriorityQueue<ElementType, Compare, RenumberInterval>::StablePriorityQueue(InputIterator first, InputIterator last, const Compare& compare)
+        : Queue(EntryCompare(compare)), nextSequence(0), sinceRenumber(0) {
+        // Numbered straight from 0: renumbering now would miss the entries not yet in Queue.
+        vector<Entry> entries;
+        for (; first != last; ++first)
+            entries.push_back(Entry(nextSequence++, *first));
+        sinceRenumber = entries.size() < RenumberInterval ? entries.size() : RenumberInterval;
+        Queue.insertRange(make_move_iterator(entries.begin()), make_move_iterator(entries.end()));
+    }
+
+    // Utility method - Returns the next sequence number. Every RenumberInterval
+    //                  of them the live entries are renumbered first, so they
+    //                  never span more than RenumberInterval + n < 2^31 numbers.
+    template <class ElementType, class Compare, uint32_t RenumberInterval>
+    uint32_t StablePriorityQueue<ElementType, Compare, RenumberInterval>::takeSequence(){
+        if(sinceRenumber == RenumberInterval){
+            renumber();
+        }
+        sinceRenumber++;
+        return nextSequence++;
+    }
+
+    // Utility method - Gives the live entries sequence numbers 0, 1, 2, ...
+    //                  in their current order. The new numbers keep the old
+    //                  order, so no comparison changes and they are written
+    //                  over the old ones in place, without moving any entry.
+    //                  The entries are ranked by age with a radix sort.
+    // Time Efficiency: O(n), once every RenumberInterval insertions
+    template <class ElementType, class Compare, uint32_t RenumberInterval>
+    void StablePriorityQueue<ElementType, Compare, RenumberInterval>::renumber(){
+        static const unsigned int DIGIT_BITS = 8;
+        static const uint32_t DIGITS = 1u << DIGIT_BITS;
+        uint32_t count = Queue.getElementCount();
+
+        // Age since being enqueued is exact in unsigned arithmetic, wrapped or not.
+        vector<uint32_t> ages(count);
+        vector<uint32_t> byAge(count);
+        vector<uint32_t> sorted(count);
+        vector<uint32_t> starts(DIGITS + 1);
+        uint32_t next = nextSequence;
+        uint32_t index = 0;
+        Queue.updateEach([&](Entry& entry){ ages[index++] = next - entry.sequence; });
+
+        // Array indices from oldest to youngest: four stable counting passes,
+        // low digit first, on the complemented ages.
+        for(uint32_t i = 0; i < count; i++){
+            byAge[i] = i;
+        }
+        for(unsigned int shift = 0; shift < 32; shift += DIGIT_BITS){
+            fill(starts.begin(), starts.end(), 0);
+            for(uint32_t i = 0; i < count; i++){
+                starts[((~ages[i] >> shift) & (DIGITS - 1)) + 1]++;
+            }
+            for(uint32_t digit = 0; digit < DIGITS; digit++){
+                starts[digit + 1] += starts[digit];
+            }
+            for(uint32_t i = 0; i < count; i++){
+                uint32_t at = byAge[i];
+                sorted[starts[(~ages[at] >> shift) & (DIGITS - 1)]++] = at;
+            }
+            byAge.swap(sorted);
+        }
+
+        // Reuse ages for the new sequence number of each array index.
+        for(uint32_t rank = 0; rank < count; rank++){
+            ages[byAge[rank]] = rank;
+        }
+        index = 0;
+        Queue.updateEach([&](Entry& entry){ entry.sequence = ages[index++]; });
+        nextSequence = count;
+        sinceRenumber = 0;
+    }
+
+    // Description: Returns "true" if this Stable Priority Queue is empty, otherwise "false".
+    // Time Efficiency: O(1)
+    template <class ElementType, class Compare, uint32_t RenumberInterval>
+    bool StablePriorityQueue<ElementType, Compare, RenumberInterval>::isEmpty() const{
+        return Queue.getElementCount() == 0;
+    }
+
+    // Description: Returns the number of elements in this Stable Priority Queue.
+    // Time Efficiency: O(1)
+    template <class ElementType, class Compare, uint32_t RenumberInterval>
+    unsigned int StablePriorityQueue<ElementType, Compare, RenumberInterval>::getElementCount() const{
+        return Queue.getElementCount();
+    }
+
+    // Description: Inserts newElement in this Stable Priority Queue, behind
+    //              every element of the same priority.
+    template <class ElementType, class Compare, uint32_t RenumberInterval>
+    bool StablePriorityQueue<ElementType, Compare, RenumberInterval>::enqueue(const ElementType& newElement){
+        return emplace(newElement);
+    }
+
+    template <class ElementType, class Compare, uint32_t RenumberInterval>
+    bool StablePriorityQueue<ElementType, Compare, RenumberInterval>::enqueue(ElementType&& newElement){
+        return emplace(move(newElement));
+    }
+
+    // Description: Constructs a new element in place from args and inserts it.
+    template <class ElementType, class Compare, uint32_t RenumberInterval>
+    template <class... Args>
+    bool StablePriorityQueue<ElementType, Compare, RenumberInterval>::emplace(Args&&... args){
+        return Queue.emplace(takeSequence(), forward<Args>(args)...);
+    }
+
+    // Description: Removes (but does not return) the element with the next
+    //              "highest" priority value; among equals, the first enqueued.
+    // Exception: Throws EmptyDataCollectionException if this Stable Priority Queue is empty.
+    template <class ElementType, class Compare, uint32_t RenumberInterval>
+    void StablePriorityQueue<ElementType, Compare, RenumberInterval>::dequeue(){
+        if(Queue.getElementCount() == 0){
+            throw EmptyDataCollectionException("dequeue() called with an empty StablePriorityQueue.");
+        }
+        Queue.remove();
+    }
+
+    // Description: Removes and returns the element with the next
+    //              "highest" priority value; among equals, the first enqueued.
+    // Exception: Throws EmptyDataCollectionException if this Stable Priority Queue is empty.
+    template <class ElementType, class Compare, uint32_t RenumberInterval>
+    ElementType StablePriorityQueue<ElementType, Compare, RenumberInterval>::pop(){
+        if(Queue.getElementCount() == 0){
+            throw EmptyDataCollectionException("pop() called with an empty StablePriorityQueue.");
+        }
+        return move(Queue.pop().element);
+    }
+
+    // Description: Returns (but does not remove) the element that dequeue() would remove.
+    // Exception: Throws EmptyDataCollectionException if this Stable Priority Queue is empty.
+    template <class ElementType, class Compare, uint32_t RenumberInterval>
+    const ElementType& StablePriorityQueue<ElementType, Compare, RenumberInterval>::peek() const{
+        if(Queue.getElementCount() == 0){
+            throw EmptyDataCollectionException("peek() called with an empty StablePriorityQueue.");
+        }
+        return Queue.retrieve().element;
+    }
@@ -0,0 +1,130 @@
+/* 
+ * StablePriorityQueue.h
+ *
+ * Description: Stable Priority Queue data collection ADT class. 
+ *              Elements with the same priority come out in the order they were
+ *              enqueued (first in, first out). Every element is stored with a
+ *              32-bit sequence number that breaks ties in the Binary Heap.
+ *              Sequence numbers are compared with serial-number arithmetic,
+ *              so they may wrap around as long as the live ones span less than
+ *              2^31; to keep it that way the live entries are renumbered from
+ *              0 every RenumberInterval insertions (2^30 by default).
+ *              Priority is decided by Compare (std::less by default, so the
+ *              smallest element comes out first; std::greater reverses it).
+ *
+ * Class Invariant:  Always a Minimum Binary Heap on (priority, sequence number)
+ * 
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */  
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "BinaryHeap.h"
+
+template <class ElementType, class Compare = less<ElementType>, uint32_t RenumberInterval = (1u << 30)>
+class StablePriorityQueue {
+
+    static_assert(RenumberInterval > 0 && RenumberInterval <= (1u << 30), "RenumberInterval must be in [1, 2^30].");
+
+    private:
+
+        // Heap entry: the element and the order in which it was enqueued.
+        struct Entry {
+            ElementType element;
+            uint32_t sequence;
+
+            template <class... Args>
+            Entry(uint32_t sequence, Args&&... args) : element(forward<Args>(args)...), sequence(sequence) {}
+        };
+
+        // Orders heap entries by their elements, then by sequence number.
+        // "a - b" read as a signed 32-bit number is negative exactly when a
+        // was handed out before b, even across a wraparound, provided they
+        // are less than 2^31 apart.
+        struct EntryCompare {
+            Compare compare;
+
+            EntryCompare(const Compare& compare = Compare()) : compare(compare) {}
+            bool operator()(const Entry& lhs, const Entry& rhs) const {
+                if(compare(lhs.element, rhs.element)) return true;
+                if(compare(rhs.element, lhs.element)) return false;
+                return static_cast<int32_t>(lhs.sequence - rhs.sequence) < 0;
+            }
+        };
+
+        BinaryHeap<Entry, 2, EntryCompare> Queue;
+        uint32_t nextSequence;
+        uint32_t sinceRenumber;     // Sequence numbers handed out since the last renumbering
+
+        // Utility method - Returns the next sequence number, renumbering first if due.
+        uint32_t takeSequence();
+
+        // Utility method - Gives the live entries sequence numbers 0, 1, 2, ...
+        //                  in their current order, in place.
+        void renumber();
+
+    public:
+        /******* Start of Stable Priority Queue Public Interface *******/
+        // Default Constructor
+        StablePriorityQueue(const Compare& compare = Compare());
+
+        // Range Constructor
+        // Description: Builds the Stable Priority Queue from the elements in [first, last),
+        //              which count as enqueued in that order, with a bottom-up heap construction.
+        // Time Efficiency: O(n)
+        template <class InputIterator>
+        StablePriorityQueue(InputIterator first, InputIterator last, const Compare& compare = Compare());
+
+        // Description: Returns "true" if this Stable Priority Queue is empty, otherwise "false".
+        // Postcondition: This Stable Priority Queue is unchanged by this operation.
+        // Time Efficiency: O(1)
+        bool isEmpty() const;
+
+        // Description: Returns the number of elements in this Stable Priority Queue.
+        // Postcondition: This Stable Priority Queue is unchanged by this operation.
+        // Time Efficiency: O(1)
+        unsigned int getElementCount() const;
+
+        // Description: Inserts newElement in this Stable Priority Queue, behind
+        //              every element of the same priority, and returns "true"
+        //              if successful, otherwise "false".
+        // Precondition: This Stable Priority Queue holds fewer than 2^31 - RenumberInterval elements.
+        // Time Efficiency: O(log2 n) amortized
+        bool enqueue(const ElementType& newElement);
+        bool enqueue(ElementType&& newElement);
+
+        // Description: Constructs a new element in place from args and inserts it.
+        // Time Efficiency: O(log2 n) amortized
+        template <class... Args>
+        bool emplace(Args&&... args);
+
+        // Description: Removes (but does not return) the element with the next
+        //              "highest" priority value; among equals, the first enqueued.
+        // Precondition: This Stable Priority Queue is not empty.
+        // Exception: Throws EmptyDataCollectionException if this Stable Priority Queue is empty.
+        // Time Efficiency: O(log2 n)
+        void dequeue();
+
+        // Description: Removes and returns the element with the next
+        //              "highest" priority value; among equals, the first enqueued.
+        //              The element is moved out, not copied.
+        // Precondition: This Stable Priority Queue is not empty.
+        // Exception: Throws EmptyDataCollectionException if this Stable Priority Queue is empty.
+        // Time Efficiency: O(log2 n)
+        ElementType pop();
+
+        // Description: Returns (but does not remove) the element that dequeue() would remove.
+        // Precondition: This Stable Priority Queue is not empty.
+        // Postcondition: This Stable Priority Queue is unchanged by this operation.
+        // Exception: Throws EmptyDataCollectionException if this Stable Priority Queue is empty.
+        const ElementType& peek() const;
+
+        /*******  End of Stable Priority Queue Public Interface *******/
+};
+
+#include "StablePriorityQueue.cpp"
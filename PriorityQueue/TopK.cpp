@@ -0,0 +1,100 @@
+/* 
+ * TopK.cpp
+ *
+ * Description: Bounded Top-K selector built on BinaryHeap.
+ *              Keeps the k elements that a PriorityQueue with the same Compare
+ *              would dequeue first, out of any number of offered elements.
+ *              The kept elements form a heap with the worst one at the root,
+ *              so a new element only has to beat the root to get in.
+ *
+ * Class Invariant:  Holds at most k elements, which are the best k offered so far.
+ * 
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */  
+
+#include "TopK.h"
+
+    // Constructor
+    // Description: Creates a selector keeping the best k elements.
+    //              Storage for k elements is reserved up front.
+    template <class ElementType, class Compare>
+    TopK<ElementType, Compare>::TopK(unsigned int k, const Compare& compare)
+        : k(k), compare(compare), Heap(WorstFirst(compare)) {
+        Heap.reserve(k);
+    }
+
+    // Description: Returns the number of elements currently kept (at most k).
+    // Time Efficiency: O(1)
+    template <class ElementType, class Compare>
+    unsigned int TopK<ElementType, Compare>::getElementCount() const{
+        return Heap.getElementCount();
+    }
+
+    // Description: Offers newElement to the selector. Returns "true" if it
+    //              is kept, "false" if it is not better than the k kept ones.
+    // Time Efficiency: O(1) when rejected, O(log2 k) when kept
+    template <class ElementType, class Compare>
+    bool TopK<ElementType, Compare>::offer(const ElementType& newElement){
+        if(Heap.getElementCount() < k){
+            return Heap.insert(newElement);
+        }
+        if(k == 0 || !compare(newElement, Heap.retrieve())){
+            return false;
+        }
+        // Replace the worst kept element: a single reHeapDown from the root.
+        Heap.replaceAt(0, newElement);
+        return true;
+    }
+
+    template <class ElementType, class Compare>
+    bool TopK<ElementType, Compare>::offer(ElementType&& newElement){
+        if(Heap.getElementCount() < k){
+            return Heap.insert(move(newElement));
+        }
+        if(k == 0 || !compare(newElement, Heap.retrieve())){
+            return false;
+        }
+        Heap.replaceAt(0, move(newElement));
+        return true;
+    }
+
+    // Description: Offers every element in [first, last). The first k
+    //              elements are heapified in one O(k) pass.
+    // Time Efficiency: O(n log2 k) worst case, O(n) when few elements get in
+    template <class ElementType, class Compare>
+    template <class InputIterator>
+    void TopK<ElementType, Compare>::offer(InputIterator first, InputIterator last){
+        if(k == 0){
+            return;
+        }
+        if(Heap.getElementCount() < k){
+            vector<ElementType> batch;
+            while(first != last && Heap.getElementCount() + batch.size() < k){
+                batch.push_back(*first);
+                ++first;
+            }
+            Heap.insertRange(make_move_iterator(batch.begin()), make_move_iterator(batch.end()));
+        }
+        for(; first != last; ++first){
+            if(compare(*first, Heap.retrieve())){
+                Heap.replaceAt(0, *first);
+            }
+        }
+    }
+
+    // Description: Removes and returns the kept elements, best first.
+    // Postcondition: The selector is empty.
+    // Time Efficiency: O(k log2 k)
+    template <class ElementType, class Compare>
+    vector<ElementType> TopK<ElementType, Compare>::extract(){
+        vector<ElementType> best;
+        best.reserve(Heap.getElementCount());
+        while(Heap.getElementCount() > 0){
+            best.push_back(Heap.pop());
+        }
+        reverse(best.begin(), best.end());
+        return best;
+    }
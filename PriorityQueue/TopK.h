@@ -0,0 +1,71 @@
+/* 
+ * TopK.h
+ *
+ * Description: Bounded Top-K selector built on BinaryHeap.
+ *              Keeps the k elements that a PriorityQueue with the same Compare
+ *              would dequeue first, out of any number of offered elements.
+ *              The kept elements form a heap with the worst one at the root,
+ *              so a new element only has to beat the root to get in.
+ *
+ * Class Invariant:  Holds at most k elements, which are the best k offered so far.
+ * 
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */  
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include "BinaryHeap.h"
+
+template <class ElementType, class Compare = less<ElementType> >
+class TopK {
+
+    private:
+        // Reverses Compare so the worst kept element sits at the root.
+        struct WorstFirst {
+            Compare compare;
+
+            WorstFirst(const Compare& compare = Compare()) : compare(compare) {}
+            bool operator()(const ElementType& lhs, const ElementType& rhs) const { return compare(rhs, lhs); }
+        };
+
+        unsigned int k;
+        Compare compare;
+        BinaryHeap<ElementType, 2, WorstFirst> Heap;
+
+    public:
+        /******* Start of Top-K Public Interface *******/
+        // Constructor
+        // Description: Creates a selector keeping the best k elements.
+        //              Storage for k elements is reserved up front.
+        TopK(unsigned int k, const Compare& compare = Compare());
+
+        // Description: Returns the number of elements currently kept (at most k).
+        // Time Efficiency: O(1)
+        unsigned int getElementCount() const;
+
+        // Description: Offers newElement to the selector. Returns "true" if it
+        //              is kept, "false" if it is not better than the k kept ones.
+        // Time Efficiency: O(1) when rejected, O(log2 k) when kept
+        bool offer(const ElementType& newElement);
+        bool offer(ElementType&& newElement);
+
+        // Description: Offers every element in [first, last). The first k
+        //              elements are heapified in one O(k) pass.
+        // Time Efficiency: O(n log2 k) worst case, O(n) when few elements get in
+        template <class InputIterator>
+        void offer(InputIterator first, InputIterator last);
+
+        // Description: Removes and returns the kept elements, best first.
+        // Postcondition: The selector is empty.
+        // Time Efficiency: O(k log2 k)
+        vector<ElementType> extract();
+
+        /*******  End of Top-K Public Interface *******/
+};
+
+#include "TopK.cpp"
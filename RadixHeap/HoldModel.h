@@ -0,0 +1,56 @@
+/*
+ * HoldModel.h
+ *
+ * Description: Hold-model event traces for the Radix Heap benchmark, and their
+ *              replay on any queue with enqueue / pop. A trace starts with
+ *              "size" events; each hold then pops the earliest event, at time
+ *              t, and schedules the next one at t + an increment drawn up front,
+ *              so every queue replays the same events. Shared by
+ *              RadixBenchmark.cpp and PriorityQueueRow.cpp, which cannot be one
+ *              translation unit: RadixHeap and PriorityQueue each define the
+ *              same exception classes.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+using namespace std;
+
+struct HoldTrace {
+	vector<unsigned long long> initial;      // Times of the events queued before the first hold
+	vector<unsigned long long> increments;   // One per hold
+};
+
+// Defined in PriorityQueueRow.cpp: the trace replayed on PriorityQueue<unsigned long long>.
+double replayOnPriorityQueue(const HoldTrace& trace, unsigned long long& sum);
+
+// Utility function - Milliseconds since "start".
+static inline double millisecondsSince(chrono::steady_clock::time_point start) {
+	return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Utility function - Replays trace on an empty Queue: the initial events, every
+//                    hold, then the events left over. Adds the time of every
+//                    event popped to sum and returns the milliseconds taken.
+template <class Queue>
+double replayHoldModel(const HoldTrace& trace, unsigned long long& sum) {
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	Queue queue;
+	for (unsigned int i = 0; i < trace.initial.size(); i++)
+		queue.enqueue(trace.initial[i]);
+	for (unsigned int i = 0; i < trace.increments.size(); i++) {
+		unsigned long long now = queue.pop();
+		sum += now;
+		queue.enqueue(now + trace.increments[i]);
+	}
+	while (!queue.isEmpty())
+		sum += queue.pop();
+	return millisecondsSince(start);
+}
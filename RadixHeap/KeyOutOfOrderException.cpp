@@ -0,0 +1,21 @@
+/*
+ * KeyOutOfOrderException.cpp
+ *
+ * Class Description: Defines the exception that is thrown when 
+ *                    we are attempting to insert an element whose key
+ *                    is smaller than the last key removed from a
+ *                    monotone data collection ADT class.
+ *
+ * Author: Inspired from our textbook's authors Frank M. Carrano and Tim Henry.
+ *         Copyright (c) 2013 __Pearson Education__. All rights reserved.
+ */
+ 
+
+#include "KeyOutOfOrderException.h"  
+
+KeyOutOfOrderException::KeyOutOfOrderException(const string& message): 
+logic_error("KeyOutOfOrderException: " + message)
+{
+}  // end constructor
+
+// End of implementation file.
\ No newline at end of file
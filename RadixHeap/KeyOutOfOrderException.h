@@ -0,0 +1,25 @@
+/*
+ * KeyOutOfOrderException.h
+ *
+ * Class Description: Defines the exception that is thrown when 
+ *                    we are attempting to insert an element whose key
+ *                    is smaller than the last key removed from a
+ *                    monotone data collection ADT class.
+ *
+ * Author: Inspired from our textbook's authors Frank M. Carrano and Tim Henry.
+ *         Copyright (c) 2013 __Pearson Education__. All rights reserved.
+ */
+ 
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+class KeyOutOfOrderException : public logic_error
+{
+public:
+   KeyOutOfOrderException(const string& message = "");
+   
+}; // end KeyOutOfOrderException 
\ No newline at end of file
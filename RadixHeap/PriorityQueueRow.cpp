@@ -0,0 +1,20 @@
+/*
+ * PriorityQueueRow.cpp
+ *
+ * Description: The PriorityQueue row of the Radix Heap benchmark: a binary
+ *              heap of unsigned long long, which compares keys instead of
+ *              bucketing them. Kept apart from RadixBenchmark.cpp (see
+ *              HoldModel.h).
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#include "../PriorityQueue/PriorityQueue.h"
+#include "HoldModel.h"
+
+double replayOnPriorityQueue(const HoldTrace& trace, unsigned long long& sum) {
+	return replayHoldModel<PriorityQueue<unsigned long long> >(trace, sum);
+}
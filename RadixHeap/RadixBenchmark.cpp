@@ -0,0 +1,98 @@
+/*
+ * RadixBenchmark.cpp
+ *
+ * Description: Benchmark driver for the Radix Heap, against PriorityQueue.
+ *              Usage: ./radixbench [section] [n]
+ *              section is one of the names below, or "all" (the default);
+ *              n is the number of holds (1000000 by default).
+ *              "make bench" builds it with optimizations and runs it.
+ *
+ *              hold    Hold-model event simulation: queues of 1000 and of
+ *                      n/10 pending events, each followed by n holds (pop the
+ *                      earliest event, schedule the next one later), with
+ *                      increments that are uniform on [0, 2000), exponential
+ *                      with mean 1000, or bimodal (nine in ten below 100, the
+ *                      rest up to 100000). RadixHeap<unsigned long long> and
+ *                      PriorityQueue<unsigned long long> replay the same trace.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include "RadixHeap.h"
+#include "HoldModel.h"
+
+using namespace std;
+
+// Keeps the compiler from dropping work whose result is never used.
+static unsigned long long checksum = 0;
+
+enum Distribution { UNIFORM, EXPONENTIAL, BIMODAL };
+static const char* const DISTRIBUTION_NAMES[] = { "uniform", "exponential", "bimodal" };
+
+// Utility function - Returns a trace of "size" events, then "holds" holds whose
+//                    increments follow "distribution".
+static HoldTrace holdTrace(unsigned int size, unsigned int holds, Distribution distribution, unsigned int seed) {
+	mt19937_64 random(seed);
+	uniform_int_distribution<unsigned long long> uniform(0, 1999);
+	exponential_distribution<double> exponential(1.0 / 1000);
+	uniform_int_distribution<unsigned long long> small(0, 99), large(0, 99999);
+	HoldTrace trace;
+	trace.initial.resize(size);
+	trace.increments.resize(holds);
+	for (unsigned int i = 0; i < size + holds; i++) {
+		unsigned long long increment;
+		if (distribution == UNIFORM)
+			increment = uniform(random);
+		else if (distribution == EXPONENTIAL)
+			increment = (unsigned long long)exponential(random);
+		else
+			increment = random() % 10 != 0 ? small(random) : large(random);
+		if (i < size)
+			trace.initial[i] = increment;
+		else
+			trace.increments[i - size] = increment;
+	}
+	return trace;
+}
+
+static void benchHold(unsigned int n) {
+	printf("hold: n = %u holds\n  %-10s %-12s %13s %15s\n", n, "events", "increments", "RadixHeap", "PriorityQueue");
+	unsigned int sizes[] = { 1000, n / 10 > 0 ? n / 10 : 1 };
+	for (unsigned int s = 0; s < 2; s++) {
+		for (unsigned int d = 0; d < 3; d++) {
+			HoldTrace trace = holdTrace(sizes[s], n, (Distribution)d, 10 * s + d);
+			unsigned long long radixSum = 0, queueSum = 0;
+			double radix = replayHoldModel<RadixHeap<unsigned long long> >(trace, radixSum);
+			double queue = replayOnPriorityQueue(trace, queueSum);
+			if (radixSum != queueSum)
+				printf("  (the two queues popped different events)\n");
+			checksum += radixSum;
+			printf("  %-10u %-12s %10.1f ms %12.1f ms\n", sizes[s], DISTRIBUTION_NAMES[d], radix, queue);
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	const char* section = argc > 1 ? argv[1] : "all";
+	unsigned int n = argc > 2 ? strtoul(argv[2], NULL, 10) : 1000000;
+	bool all = strcmp(section, "all") == 0;
+	bool ran = false;
+
+	if (all || strcmp(section, "hold") == 0) {
+		benchHold(n);
+		ran = true;
+	}
+	if (!ran) {
+		printf("Unknown section \"%s\".\n", section);
+		return 1;
+	}
+	printf("(checksum %llu)\n", checksum);
+	return 0;
+}
@@ -0,0 +1,90 @@
+/*
+ * RadixCheck.cpp
+ *
+ * Description: Randomized checks of the Radix Heap. Monotone sequences of
+ *              enqueues, peeks and pops (with many equal keys) run next to a
+ *              multiset, and must agree with it after each step. Built with
+ *              AddressSanitizer and UndefinedBehaviorSanitizer by
+ *              "make check", which also runs it.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include "RadixHeap.h"
+
+using namespace std;
+
+// Stops the run with the failed condition and its line.
+#define CHECK(condition) \
+	do { if (!(condition)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); exit(1); } } while (0)
+
+// peek() must not move the floor for enqueue(): a key between the last one
+// removed and the one peek() found is still accepted and comes out first.
+static void checkPeekKeepsFloor() {
+	RadixHeap<unsigned int> heap;
+	heap.enqueue(10u);
+	CHECK(heap.peek() == 10);
+	heap.enqueue(5u);
+	CHECK(heap.peek() == 5);
+	CHECK(heap.pop() == 5);
+	heap.enqueue(7u);
+	CHECK(heap.pop() == 7);
+	CHECK(heap.pop() == 10);
+
+	heap.enqueue(12u);
+	bool threw = false;
+	try { heap.enqueue(6u); } catch (KeyOutOfOrderException&) { threw = true; }
+	CHECK(threw);
+	CHECK(heap.getElementCount() == 1);
+	CHECK(heap.pop() == 12);
+}
+
+// Random enqueues at or above the last key removed, peeks and pops, against a
+// multiset. Key ranges grow with the round, so that peeks often raise the base
+// far above the floor before a smaller key arrives.
+static void checkMonotone(mt19937_64& random) {
+	for (unsigned int round = 0; round < 200; round++) {
+		RadixHeap<unsigned long long> heap;
+		multiset<unsigned long long> reference;
+		unsigned long long floor = 0;
+		unsigned long long range = 1ull << (round % 64);
+		for (unsigned int step = 0; step < 2000; step++) {
+			unsigned int operation = random() % 4;
+			if (operation <= 1 || reference.empty()) {
+				unsigned long long key = floor + random() % range;
+				if (key < floor) key = floor;       // Wrapped around
+				heap.enqueue(key);
+				reference.insert(key);
+			}
+			else if (operation == 2) {
+				CHECK(heap.peek() == *reference.begin());
+			}
+			else {
+				floor = *reference.begin();
+				CHECK(heap.pop() == floor);
+				reference.erase(reference.begin());
+			}
+			CHECK(heap.getElementCount() == reference.size());
+		}
+		while (!reference.empty()) {
+			CHECK(heap.pop() == *reference.begin());
+			reference.erase(reference.begin());
+		}
+		CHECK(heap.isEmpty());
+	}
+}
+
+int main() {
+	mt19937_64 random(2022);
+	checkPeekKeepsFloor();
+	checkMonotone(random);
+	printf("All radix heap checks passed.\n");
+	return 0;
+}
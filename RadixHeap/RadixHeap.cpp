@@ -0,0 +1,190 @@
+/* 
+ * RadixHeap.cpp
+ *
+ * Description: Monotone Priority Queue data collection ADT class.
+ *              Radix Heap implementation for unsigned integer keys that never
+ *              go below the last key removed (timestamps, distances, ...).
+ *              Keys are bucketed against a base, the smallest key when the
+ *              buckets were last spread: bucket 0 holds the elements whose key
+ *              equals the base; bucket i >= 1 holds those whose key first
+ *              differs from it in bit i-1. Emptying bucket 0 spreads the lowest
+ *              non-empty bucket over the buckets below it, so every element
+ *              moves down at most once per bit: no element-to-element
+ *              comparisons. peek() may raise the base above the last key
+ *              removed; a key enqueued between the two lowers it again.
+ *
+ * Class Invariant:  Every key is >= the base, which is >= the last key removed.
+ * 
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */  
+
+#include "RadixHeap.h"  // Header file
+
+using namespace std;
+
+// Default Constructor
+template <class ElementType, class KeyOf>
+RadixHeap<ElementType, KeyOf>::RadixHeap(const KeyOf& keyOf) : keyOf(keyOf) {
+	bucketBase = 0;
+	lastRemovedKey = 0;
+	elementCount = 0;
+}
+
+// Description: Returns "true" if this Radix Heap is empty, otherwise "false".
+// Time Efficiency: O(1)
+template <class ElementType, class KeyOf>
+bool RadixHeap<ElementType, KeyOf>::isEmpty() const {
+	return elementCount == 0;
+}
+
+// Description: Returns the number of elements in this Radix Heap.
+// Time Efficiency: O(1)
+template <class ElementType, class KeyOf>
+unsigned int RadixHeap<ElementType, KeyOf>::getElementCount() const {
+	return elementCount;
+}
+
+// Description: Inserts newElement in this Radix Heap and
+//              returns "true" if successful, otherwise "false".
+// Precondition: The key of newElement is >= the last key removed.
+// Exception: Throws KeyOutOfOrderException if the key is smaller than the last key removed.
+// Time Efficiency: O(1)
+template <class ElementType, class KeyOf>
+bool RadixHeap<ElementType, KeyOf>::enqueue(const ElementType& newElement) {
+	unsigned long long key = keyOf(newElement);
+	if (key < lastRemovedKey)
+		throw KeyOutOfOrderException("enqueue() called with a key below the last key removed.");
+	if (key < bucketBase)
+		lowerBase(key);
+	buckets[bucketOf(key)].push_back(newElement);
+	elementCount++;
+	return true;
+}
+
+template <class ElementType, class KeyOf>
+bool RadixHeap<ElementType, KeyOf>::enqueue(ElementType&& newElement) {
+	unsigned long long key = keyOf(newElement);
+	if (key < lastRemovedKey)
+		throw KeyOutOfOrderException("enqueue() called with a key below the last key removed.");
+	if (key < bucketBase)
+		lowerBase(key);
+	buckets[bucketOf(key)].push_back(move(newElement));
+	elementCount++;
+	return true;
+}
+
+// Description: Removes (but does not return) an element with the smallest key.
+// Precondition: This Radix Heap is not empty.
+// Exception: Throws EmptyDataCollectionException if this Radix Heap is empty.
+// Time Efficiency: O(log2 C) amortized, where C is the largest key
+template <class ElementType, class KeyOf>
+void RadixHeap<ElementType, KeyOf>::dequeue() {
+	if (elementCount == 0)
+		throw EmptyDataCollectionException("dequeue() called with an empty RadixHeap.");
+	refill();
+	buckets[0].pop_back();
+	lastRemovedKey = bucketBase;
+	elementCount--;
+}
+
+// Description: Removes and returns an element with the smallest key.
+// Precondition: This Radix Heap is not empty.
+// Exception: Throws EmptyDataCollectionException if this Radix Heap is empty.
+// Time Efficiency: O(log2 C) amortized, where C is the largest key
+template <class ElementType, class KeyOf>
+ElementType RadixHeap<ElementType, KeyOf>::pop() {
+	if (elementCount == 0)
+		throw EmptyDataCollectionException("pop() called with an empty RadixHeap.");
+	refill();
+	ElementType top = move(buckets[0].back());
+	buckets[0].pop_back();
+	lastRemovedKey = bucketBase;
+	elementCount--;
+	return top;
+}
+
+// Description: Returns (but does not remove) an element with the smallest key.
+// Precondition: This Radix Heap is not empty.
+// Exception: Throws EmptyDataCollectionException if this Radix Heap is empty.
+// Time Efficiency: O(log2 C) amortized, where C is the largest key
+template <class ElementType, class KeyOf>
+const ElementType& RadixHeap<ElementType, KeyOf>::peek() const {
+	if (elementCount == 0)
+		throw EmptyDataCollectionException("peek() called with an empty RadixHeap.");
+	refill();
+	return buckets[0].back();
+}
+
+// Utility methods - Return the bucket for "key" relative to "base" (or bucketBase):
+//                   0 if they are equal, otherwise 1 + the highest differing bit.
+template <class ElementType, class KeyOf>
+unsigned int RadixHeap<ElementType, KeyOf>::bucketOf(unsigned long long key) const {
+	return bucketOf(key, bucketBase);
+}
+
+template <class ElementType, class KeyOf>
+unsigned int RadixHeap<ElementType, KeyOf>::bucketOf(unsigned long long key, unsigned long long base) {
+	unsigned long long differingBits = key ^ base;
+	if (differingBits == 0) return 0;
+#if defined(__GNUC__)
+	return 64 - __builtin_clzll(differingBits);
+#else
+	unsigned int bucket = 0;
+	for (; differingBits != 0; differingBits >>= 1)
+		bucket++;
+	return bucket;
+#endif
+}
+
+// Utility method - Makes bucket 0 non-empty by raising bucketBase to the smallest
+//                  key and spreading the lowest non-empty bucket. lastRemovedKey
+//                  stays where it is: nothing has been removed yet.
+// Precondition: This Radix Heap is not empty.
+template <class ElementType, class KeyOf>
+void RadixHeap<ElementType, KeyOf>::refill() const {
+	if (!buckets[0].empty()) return;
+
+	unsigned int lowest = 1;
+	while (buckets[lowest].empty())
+		lowest++;
+
+	// Every key in the lowest bucket shares the bits above its own with bucketBase,
+	// so once bucketBase becomes their minimum they all land in lower buckets.
+	vector<ElementType>& spread = buckets[lowest];
+	unsigned long long minKey = keyOf(spread[0]);
+	for (unsigned int i = 1; i < spread.size(); i++) {
+		unsigned long long key = keyOf(spread[i]);
+		if (key < minKey) minKey = key;
+	}
+	bucketBase = minKey;
+	for (unsigned int i = 0; i < spread.size(); i++)
+		buckets[bucketOf(keyOf(spread[i]))].push_back(move(spread[i]));
+	spread.clear();
+}
+
+// Utility method - Lowers bucketBase to newBase, for a key enqueued below it
+//                  after peek() raised it. Let t be the bucket of the old base
+//                  relative to newBase: the two first differ in bit t-1. Keys in
+//                  buckets below t agree with the old base from bit t-1 up, so
+//                  they all belong in bucket t now; keys in bucket t differ from
+//                  it in bit t-1, like newBase, and move below t. Buckets above t
+//                  keep their elements.
+// Precondition: lastRemovedKey <= newBase < bucketBase.
+template <class ElementType, class KeyOf>
+void RadixHeap<ElementType, KeyOf>::lowerBase(unsigned long long newBase) {
+	unsigned int target = bucketOf(bucketBase, newBase);
+	vector<ElementType> respread;
+	respread.swap(buckets[target]);
+	bucketBase = newBase;
+	for (unsigned int i = 0; i < target; i++) {
+		buckets[target].insert(buckets[target].end(), make_move_iterator(buckets[i].begin()), make_move_iterator(buckets[i].end()));
+		buckets[i].clear();
+	}
+	for (unsigned int i = 0; i < respread.size(); i++)
+		buckets[bucketOf(keyOf(respread[i]))].push_back(move(respread[i]));
+}
+
+//  End of implementation file.
@@ -0,0 +1,115 @@
+/* 
+ * RadixHeap.h
+ *
+ * Description: Monotone Priority Queue data collection ADT class.
+ *              Radix Heap implementation for unsigned integer keys that never
+ *              go below the last key removed (timestamps, distances, ...).
+ *              Keys are bucketed against a base, the smallest key when the
+ *              buckets were last spread: bucket 0 holds the elements whose key
+ *              equals the base; bucket i >= 1 holds those whose key first
+ *              differs from it in bit i-1. Emptying bucket 0 spreads the lowest
+ *              non-empty bucket over the buckets below it, so every element
+ *              moves down at most once per bit: no element-to-element
+ *              comparisons. peek() may raise the base above the last key
+ *              removed; a key enqueued between the two lowers it again.
+ *
+ *              KeyOf turns an element into its unsigned key; by default the
+ *              element is its own key.
+ *
+ * Class Invariant:  Every key is >= the base, which is >= the last key removed.
+ * 
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */  
+
+#pragma once
+
+#include <iterator>
+#include <vector>
+#include <utility>
+#include <type_traits>
+#include "EmptyDataCollectionException.h"
+#include "KeyOutOfOrderException.h"
+
+using namespace std;
+
+// Default KeyOf: the element, which must be an unsigned integer, is its own key.
+struct ElementIsKey {
+	template <class ElementType>
+	unsigned long long operator()(const ElementType& element) const {
+		static_assert(is_unsigned<ElementType>::value, "RadixHeap keys must be unsigned integers.");
+		return element;
+	}
+};
+
+template <class ElementType, class KeyOf = ElementIsKey>
+class RadixHeap {
+
+private:
+	static const unsigned int BUCKET_COUNT = 65;     // One per bit of the key, plus bucket 0
+
+	// Buckets are refilled lazily by peek(), which does not change the contents.
+	mutable vector<ElementType> buckets[BUCKET_COUNT];
+	mutable unsigned long long bucketBase;           // Key the buckets are relative to
+	unsigned long long lastRemovedKey;               // Smallest key enqueue() accepts (0 before any removal)
+	unsigned int elementCount;
+	KeyOf keyOf;
+
+	// Utility methods - Return the bucket for "key" relative to "base" (or bucketBase).
+	static unsigned int bucketOf(unsigned long long key, unsigned long long base);
+	unsigned int bucketOf(unsigned long long key) const;
+
+	// Utility method - Makes bucket 0 non-empty by raising bucketBase to the smallest
+	//                  key and spreading the lowest non-empty bucket.
+	// Precondition: This Radix Heap is not empty.
+	void refill() const;
+
+	// Utility method - Lowers bucketBase to newBase, for a key enqueued below it
+	//                  after peek() raised it. Only the buckets up to the one
+	//                  holding the old base relative to the new one are touched.
+	// Precondition: lastRemovedKey <= newBase < bucketBase.
+	void lowerBase(unsigned long long newBase);
+
+public:
+	// Default Constructor
+	RadixHeap(const KeyOf& keyOf = KeyOf());
+
+	// Description: Returns "true" if this Radix Heap is empty, otherwise "false".
+	// Time Efficiency: O(1)
+	bool isEmpty() const;
+
+	// Description: Returns the number of elements in this Radix Heap.
+	// Time Efficiency: O(1)
+	unsigned int getElementCount() const;
+
+	// Description: Inserts newElement in this Radix Heap and
+	//              returns "true" if successful, otherwise "false".
+	// Precondition: The key of newElement is >= the last key removed.
+	// Exception: Throws KeyOutOfOrderException if the key is smaller than the last key removed.
+	// Time Efficiency: O(1)
+	bool enqueue(const ElementType& newElement);
+	bool enqueue(ElementType&& newElement);
+
+	// Description: Removes (but does not return) an element with the smallest key.
+	// Precondition: This Radix Heap is not empty.
+	// Exception: Throws EmptyDataCollectionException if this Radix Heap is empty.
+	// Time Efficiency: O(log2 C) amortized, where C is the largest key
+	void dequeue();
+
+	// Description: Removes and returns an element with the smallest key.
+	// Precondition: This Radix Heap is not empty.
+	// Exception: Throws EmptyDataCollectionException if this Radix Heap is empty.
+	// Time Efficiency: O(log2 C) amortized, where C is the largest key
+	ElementType pop();
+
+	// Description: Returns (but does not remove) an element with the smallest key.
+	// Precondition: This Radix Heap is not empty.
+	// Exception: Throws EmptyDataCollectionException if this Radix Heap is empty.
+	// Time Efficiency: O(log2 C) amortized, where C is the largest key
+	const ElementType& peek() const;
+
+}; // end RadixHeap
+
+#include "RadixHeap.cpp"
@@ -0,0 +1,48 @@
+/*
+ * BinaryHeapRow.cpp
+ *
+ * Description: The BinaryHeap row of the Timer Wheel benchmark: deadlines in a
+ *              binary heap, with lazy cancellation. Every entry carries the
+ *              version of its connection's timeout when it was pushed, and an
+ *              entry whose connection has been re-armed or closed since is
+ *              dropped when it reaches the top. Kept apart from
+ *              WheelBenchmark.cpp (see TimeoutWorkload.h).
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#include "../BinaryHeap/BinaryHeap.h"
+#include "TimeoutWorkload.h"
+
+struct TimeoutEntry {
+	unsigned long long deadline;
+	unsigned int connection;
+	unsigned int version;
+
+	bool operator<(const TimeoutEntry& other) const { return deadline < other.deadline; }
+};
+
+double replayOnBinaryHeap(const vector<TimeoutEvent>& events, unsigned int connections, unsigned long long& fired) {
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	BinaryHeap<TimeoutEntry> heap;
+	vector<unsigned int> versions(connections, 0);
+	for (unsigned int i = 0; i < events.size(); i++) {
+		const TimeoutEvent& event = events[i];
+		while (heap.getElementCount() > 0 && heap.retrieve().deadline <= event.time) {
+			TimeoutEntry top = heap.pop();
+			if (top.version == versions[top.connection]) {
+				versions[top.connection]++;
+				fired++;
+			}
+		}
+		versions[event.connection]++;
+		if (event.timeout != 0) {
+			TimeoutEntry entry = { event.time + event.timeout, event.connection, versions[event.connection] };
+			heap.insert(entry);
+		}
+	}
+	return millisecondsSince(start);
+}
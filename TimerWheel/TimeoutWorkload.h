@@ -0,0 +1,42 @@
+/*
+ * TimeoutWorkload.h
+ *
+ * Description: Synthetic timeout workload for the Timer Wheel benchmark: a
+ *              server's connections, each with an idle timeout that every bit
+ *              of activity pushes back, that a close cancels and that fires if
+ *              the connection stays quiet too long. Shared by
+ *              WheelBenchmark.cpp and BinaryHeapRow.cpp, which cannot be one
+ *              translation unit: TimerWheel and BinaryHeap each define the
+ *              same exception classes.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+using namespace std;
+
+// One step of the workload: at "time", "connection" is active and its timeout
+// is re-armed to fire at time + timeout, or, if timeout is 0, it closes and its
+// timeout is cancelled. Times never decrease.
+struct TimeoutEvent {
+	unsigned long long time;
+	unsigned int connection;
+	unsigned int timeout;
+};
+
+// Defined in BinaryHeapRow.cpp: the workload replayed on a BinaryHeap, which
+// cannot cancel, so every re-arm or close leaves a stale entry that is skipped
+// when it comes out. Counts the timeouts that fired into "fired".
+double replayOnBinaryHeap(const vector<TimeoutEvent>& events, unsigned int connections, unsigned long long& fired);
+
+// Utility function - Milliseconds since "start".
+static inline double millisecondsSince(chrono::steady_clock::time_point start) {
+	return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
@@ -0,0 +1,307 @@
+/*
+ * TimerWheel.cpp
+ *
+ * Description: Timer data collection ADT class: elements are scheduled to fire
+ *              at a deadline, and can be cancelled before they do.
+ *              Hierarchical timing wheel implementation: LEVELS wheels of 64
+ *              slots each, one per 6-bit digit of a 64-bit time.
+ *
+ * Class Invariant:  Every timer's deadline is >= the current time, shares the digits
+ *                   above its level with the current time and is larger in the digit
+ *                   of its level. Timers at lower levels fire before higher ones.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#include "TimerWheel.h"  // Header file
+
+using namespace std;
+
+// Default Constructor
+// Description: Starts the clock at "now".
+template <class ElementType>
+TimerWheel<ElementType>::TimerWheel(unsigned long long now) {
+	for (unsigned int i = 0; i < LEVELS * SLOTS; i++)
+		heads[i] = 0;
+	for (unsigned int level = 0; level < LEVELS; level++)
+		occupied[level] = 0;
+	currentTime = now;
+	elementCount = 0;
+}
+
+// Utility method - Highest set bit of a non-zero bits.
+template <class ElementType>
+unsigned int TimerWheel<ElementType>::highestBit(unsigned long long bits) {
+#if defined(__GNUC__)
+	return 63 - __builtin_clzll(bits);
+#else
+	unsigned int bit = 0;
+	while (bits >>= 1)
+		bit++;
+	return bit;
+#endif
+}
+
+// Utility method - Lowest set bit of a non-zero bits.
+template <class ElementType>
+unsigned int TimerWheel<ElementType>::lowestBit(unsigned long long bits) {
+#if defined(__GNUC__)
+	return __builtin_ctzll(bits);
+#else
+	unsigned int bit = 0;
+	while ((bits & 1) == 0) {
+		bits >>= 1;
+		bit++;
+	}
+	return bit;
+#endif
+}
+
+// Utility method - Returns the bucket for deadline relative to currentTime: the level
+//                  of the highest digit in which they differ, and the deadline's digit
+//                  there. A deadline that has passed goes in the current time's level 0 slot.
+template <class ElementType>
+unsigned int TimerWheel<ElementType>::bucketOf(unsigned long long deadline) const {
+	if (deadline < currentTime)
+		deadline = currentTime;
+	unsigned long long differingBits = deadline ^ currentTime;
+	unsigned int level = differingBits == 0 ? 0 : highestBit(differingBits) / SLOT_BITS;
+	unsigned int slot = (deadline >> (level * SLOT_BITS)) & (SLOTS - 1);
+	return level * SLOTS + slot;
+}
+
+// Utility method - Returns the first time covered by a slot of a level: the current
+//                  time's digits above the level, the slot's digit, then zeros.
+template <class ElementType>
+unsigned long long TimerWheel<ElementType>::startOf(unsigned int level, unsigned int slot) const {
+	unsigned int shift = (level + 1) * SLOT_BITS;
+	unsigned long long above = shift >= 64 ? 0 : (currentTime >> shift) << shift;
+	return above | ((unsigned long long)slot << (level * SLOT_BITS));
+}
+
+// Utility method - Adds timer number "timer" to the front of bucket's list.
+template <class ElementType>
+void TimerWheel<ElementType>::link(unsigned int timer, unsigned int bucket) {
+	Timer& linked = timers[timer - 1];
+	linked.bucket = bucket;
+	linked.previous = 0;
+	linked.next = heads[bucket];
+	if (linked.next != 0)
+		timers[linked.next - 1].previous = timer;
+	heads[bucket] = timer;
+	occupied[bucket / SLOTS] |= 1ULL << (bucket % SLOTS);
+}
+
+// Utility method - Takes timer number "timer" out of its bucket's list.
+template <class ElementType>
+void TimerWheel<ElementType>::unlink(unsigned int timer) {
+	Timer& unlinked = timers[timer - 1];
+	if (unlinked.previous != 0)
+		timers[unlinked.previous - 1].next = unlinked.next;
+	else
+		heads[unlinked.bucket] = unlinked.next;
+	if (unlinked.next != 0)
+		timers[unlinked.next - 1].previous = unlinked.previous;
+	if (heads[unlinked.bucket] == 0)
+		occupied[unlinked.bucket / SLOTS] &= ~(1ULL << (unlinked.bucket % SLOTS));
+}
+
+// Utility method - Returns the lowest level with a non-empty slot.
+template <class ElementType>
+unsigned int TimerWheel<ElementType>::lowestLevel() const {
+	unsigned int level = 0;
+	while (occupied[level] == 0)
+		level++;
+	return level;
+}
+
+// Utility method - Stores element in an unused timer, recycling released ones first,
+//                  marks it scheduled and returns its number.
+template <class ElementType>
+template <class Element>
+unsigned int TimerWheel<ElementType>::acquireTimer(Element&& element) {
+	if (!freeTimers.empty()) {
+		unsigned int timer = freeTimers.back();
+		new (timers[timer - 1].storage) ElementType(forward<Element>(element));
+		timers[timer - 1].scheduled = true;
+		freeTimers.pop_back();
+		return timer;
+	}
+	timers.push_back(Timer());
+	try {
+		new (timers.back().storage) ElementType(forward<Element>(element));
+	}
+	catch (...) {
+		timers.pop_back();
+		throw;
+	}
+	timers.back().scheduled = true;
+	return timers.size();
+}
+
+// Utility method - Destroys the element of a timer and releases the timer, moving it
+//                  on to its next generation so that its old handle stops matching.
+template <class ElementType>
+void TimerWheel<ElementType>::releaseTimer(unsigned int timer) {
+	Timer& released = timers[timer - 1];
+	released.scheduled = false;
+	released.generation++;
+	released.element().~ElementType();
+	freeTimers.push_back(timer);
+}
+
+// Utility method - Returns the handle of a timer's current generation.
+template <class ElementType>
+typename TimerWheel<ElementType>::Handle TimerWheel<ElementType>::handleOf(unsigned int timer) const {
+	return (Handle)timers[timer - 1].generation << 32 | timer;
+}
+
+// Utility method - Returns the number of the scheduled timer handle refers to,
+//                  or 0 if it refers to none.
+template <class ElementType>
+unsigned int TimerWheel<ElementType>::timerOf(Handle handle) const {
+	unsigned int timer = (unsigned int)handle;
+	if (timer == 0 || timer > timers.size() || !timers[timer - 1].scheduled ||
+	    timers[timer - 1].generation != (unsigned int)(handle >> 32))
+		return 0;
+	return timer;
+}
+
+// Description: Returns "true" if no timer is scheduled, otherwise "false".
+// Time Efficiency: O(1)
+template <class ElementType>
+bool TimerWheel<ElementType>::isEmpty() const {
+	return elementCount == 0;
+}
+
+// Description: Returns the number of scheduled timers.
+// Time Efficiency: O(1)
+template <class ElementType>
+unsigned int TimerWheel<ElementType>::getElementCount() const {
+	return elementCount;
+}
+
+// Description: Returns the current time: the last "now" given to advance().
+// Time Efficiency: O(1)
+template <class ElementType>
+unsigned long long TimerWheel<ElementType>::getTime() const {
+	return currentTime;
+}
+
+// Description: Schedules element to fire at deadline and returns its handle.
+// Time Efficiency: O(1) amortized
+template <class ElementType>
+typename TimerWheel<ElementType>::Handle TimerWheel<ElementType>::schedule(unsigned long long deadline, const ElementType& element) {
+	unsigned int timer = acquireTimer(element);
+	timers[timer - 1].deadline = deadline;
+	link(timer, bucketOf(deadline));
+	elementCount++;
+	return handleOf(timer);
+}
+
+template <class ElementType>
+typename TimerWheel<ElementType>::Handle TimerWheel<ElementType>::schedule(unsigned long long deadline, ElementType&& element) {
+	unsigned int timer = acquireTimer(move(element));
+	timers[timer - 1].deadline = deadline;
+	link(timer, bucketOf(deadline));
+	elementCount++;
+	return handleOf(timer);
+}
+
+// Description: Returns "true" if handle refers to a timer that has neither
+//              fired nor been cancelled, otherwise "false", even if the
+//              timer has since been reused for another element.
+// Time Efficiency: O(1)
+template <class ElementType>
+bool TimerWheel<ElementType>::isScheduled(Handle handle) const {
+	return timerOf(handle) != 0;
+}
+
+// Description: Removes the timer referred to by handle without firing it.
+// Exception: Throws ElementDoesNotExistException if handle is not scheduled.
+// Time Efficiency: O(1)
+template <class ElementType>
+void TimerWheel<ElementType>::cancel(Handle handle) {
+	unsigned int timer = timerOf(handle);
+	if (timer == 0)
+		throw ElementDoesNotExistException("Handle does not refer to a timer in the Timer Wheel.");
+	unlink(timer);
+	elementCount--;
+	releaseTimer(timer);
+}
+
+// Description: Moves the clock forward to "now" and fires every timer whose
+//              deadline is <= now, in deadline order, by calling fire(element).
+//              The clock jumps from one non-empty slot to the next: a level 0
+//              slot fires its timers, a higher one moves them to lower levels.
+// Time Efficiency: O(1) amortized per timer, plus O(LEVELS) per non-empty slot reached
+template <class ElementType>
+template <class Function>
+unsigned int TimerWheel<ElementType>::advance(unsigned long long now, Function fire) {
+	unsigned int fired = 0;
+	while (elementCount > 0) {
+		unsigned int level = lowestLevel();
+		unsigned int slot = lowestBit(occupied[level]);
+		unsigned long long start = startOf(level, slot);
+		if (start > now)
+			break;
+		currentTime = start;
+
+		unsigned int bucket = level * SLOTS + slot;
+		if (level == 0) {
+			// Every timer here is due at currentTime. Each one leaves the
+			// wheel before it fires, so fire() may schedule or cancel freely.
+			while (heads[bucket] != 0) {
+				unsigned int timer = heads[bucket];
+				unlink(timer);
+				ElementType element = move(timers[timer - 1].element());
+				elementCount--;
+				releaseTimer(timer);
+				fired++;
+				fire(element);
+			}
+		}
+		else {
+			unsigned int timer = heads[bucket];
+			heads[bucket] = 0;
+			occupied[level] &= ~(1ULL << slot);
+			while (timer != 0) {
+				unsigned int next = timers[timer - 1].next;
+				link(timer, bucketOf(timers[timer - 1].deadline));
+				timer = next;
+			}
+		}
+	}
+	if (now > currentTime)
+		currentTime = now;
+	return fired;
+}
+
+// Description: Returns the deadline of the next timer to fire
+//              (the current time, if that deadline has already passed).
+// Exception: Throws EmptyDataCollectionException if this Timer Wheel is empty.
+// Time Efficiency: O(1) when the next timer is less than 64 ticks away,
+//                  otherwise O(k) for the k timers sharing its slot
+template <class ElementType>
+unsigned long long TimerWheel<ElementType>::peekDeadline() const {
+	if (elementCount == 0)
+		throw EmptyDataCollectionException("peekDeadline() called with an empty TimerWheel.");
+	unsigned int level = lowestLevel();
+	unsigned int slot = lowestBit(occupied[level]);
+	if (level == 0)
+		return startOf(0, slot);
+
+	// Timers sharing a slot above level 0 are not ordered among themselves.
+	unsigned int timer = heads[level * SLOTS + slot];
+	unsigned long long earliest = timers[timer - 1].deadline;
+	for (timer = timers[timer - 1].next; timer != 0; timer = timers[timer - 1].next) {
+		if (timers[timer - 1].deadline < earliest)
+			earliest = timers[timer - 1].deadline;
+	}
+	return earliest;
+}
+
+//  End of implementation file.
\ No newline at end of file
@@ -0,0 +1,191 @@
+/*
+ * TimerWheel.h
+ *
+ * Description: Timer data collection ADT class: elements are scheduled to fire
+ *              at a deadline (in whatever unsigned tick the caller uses), and
+ *              can be cancelled before they do.
+ *              Hierarchical timing wheel implementation: LEVELS wheels of 64
+ *              slots each, one per 6-bit digit of a 64-bit time. A timer sits
+ *              on the level of the highest digit in which its deadline differs
+ *              from the current time, in the slot given by that digit. Every
+ *              slot is a doubly linked list of timers, so scheduling and
+ *              cancelling only link or unlink one. When time reaches a slot
+ *              above level 0, its timers move down to the lower levels
+ *              (at most once per level each); when it reaches a level 0 slot,
+ *              its timers fire.
+ *
+ * Class Invariant:  Every timer's deadline is >= the current time, shares the digits
+ *                   above its level with the current time and is larger in the digit
+ *                   of its level. Timers at lower levels fire before higher ones.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#pragma once
+
+#include <vector>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include "EmptyDataCollectionException.h"
+#include "ElementDoesNotExistException.h"
+
+using namespace std;
+
+template <class ElementType>
+class TimerWheel {
+
+public:
+	// Handle to a scheduled timer. A handle is never 0 and stays valid until its
+	// timer fires or is cancelled. Its low 32 bits number the timer, which is
+	// reused, and its high 32 bits the timer's generation, which changes every
+	// time the timer is released: a stale handle is rejected even once its timer
+	// holds another element.
+	typedef unsigned long long Handle;
+
+private:
+	static const unsigned int SLOT_BITS = 6;
+	static const unsigned int SLOTS = 1 << SLOT_BITS;     // Slots per level
+	static const unsigned int LEVELS = 11;                // 11 * 6 bits cover a 64-bit time
+
+	// The element is constructed in storage while the timer is scheduled, and
+	// destroyed as soon as it fires or is cancelled, so a released handle does
+	// not keep what its element owns alive.
+	struct Timer {
+		unsigned long long deadline;
+		unsigned int next;         // Neighbours in the slot's list, 0 at either end
+		unsigned int previous;
+		unsigned int bucket;       // level * SLOTS + slot
+		unsigned int generation;   // Of the timer's current handle
+		bool scheduled;
+		alignas(ElementType) unsigned char storage[sizeof(ElementType)];
+
+		ElementType& element() { return *reinterpret_cast<ElementType*>(storage); }
+		const ElementType& element() const { return *reinterpret_cast<const ElementType*>(storage); }
+
+		Timer() : deadline(0), next(0), previous(0), bucket(0), generation(0), scheduled(false) {}
+		Timer(const Timer& other)
+			: deadline(other.deadline), next(other.next), previous(other.previous), bucket(other.bucket),
+			  generation(other.generation), scheduled(false) {
+			if (other.scheduled) {
+				new (storage) ElementType(other.element());
+				scheduled = true;
+			}
+		}
+		Timer(Timer&& other) noexcept(is_nothrow_move_constructible<ElementType>::value)
+			: deadline(other.deadline), next(other.next), previous(other.previous), bucket(other.bucket),
+			  generation(other.generation), scheduled(false) {
+			if (other.scheduled) {
+				new (storage) ElementType(move(other.element()));
+				scheduled = true;
+			}
+		}
+		~Timer() { if (scheduled) element().~ElementType(); }
+		Timer& operator=(const Timer&) = delete;
+	};
+
+	vector<Timer> timers;                     // Timer number t is timers[t - 1]
+	vector<unsigned int> freeTimers;
+	unsigned int heads[LEVELS * SLOTS];       // First timer of every slot, 0 if empty
+	unsigned long long occupied[LEVELS];      // Bit s of occupied[l] is set if slot s of level l is not empty
+	unsigned long long currentTime;
+	unsigned int elementCount;
+
+	// Utility methods - Highest and lowest set bit of a non-zero bits.
+	static unsigned int highestBit(unsigned long long bits);
+	static unsigned int lowestBit(unsigned long long bits);
+
+	// Utility method - Returns the bucket for deadline relative to currentTime.
+	unsigned int bucketOf(unsigned long long deadline) const;
+
+	// Utility method - Returns the first time covered by a slot of a level.
+	unsigned long long startOf(unsigned int level, unsigned int slot) const;
+
+	// Utility methods - Add timer number "timer" to the front of bucket's list,
+	//                   and take it out of whichever list it is in.
+	void link(unsigned int timer, unsigned int bucket);
+	void unlink(unsigned int timer);
+
+	// Utility method - Returns the lowest level with a non-empty slot.
+	// Precondition: This Timer Wheel is not empty.
+	unsigned int lowestLevel() const;
+
+	// Utility method - Stores element in an unused timer, recycling released ones
+	//                  first, marks it scheduled and returns its number.
+	template <class Element>
+	unsigned int acquireTimer(Element&& element);
+
+	// Utility method - Destroys the element of a timer and releases the timer,
+	//                  moving it on to its next generation.
+	void releaseTimer(unsigned int timer);
+
+	// Utility methods - Return the handle of a timer's current generation, and
+	//                   the number of the scheduled timer a handle refers to (0 if
+	//                   it refers to none).
+	Handle handleOf(unsigned int timer) const;
+	unsigned int timerOf(Handle handle) const;
+
+public:
+	/******* Start of Timer Wheel Public Interface *******/
+	// Default Constructor
+	// Description: Starts the clock at "now".
+	TimerWheel(unsigned long long now = 0);
+
+	// Description: Returns "true" if no timer is scheduled, otherwise "false".
+	// Postcondition: This Timer Wheel is unchanged by this operation.
+	// Time Efficiency: O(1)
+	bool isEmpty() const;
+
+	// Description: Returns the number of scheduled timers.
+	// Postcondition: This Timer Wheel is unchanged by this operation.
+	// Time Efficiency: O(1)
+	unsigned int getElementCount() const;
+
+	// Description: Returns the current time: the last "now" given to advance().
+	// Postcondition: This Timer Wheel is unchanged by this operation.
+	// Time Efficiency: O(1)
+	unsigned long long getTime() const;
+
+	// Description: Schedules element to fire at deadline and returns its handle.
+	//              A deadline that has already passed fires on the next advance().
+	// Time Efficiency: O(1) amortized
+	Handle schedule(unsigned long long deadline, const ElementType& element);
+	Handle schedule(unsigned long long deadline, ElementType&& element);
+
+	// Description: Returns "true" if handle refers to a timer that has neither
+	//              fired nor been cancelled, otherwise "false", even if the
+	//              timer has since been reused for another element.
+	// Time Efficiency: O(1)
+	bool isScheduled(Handle handle) const;
+
+	// Description: Removes the timer referred to by handle without firing it.
+	// Exception: Throws ElementDoesNotExistException if handle is not scheduled.
+	// Time Efficiency: O(1)
+	void cancel(Handle handle);
+
+	// Description: Moves the clock forward to "now" and fires every timer whose
+	//              deadline is <= now, in deadline order, by calling fire(element).
+	//              fire may schedule and cancel timers; one scheduled at or before
+	//              "now" fires during this same call. Returns the number fired.
+	//              A "now" earlier than getTime() fires nothing.
+	// Time Efficiency: O(1) amortized per timer, plus O(LEVELS) per non-empty slot reached
+	template <class Function>
+	unsigned int advance(unsigned long long now, Function fire);
+
+	// Description: Returns the deadline of the next timer to fire
+	//              (the current time, if that deadline has already passed).
+	// Precondition: This Timer Wheel is not empty.
+	// Postcondition: This Timer Wheel is unchanged by this operation.
+	// Exception: Throws EmptyDataCollectionException if this Timer Wheel is empty.
+	// Time Efficiency: O(1) when the next timer is less than 64 ticks away,
+	//                  otherwise O(k) for the k timers sharing its slot
+	unsigned long long peekDeadline() const;
+
+	/*******  End of Timer Wheel Public Interface *******/
+
+}; // end TimerWheel
+
+#include "TimerWheel.cpp"
@@ -0,0 +1,105 @@
+/*
+ * WheelBenchmark.cpp
+ *
+ * Description: Benchmark driver for the Timer Wheel, against BinaryHeap.
+ *              Usage: ./wheelbench [section] [n]
+ *              section is one of the names below, or "all" (the default);
+ *              n is the number of events (1000000 by default).
+ *              "make bench" builds it with optimizations and runs it.
+ *
+ *              timeout  n events on 1000 and on n/10 connections: the clock
+ *                       moves 0 to 2 ticks, then a random connection is active
+ *                       and re-arms its idle timeout (1000 to 2000 ticks, or
+ *                       50000 to 100000 for one in ten) or, one time in twenty,
+ *                       closes and cancels it. The TimerWheel cancels and
+ *                       reschedules; the BinaryHeap pushes a new deadline and
+ *                       skips stale ones as they come out. Both report the
+ *                       timeouts that fired, which must agree.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "TimerWheel.h"
+#include "TimeoutWorkload.h"
+
+using namespace std;
+
+// Keeps the compiler from dropping work whose result is never used.
+static unsigned long long checksum = 0;
+
+// Utility function - Returns n events on "connections" connections.
+static vector<TimeoutEvent> timeoutEvents(unsigned int n, unsigned int connections, unsigned int seed) {
+	mt19937 random(seed);
+	vector<TimeoutEvent> events(n);
+	unsigned long long now = 0;
+	for (unsigned int i = 0; i < n; i++) {
+		now += random() % 3;
+		events[i].time = now;
+		events[i].connection = random() % connections;
+		if (random() % 20 == 0)
+			events[i].timeout = 0;
+		else if (random() % 10 == 0)
+			events[i].timeout = 50000 + random() % 50000;
+		else
+			events[i].timeout = 1000 + random() % 1000;
+	}
+	return events;
+}
+
+// Utility function - Replays events on a TimerWheel, counting the timeouts that fired.
+static double replayOnTimerWheel(const vector<TimeoutEvent>& events, unsigned int connections, unsigned long long& fired) {
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	TimerWheel<unsigned int> wheel;
+	// A connection's handle goes stale when its timeout fires
+	vector<TimerWheel<unsigned int>::Handle> handles(connections, 0);
+	for (unsigned int i = 0; i < events.size(); i++) {
+		const TimeoutEvent& event = events[i];
+		wheel.advance(event.time, [&](unsigned int) { fired++; });
+		if (wheel.isScheduled(handles[event.connection]))
+			wheel.cancel(handles[event.connection]);
+		if (event.timeout != 0)
+			handles[event.connection] = wheel.schedule(event.time + event.timeout, event.connection);
+	}
+	return millisecondsSince(start);
+}
+
+static void benchTimeout(unsigned int n) {
+	printf("timeout: n = %u events\n  %-12s %13s %13s %10s\n", n, "connections", "TimerWheel", "BinaryHeap", "fired");
+	unsigned int counts[] = { 1000, n / 10 > 0 ? n / 10 : 1 };
+	for (unsigned int c = 0; c < 2; c++) {
+		vector<TimeoutEvent> events = timeoutEvents(n, counts[c], c + 1);
+		unsigned long long wheelFired = 0, heapFired = 0;
+		double wheel = replayOnTimerWheel(events, counts[c], wheelFired);
+		double heap = replayOnBinaryHeap(events, counts[c], heapFired);
+		if (wheelFired != heapFired)
+			printf("  (the two fired %llu and %llu timeouts)\n", wheelFired, heapFired);
+		checksum += wheelFired;
+		printf("  %-12u %10.1f ms %10.1f ms %10llu\n", counts[c], wheel, heap, wheelFired);
+	}
+}
+
+int main(int argc, char** argv) {
+	const char* section = argc > 1 ? argv[1] : "all";
+	unsigned int n = argc > 2 ? strtoul(argv[2], NULL, 10) : 1000000;
+	bool all = strcmp(section, "all") == 0;
+	bool ran = false;
+
+	if (all || strcmp(section, "timeout") == 0) {
+		benchTimeout(n);
+		ran = true;
+	}
+	if (!ran) {
+		printf("Unknown section \"%s\".\n", section);
+		return 1;
+	}
+	printf("(checksum %llu)\n", checksum);
+	return 0;
+}
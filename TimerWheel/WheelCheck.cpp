@@ -0,0 +1,171 @@
+/*
+ * WheelCheck.cpp
+ *
+ * Description: Randomized checks of the Timer Wheel. Random schedules, cancels
+ *              and clock advances (short and long jumps, past deadlines, timers
+ *              scheduled from inside fire()) run next to a map of the timers
+ *              that should be pending, and must agree with it after each step.
+ *              Elements count their live copies, so that a timer that fired or
+ *              was cancelled is seen to no longer hold its element, and the
+              handles of such timers must stay invalid after their timers are
+              reused. Built with
+ *              AddressSanitizer and UndefinedBehaviorSanitizer by
+ *              "make check", which also runs it.
+ *
+ * Author: Amanda Ngo
+ *
+ * Last Modification: March 2022
+ *
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "TimerWheel.h"
+
+using namespace std;
+
+// Stops the run with the failed condition and its line.
+#define CHECK(condition) \
+	do { if (!(condition)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); exit(1); } } while (0)
+
+// Element that counts how many of its objects exist.
+struct Payload {
+	static int alive;
+	unsigned int id;
+	string text;
+
+	Payload(unsigned int id) : id(id), text(24, 'x') { alive++; }
+	Payload(const Payload& other) : id(other.id), text(other.text) { alive++; }
+	Payload(Payload&& other) : id(other.id), text(move(other.text)) { alive++; }
+	~Payload() { alive--; }
+};
+int Payload::alive = 0;
+
+typedef TimerWheel<Payload>::Handle Handle;
+
+// A timer that should be pending.
+struct Pending {
+	Handle handle;
+	unsigned long long deadline;
+};
+
+// Utility function - Returns a random delay, from a few ticks to many wheel levels.
+static unsigned long long randomDelay(mt19937_64& random) {
+	switch (random() % 4) {
+		case 0: return random() % 64;
+		case 1: return random() % 5000;
+		case 2: return random() % 1000000;
+		default: return random() % (1ULL << (random() % 40));
+	}
+}
+
+// Random schedules, cancels and advances against a map of the pending timers.
+static void checkRandom(mt19937_64& random) {
+	for (unsigned int round = 0; round < 20; round++) {
+		unsigned long long start = round % 2 == 0 ? 0 : random() % (1ULL << 50);
+		{
+			TimerWheel<Payload> wheel(start);
+			map<unsigned int, Pending> pending;     // By id
+			vector<Handle> retired;                 // Of timers that fired or were cancelled
+			unsigned int nextId = 0;
+
+			for (unsigned int step = 0; step < 4000; step++) {
+				unsigned int operation = random() % 10;
+				if (operation < 5) {
+					unsigned long long now = wheel.getTime();
+					unsigned long long deadline = random() % 10 == 0 && now > 100 ? now - random() % 100 : now + randomDelay(random);
+					Pending timer = { wheel.schedule(deadline, Payload(nextId)), deadline };
+					CHECK(wheel.isScheduled(timer.handle));
+					pending[nextId++] = timer;
+				}
+				else if (operation < 7 && !pending.empty()) {
+					map<unsigned int, Pending>::iterator victim = pending.lower_bound(random() % nextId);
+					if (victim == pending.end())
+						victim = pending.begin();
+					wheel.cancel(victim->second.handle);
+					CHECK(!wheel.isScheduled(victim->second.handle));
+					try { wheel.cancel(victim->second.handle); CHECK(false); } catch (ElementDoesNotExistException&) {}
+					retired.push_back(victim->second.handle);
+					pending.erase(victim);
+				}
+				else {
+					unsigned long long now = wheel.getTime() + randomDelay(random);
+					unsigned long long lastFired = 0;
+					unsigned int firedHere = 0;
+					unsigned int fired = wheel.advance(now, [&](Payload& element) {
+						map<unsigned int, Pending>::iterator timer = pending.find(element.id);
+						CHECK(timer != pending.end());
+						unsigned long long deadline = timer->second.deadline < wheel.getTime() ? wheel.getTime() : timer->second.deadline;
+						CHECK(deadline <= now && deadline >= lastFired);
+						lastFired = deadline;
+						retired.push_back(timer->second.handle);
+						pending.erase(timer);
+						firedHere++;
+						// Now and then a follow-up, due soon enough to fire in this same call
+						if (random() % 4 == 0) {
+							unsigned long long next = wheel.getTime() + random() % 50;
+							Pending followUp = { wheel.schedule(next, Payload(nextId)), next };
+							pending[nextId++] = followUp;
+						}
+					});
+					CHECK(fired == firedHere);
+					CHECK(wheel.getTime() == now);
+					for (map<unsigned int, Pending>::iterator timer = pending.begin(); timer != pending.end(); ++timer)
+						CHECK(timer->second.deadline > now);
+				}
+
+				CHECK(wheel.getElementCount() == pending.size());
+				CHECK(Payload::alive == (int)pending.size());
+				// Timers are reused, but never under an old handle
+				if (!retired.empty())
+					CHECK(!wheel.isScheduled(retired[random() % retired.size()]));
+				if (pending.empty()) {
+					try { wheel.peekDeadline(); CHECK(false); } catch (EmptyDataCollectionException&) {}
+				}
+				else {
+					unsigned long long earliest = pending.begin()->second.deadline;
+					for (map<unsigned int, Pending>::iterator timer = pending.begin(); timer != pending.end(); ++timer)
+						earliest = timer->second.deadline < earliest ? timer->second.deadline : earliest;
+					CHECK(wheel.peekDeadline() == (earliest < wheel.getTime() ? wheel.getTime() : earliest));
+				}
+			}
+		}
+		CHECK(Payload::alive == 0);
+	}
+}
+
+// A handle kept after its timer was cancelled or fired stays invalid once the
+// timer is reused: isScheduled() says so, and cancel() throws without touching
+// the timer that now holds another element.
+static void checkStaleHandles() {
+	TimerWheel<Payload> wheel;
+	Handle first = wheel.schedule(10, Payload(1));
+	wheel.cancel(first);
+	Handle second = wheel.schedule(20, Payload(2));
+	CHECK((unsigned int)second == (unsigned int)first && second != first);
+	CHECK(!wheel.isScheduled(first) && wheel.isScheduled(second));
+	try { wheel.cancel(first); CHECK(false); } catch (ElementDoesNotExistException&) {}
+	CHECK(wheel.isScheduled(second) && wheel.getElementCount() == 1);
+
+	// Through advance() too
+	unsigned int fired = 0;
+	CHECK(wheel.advance(20, [&](Payload& element) { fired = element.id; }) == 1 && fired == 2);
+	Handle third = wheel.schedule(30, Payload(3));
+	CHECK((unsigned int)third == (unsigned int)second && third != second);
+	CHECK(!wheel.isScheduled(second) && wheel.isScheduled(third));
+	try { wheel.cancel(second); CHECK(false); } catch (ElementDoesNotExistException&) {}
+	CHECK(wheel.advance(30, [&](Payload& element) { fired = element.id; }) == 1 && fired == 3);
+	CHECK(!wheel.isScheduled(0) && !wheel.isScheduled(third + 1));
+}
+
+int main() {
+	mt19937_64 random(2022);
+	checkStaleHandles();
+	checkRandom(random);
+	printf("All timer wheel checks passed.\n");
+	return 0;
+}